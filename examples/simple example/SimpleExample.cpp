@@ -588,6 +588,8 @@ void PrintStartupHeader()
     std::cout << "*                                                   *" << std::endl;
     std::cout << "* Lib version: " << HashMe::GetVersionString() << "                               *" << std::endl;
     std::cout << "*****************************************************" << std::endl << std::endl;
+    
+    std::cout << "CPU features: " << HashMe::CPU::GetFeaturesString() << std::endl << std::endl;
 }
 
 // ***************************************************
@@ -0,0 +1,75 @@
+/*
+    The zlib License
+
+    Copyright (C) 2024 Marc Schöndorf
+ 
+This software is provided 'as-is', without any express or implied warranty. In
+no event will the authors be held liable for any damages arising from the use of
+this software.
+
+Permission is granted to anyone to use this software for any purpose, including
+commercial applications, and to alter it and redistribute it freely, subject to
+the following restrictions:
+
+1.  The origin of this software must not be misrepresented; you must not claim
+    that you wrote the original software. If you use this software in a product,
+    an acknowledgment in the product documentation would be appreciated but is
+    not required.
+
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+
+3.  This notice may not be removed or altered from any source distribution.
+*/
+/*------------------------------------------------------------------*/
+/*                                                                  */
+/*                      (C) 2024 Marc Schöndorf                     */
+/*                            See license                           */
+/*                                                                  */
+/*  CPUFeatures.hpp                                                 */
+/*  Created: 16.10.2026                                             */
+/*------------------------------------------------------------------*/
+
+#ifndef CPUFeatures_hpp
+#define CPUFeatures_hpp
+
+namespace HashMe::CPU
+{
+
+// ***************************************************
+// Instruction set extensions used by the hardware accelerated hashers
+struct Features
+{
+    // x86
+    bool hasSSSE3 = false;
+    bool hasSSE41 = false;
+    bool hasSSE42 = false;
+    bool hasPCLMULQDQ = false;
+    bool hasAVX = false;
+    bool hasAVX2 = false;
+    bool hasBMI1 = false;
+    bool hasBMI2 = false;
+    bool hasSHA = false;
+    bool hasAVX512F = false;
+    bool hasAVX512BW = false;
+    bool hasAVX512VL = false;
+    bool hasVPCLMULQDQ = false;
+    
+    // ARMv8
+    bool hasARMSHA2 = false;
+    bool hasARMSHA512 = false;
+    bool hasARMCRC32 = false;
+    bool hasARMPMULL = false;
+};
+
+// ***************************************************
+// Probes the CPU once at first use (thread safe). Single features can be disabled by setting the
+// environment variable HASHME_DISABLE_CPU_FEATURES to a comma separated list like "sha,avx512f"
+const Features& GetFeatures();
+
+// Space separated list of the detected features for printing
+std::string GetFeaturesString();
+
+}
+
+#endif /* CPUFeatures_hpp */
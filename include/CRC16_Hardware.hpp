@@ -0,0 +1,93 @@
+/*
+    The zlib License
+
+    Copyright (C) 2024 Marc Schöndorf
+ 
+This software is provided 'as-is', without any express or implied warranty. In
+no event will the authors be held liable for any damages arising from the use of
+this software.
+
+Permission is granted to anyone to use this software for any purpose, including
+commercial applications, and to alter it and redistribute it freely, subject to
+the following restrictions:
+
+1.  The origin of this software must not be misrepresented; you must not claim
+    that you wrote the original software. If you use this software in a product,
+    an acknowledgment in the product documentation would be appreciated but is
+    not required.
+
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+
+3.  This notice may not be removed or altered from any source distribution.
+*/
+
+/*------------------------------------------------------------------*/
+/*                                                                  */
+/*                      (C) 2024 Marc Schöndorf                     */
+/*                            See license                           */
+/*                                                                  */
+/*  CRC16_Hardware.hpp                                              */
+/*  Created: 16.10.2026                                             */
+/*------------------------------------------------------------------*/
+
+#ifndef CRC16_Hardware_hpp
+#define CRC16_Hardware_hpp
+
+#if defined(HM_SIMD_ARM) || defined(HM_SIMD_X86)
+
+namespace HashMe
+{
+
+// Dummy types for template
+struct HARDWARE;
+struct CRC16;
+
+// ***************************************************
+// Forward declaration for hasher class
+template <typename HashAlgorithm, typename HardwareSoftwareImplementation>
+class Hasher;
+
+// ***************************************************
+// Hasher class for CRC16 with SIMD support. There is no ARM kernel yet, so it uses the lookup tables on ARM
+template <>
+class Hasher<CRC16, HARDWARE> : public Hasher<CRC16, SOFTWARE>
+{
+private:
+    // Kernels
+#if defined(HM_SIMD_X86)
+    // Folds whole 16 byte chunks with CRCFolding, shorter inputs and the tail are processed with the lookup tables
+    static uint16_t UpdatePCLMUL(const uint16_t crc, const uint8_t* const data, const uint64_t size);
+    static uint16_t UpdateVPCLMUL(const uint16_t crc, const uint8_t* const data, const uint64_t size);
+#endif
+    
+    // Kernel for this CPU, selected at runtime. nullptr if the table driven software implementation is used
+    using UpdateFunction = uint16_t (*)(const uint16_t crc, const uint8_t* const data, const uint64_t size);
+    UpdateFunction m_UpdateFunction;
+    
+    static UpdateFunction SelectUpdateFunction();
+    
+    virtual uint16_t ComputeRange(const uint16_t currentCRC, const uint8_t* const data, const uint64_t size) override;
+    
+public:
+    Hasher();
+    virtual ~Hasher() = default;
+    
+    // Allow copy but no assign
+    Hasher(const Hasher& other);
+    Hasher& operator=(const Hasher& other) = delete;
+    const Hasher& operator=(const Hasher& other) const = delete;
+    
+    // Methods
+    using Hasher<CRC16, SOFTWARE>::Update;
+    
+    virtual void Update(const uint8_t* const data, const uint64_t size) override;
+    virtual void Update(const std::vector<uint8_t>& data) override;
+    virtual void Update(const std::string& str) override;
+};
+
+}
+
+#endif /* HM_SIMD_ARM || HM_SIMD_X86 */
+
+#endif /* CRC16_Hardware_hpp */
@@ -51,16 +51,28 @@ class Hasher;
 // ***************************************************
 // Hasher class for CRC32 with SIMD support
 template <>
-class Hasher<CRC32, HARDWARE> : public HasherBase
+class Hasher<CRC32, HARDWARE> : public Hasher<CRC32, SOFTWARE>
 {
 private:
-    uint32_t    m_CRC32Result = 0;
+    // Kernels
+#if defined(HM_SIMD_ARM)
+    static uint32_t UpdateARM(const uint32_t crc, const uint8_t* const data, const uint64_t size);
+#elif defined(HM_SIMD_X86)
+    // Folds whole 16 byte chunks with CRCFolding, shorter inputs and the tail are processed with the lookup tables
+    static uint32_t UpdatePCLMUL(const uint32_t crc, const uint8_t* const data, const uint64_t size);
+    static uint32_t UpdateVPCLMUL(const uint32_t crc, const uint8_t* const data, const uint64_t size);
+#endif
     
-    // Methods
-    virtual void Initialize() override {}
+    // Kernel for this CPU, selected at runtime. nullptr if the table driven software implementation is used
+    using UpdateFunction = uint32_t (*)(const uint32_t crc, const uint8_t* const data, const uint64_t size);
+    UpdateFunction m_UpdateFunction;
+    
+    static UpdateFunction SelectUpdateFunction();
+    
+    virtual uint32_t ComputeRange(const uint32_t currentCRC, const uint8_t* const data, const uint64_t size) override;
     
 public:
-    Hasher() = default;
+    Hasher();
     virtual ~Hasher() = default;
     
     // Allow copy but no assign
@@ -69,14 +81,11 @@ public:
     const Hasher& operator=(const Hasher& other) const = delete;
     
     // Methods
-    virtual void Reset() override;
+    using Hasher<CRC32, SOFTWARE>::Update;
     
     virtual void Update(const uint8_t* const data, const uint64_t size) override;
     virtual void Update(const std::vector<uint8_t>& data) override;
     virtual void Update(const std::string& str) override;
-    
-    [[nodiscard]] virtual std::vector<uint8_t> End() override;
-    [[nodiscard]] uint32_t End_GetAsInteger32();
 };
 
 }
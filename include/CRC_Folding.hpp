@@ -0,0 +1,69 @@
+/*
+    The zlib License
+
+    Copyright (C) 2024 Marc Schöndorf
+ 
+This software is provided 'as-is', without any express or implied warranty. In
+no event will the authors be held liable for any damages arising from the use of
+this software.
+
+Permission is granted to anyone to use this software for any purpose, including
+commercial applications, and to alter it and redistribute it freely, subject to
+the following restrictions:
+
+1.  The origin of this software must not be misrepresented; you must not claim
+    that you wrote the original software. If you use this software in a product,
+    an acknowledgment in the product documentation would be appreciated but is
+    not required.
+
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+
+3.  This notice may not be removed or altered from any source distribution.
+*/
+
+
+/*------------------------------------------------------------------*/
+/*                                                                  */
+/*                      (C) 2024 Marc Schöndorf                     */
+/*                            See license                           */
+/*                                                                  */
+/*  CRC_Folding.hpp                                                 */
+/*  Created: 16.10.2026                                             */
+/*------------------------------------------------------------------*/
+
+#ifndef CRC_Folding_hpp
+#define CRC_Folding_hpp
+
+#if defined(HM_SIMD_X86)
+
+namespace HashMe
+{
+
+// ***************************************************
+// Carry-less multiplication folding for bit reflected CRCs of up to 64 bit, like in Intel's "Fast CRC Computation for
+// Generic Polynomials Using PCLMULQDQ Instruction". The fold and Barrett constants are derived from the polynomial at
+// compile time. Works on the raw CRC register, without the first remainder and final XOR
+template <typename CRCSize, CRCSize Polynomial>
+class CRCFolding
+{
+public:
+    // Shorter inputs are faster with the lookup tables
+    inline static constexpr uint64_t MIN_SIZE = 64;
+    
+    // Processes whole 16 byte chunks only, size must be a multiple of 16 and at least MIN_SIZE
+    HM_TARGET("sse4.1,pclmul") static CRCSize Update(const CRCSize crc, const uint8_t* const data, const uint64_t size);
+    
+    // Below this size the setup and the final folding of the wide accumulators don't pay off. It also keeps short
+    // updates from waking up the 512 bit units
+    inline static constexpr uint64_t WIDE_MIN_SIZE = 512;
+    
+    // Folds 4x512 bits per iteration with vpclmulqdq, same requirements as Update(). Uses Update() for inputs below WIDE_MIN_SIZE
+    HM_TARGET("avx512f,vpclmulqdq,sse4.1,pclmul") static CRCSize UpdateWide(const CRCSize crc, const uint8_t* const data, const uint64_t size);
+};
+
+}
+
+#endif /* HM_SIMD_X86 */
+
+#endif /* CRC_Folding_hpp */
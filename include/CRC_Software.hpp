@@ -41,6 +41,7 @@ namespace HashMe
 struct SOFTWARE;
 struct CRC16;
 struct CRC32;
+struct CRC32C;
 struct CRC64;
 
 // ***************************************************
@@ -58,9 +59,16 @@ private:
     template <typename WordSize>
     WordSize Reflect(WordSize data, const uint8_t numOfBits) const;
     
+    // Polynomial arithmetic for combining CRCs
+    [[nodiscard]] static constexpr CRCSize MultiplyModP(const CRCSize polynomial, const CRCSize a, CRCSize b);
+    [[nodiscard]] static constexpr std::array<CRCSize, 64> CreatePowerTable(const CRCSize polynomial);
+    
 protected:
-    // The precomputed lookup table
-    std::array<CRCSize, 256> m_LookupTable;
+    // Number of bytes processed per step with one lookup table per byte (slicing-by-16)
+    inline static constexpr uint32_t NUM_OF_SLICES = 16;
+    
+    // The precomputed lookup tables. Table 0 is the byte wise table, table k advances a byte by k more zero bytes
+    std::array<std::array<CRCSize, 256>, NUM_OF_SLICES> m_LookupTables;
     
     // Ctor, Dtor are protected
     CRCBase(const CRCSize polynomial, const CRCSize firstRemainder, const CRCSize finalXOR);
@@ -72,8 +80,22 @@ protected:
     const CRCBase& operator=(const CRCBase& other) const = delete;
     
     // Methods
-    void CreateLookupTable();
+    void CreateLookupTables();
     [[nodiscard]] CRCSize Compute(const CRCSize currentCRC, const uint8_t* const data, const uint64_t size);
+    
+    template <CRCSize Polynomial, CRCSize FirstRemainder, CRCSize FinalXOR>
+    [[nodiscard]] static CRCSize Combine(const CRCSize crcA, const CRCSize crcB, const uint64_t lengthB);
+    
+    // Computes the CRC of a range with the fastest available kernel. The hardware hashers override it with their SIMD kernels
+    [[nodiscard]] virtual CRCSize ComputeRange(const CRCSize currentCRC, const uint8_t* const data, const uint64_t size);
+    
+    // Minimum length of a range for the parallel Update(). Shorter buffers are computed on the calling thread
+    inline static constexpr uint64_t PARALLEL_MIN_RANGE_LENGTH = 1 << 20;
+    
+    // Splits the buffer into ranges, computes their CRCs on the thread pool and combines them in order
+    using CombineFunction = CRCSize (*)(const CRCSize crcA, const CRCSize crcB, const uint64_t lengthB);
+    [[nodiscard]] CRCSize ComputeParallel(ThreadPool& threadPool, const CRCSize currentCRC, const uint8_t* const data, const uint64_t size,
+                                          const CombineFunction combine);
 };
 
 // ***************************************************
@@ -87,10 +109,11 @@ template <>
 class Hasher<CRC16, SOFTWARE> : public HasherBase, public CRCBase<uint16_t>
 {
 private:
-    uint16_t    m_CRC16Result = 0;
-    
     virtual void Initialize() override {}
     
+protected:
+    uint16_t    m_CRC16Result = 0;
+    
 public:
     Hasher();
     virtual ~Hasher() = default;
@@ -107,8 +130,15 @@ public:
     virtual void Update(const std::vector<uint8_t>& data) override;
     virtual void Update(const std::string& str) override;
     
+    // Computes the CRC of large buffers on all threads of the pool, the result is the same as the one of Update()
+    void Update(ThreadPool& threadPool, const uint8_t* const data, const uint64_t size);
+    void Update(ThreadPool& threadPool, const std::vector<uint8_t>& data);
+    
     [[nodiscard]] virtual std::vector<uint8_t> End() override;
     [[nodiscard]] uint16_t End_GetAsInteger16();
+    
+    // Returns the CRC of A followed by B, from the CRCs of A and B and the length of B in bytes (like crc32_combine() of zlib)
+    [[nodiscard]] static uint16_t Combine(const uint16_t crcA, const uint16_t crcB, const uint64_t lengthB);
 };
 
 // ***************************************************
@@ -117,10 +147,49 @@ template <>
 class Hasher<CRC32, SOFTWARE> : public HasherBase, public CRCBase<uint32_t>
 {
 private:
+    virtual void Initialize() override {}
+    
+protected:
     uint32_t    m_CRC32Result = 0;
     
+public:
+    Hasher();
+    virtual ~Hasher() = default;
+    
+    // Allow copy but no assign
+    Hasher(const Hasher& other);
+    Hasher& operator=(const Hasher& other) = delete;
+    const Hasher& operator=(const Hasher& other) const = delete;
+    
+    // Methods
+    virtual void Reset() override;
+    
+    virtual void Update(const uint8_t* const data, const uint64_t size) override;
+    virtual void Update(const std::vector<uint8_t>& data) override;
+    virtual void Update(const std::string& str) override;
+    
+    // Computes the CRC of large buffers on all threads of the pool, the result is the same as the one of Update()
+    void Update(ThreadPool& threadPool, const uint8_t* const data, const uint64_t size);
+    void Update(ThreadPool& threadPool, const std::vector<uint8_t>& data);
+    
+    [[nodiscard]] virtual std::vector<uint8_t> End() override;
+    [[nodiscard]] uint32_t End_GetAsInteger32();
+    
+    // Returns the CRC of A followed by B, from the CRCs of A and B and the length of B in bytes (like crc32_combine() of zlib)
+    [[nodiscard]] static uint32_t Combine(const uint32_t crcA, const uint32_t crcB, const uint64_t lengthB);
+};
+
+// ***************************************************
+// Hasher class for CRC32C (Castagnoli)
+template <>
+class Hasher<CRC32C, SOFTWARE> : public HasherBase, public CRCBase<uint32_t>
+{
+private:
     virtual void Initialize() override {}
     
+protected:
+    uint32_t    m_CRC32CResult = 0;
+    
 public:
     Hasher();
     virtual ~Hasher() = default;
@@ -137,8 +206,15 @@ public:
     virtual void Update(const std::vector<uint8_t>& data) override;
     virtual void Update(const std::string& str) override;
     
+    // Computes the CRC of large buffers on all threads of the pool, the result is the same as the one of Update()
+    void Update(ThreadPool& threadPool, const uint8_t* const data, const uint64_t size);
+    void Update(ThreadPool& threadPool, const std::vector<uint8_t>& data);
+    
     [[nodiscard]] virtual std::vector<uint8_t> End() override;
     [[nodiscard]] uint32_t End_GetAsInteger32();
+    
+    // Returns the CRC of A followed by B, from the CRCs of A and B and the length of B in bytes (like crc32_combine() of zlib)
+    [[nodiscard]] static uint32_t Combine(const uint32_t crcA, const uint32_t crcB, const uint64_t lengthB);
 };
 
 // ***************************************************
@@ -147,10 +223,11 @@ template <>
 class Hasher<CRC64, SOFTWARE> : public HasherBase, public CRCBase<uint64_t>
 {
 private:
-    uint64_t    m_CRC64Result = 0;
-    
     virtual void Initialize() override {}
     
+protected:
+    uint64_t    m_CRC64Result = 0;
+    
 public:
     Hasher();
     virtual ~Hasher() = default;
@@ -167,8 +244,15 @@ public:
     virtual void Update(const std::vector<uint8_t>& data) override;
     virtual void Update(const std::string& str) override;
     
+    // Computes the CRC of large buffers on all threads of the pool, the result is the same as the one of Update()
+    void Update(ThreadPool& threadPool, const uint8_t* const data, const uint64_t size);
+    void Update(ThreadPool& threadPool, const std::vector<uint8_t>& data);
+    
     [[nodiscard]] virtual std::vector<uint8_t> End() override;
     [[nodiscard]] uint64_t End_GetAsInteger64();
+    
+    // Returns the CRC of A followed by B, from the CRCs of A and B and the length of B in bytes (like crc32_combine() of zlib)
+    [[nodiscard]] static uint64_t Combine(const uint64_t crcA, const uint64_t crcB, const uint64_t lengthB);
 };
 
 }
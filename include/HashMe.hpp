@@ -52,6 +52,16 @@ the following restrictions:
 #include <stdexcept>
 #include <array>
 #include <vector>
+#include <span>
+#include <functional>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <deque>
+#include <exception>
+#include <algorithm>
+#include <type_traits>
 
 #ifdef HM_COMPILER_HAS_FMT_CAPABILITY
 #include <format>
@@ -61,19 +71,39 @@ the following restrictions:
 // Lib includes
 #include "HashMeVersion.hpp"
 #include "Utils.hpp"
+#include "CPUFeatures.hpp"
 #include "HasherBase.hpp"
+#include "MerkleDamgard.hpp"
 #include "Base64.hpp"
 #include "SHA256.hpp"
 #include "SHA256_Hardware.hpp"
+#include "SHA256_Batch.hpp"
 #include "SHA224.hpp"
 #include "SHA224_Hardware.hpp"
+#include "SHA224_Batch.hpp"
 #include "SHA512.hpp"
 #include "SHA512_Hardware.hpp"
+#include "SHA512_Batch.hpp"
 #include "SHA384.hpp"
 #include "SHA384_Hardware.hpp"
+#include "SHA384_Batch.hpp"
+#include "SHA512_256.hpp"
+#include "SHA512_256_Hardware.hpp"
+#include "SHA512_256_Batch.hpp"
+#include "SHA512_224.hpp"
+#include "SHA512_224_Hardware.hpp"
+#include "SHA512_224_Batch.hpp"
 #include "MD5.hpp"
+#include "MD5_Batch.hpp"
+#include "ThreadPool.hpp"
 #include "CRC_Software.hpp"
+#include "CRC_Folding.hpp"
+#include "CRC16_Hardware.hpp"
 #include "CRC32_Hardware.hpp"
+#include "CRC32C_Hardware.hpp"
+#include "CRC64_Hardware.hpp"
+#include "MerkleTree.hpp"
+#include "TreeHasher.hpp"
 
 // ***************************************************
 // Platform specific includes for SIMD
@@ -94,7 +124,6 @@ the following restrictions:
 // ***************************************************
 // Lib settings
 #define HM_ENABLE_NAMESPACE_ALIAS // Enable the "HM" namespace alias additionally to "HashMe"
-//#define HM_CLEANUP_TMP_MEMORY_AFTER_HASHING_FOR_SECURITY // Sets temporary variables and hash states to zero after hash calculation for better security
 
 namespace HashMe
 {
@@ -108,6 +137,11 @@ struct SOFTWARE;
 template <typename HashAlgorithm, typename HardwareSoftwareImplementation = SOFTWARE>
 class Hasher;
 
+// ***************************************************
+// Forward declaration for batch hasher class
+template <typename HashAlgorithm>
+class BatchHasher;
+
 // ***************************************************
 // Version info
 int32_t GetVersionMajor();
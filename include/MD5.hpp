@@ -46,32 +46,43 @@ struct MD5;
 template <typename HashAlgorithm, typename HardwareSoftwareImplementation>
 class Hasher;
 
+template <typename HashAlgorithm>
+class BatchHasher;
+
 // ***************************************************
 // Hasher class for MD5
 template <>
-class Hasher<MD5, SOFTWARE> : public HasherBase
+class Hasher<MD5, SOFTWARE> : public HasherBase, protected MerkleDamgard<uint32_t, 4, 64, false>
 {
+    // The batch hasher shares the constants, padding and block function
+    friend class BatchHasher<MD5>;
+    
 private:
     // ***************************************************
     // Constants
-    inline static constexpr uint8_t MD5_BLOCK_LENGTH = 64; // TODO: check if used everywhere
+    inline static constexpr uint32_t MD5_BLOCK_LENGTH = BLOCK_LENGTH;
     inline static constexpr std::array<uint32_t, 4> INITIAL_HASH_VALUES = {
         0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476
     };
-    inline static constexpr std::array<uint8_t, 64> PADDING = {
-      0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-      0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-      0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+    
+    // Rotation amounts, four per round
+    inline static constexpr std::array<uint32_t, 16> S = {
+         7, 12, 17, 22,
+         5,  9, 14, 20,
+         4, 11, 16, 23,
+         6, 10, 15, 21
     };
     
-    // ***************************************************
-    // MD5 context
-    struct Context
-    {
-        uint32_t    state[4] = {0}; // ABCD
-        uint8_t     buffer[MD5_BLOCK_LENGTH] = {0};
-        
-        uint32_t    count[2] = {0};
+    // Additive constants of the 64 steps
+    inline static constexpr std::array<uint32_t, 64> K = {
+        0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+        0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be, 0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+        0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+        0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+        0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c, 0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+        0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+        0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+        0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1, 0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391
     };
     
     // Our context
@@ -79,7 +90,7 @@ private:
     
     // Methods
     virtual void Initialize() override;
-    void Transform(const uint8_t block[MD5_BLOCK_LENGTH]);
+    static void TransformBlocks(uint32_t* const state, const uint8_t* data, uint64_t numOfBlocks);
     
 public:
     Hasher();
@@ -98,6 +109,13 @@ public:
     virtual void Update(const std::string& str) override;
     
     [[nodiscard]] virtual std::vector<uint8_t> End() override;
+    
+    // Longest message which fits into a single padded block
+    inline static constexpr uint32_t MAX_SHORT_MESSAGE_LENGTH = MAX_SINGLE_BLOCK_MESSAGE_LENGTH;
+    
+    // Hashes a message of at most MAX_SHORT_MESSAGE_LENGTH bytes without a context or heap allocations.
+    // Writes the 16 byte digest to the given buffer
+    static void HashShort(const uint8_t* const data, const uint64_t size, uint8_t* const digest);
 };
 
 }
@@ -0,0 +1,122 @@
+/*
+    The zlib License
+
+    Copyright (C) 2024 Marc Schöndorf
+ 
+This software is provided 'as-is', without any express or implied warranty. In
+no event will the authors be held liable for any damages arising from the use of
+this software.
+
+Permission is granted to anyone to use this software for any purpose, including
+commercial applications, and to alter it and redistribute it freely, subject to
+the following restrictions:
+
+1.  The origin of this software must not be misrepresented; you must not claim
+    that you wrote the original software. If you use this software in a product,
+    an acknowledgment in the product documentation would be appreciated but is
+    not required.
+
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+
+3.  This notice may not be removed or altered from any source distribution.
+*/
+
+
+/*------------------------------------------------------------------*/
+/*                                                                  */
+/*                      (C) 2024 Marc Schöndorf                     */
+/*                            See license                           */
+/*                                                                  */
+/*  MD5_Batch.hpp                                                   */
+/*  Created: 16.10.2026                                             */
+/*------------------------------------------------------------------*/
+
+
+#ifndef MD5_Batch_hpp
+#define MD5_Batch_hpp
+
+namespace HashMe
+{
+
+// Dummy types for template
+struct MD5;
+
+// ***************************************************
+// Forward declaration for batch hasher class
+template <typename HashAlgorithm>
+class BatchHasher;
+
+// ***************************************************
+// Hashes many independent messages at once. The multi-buffer kernels process one message per 32 bit lane,
+// finished lanes are refilled with the next message. The digests are identical to Hasher<MD5>
+template <>
+class BatchHasher<MD5>
+{
+private:
+    // ***************************************************
+    // Constants
+    inline static constexpr uint32_t MD5_BLOCK_LENGTH = 64;
+    inline static constexpr uint32_t MAX_NUM_OF_LANES = 16;
+    
+    // Multi-buffer kernel. The state is stored word by word for all lanes: state[word * numOfLanes + lane].
+    // Processes numOfBlocks consecutive blocks for every lane
+    using MultiBufferFunction = void (*)(uint32_t* const state, const uint8_t* const* const data, const uint64_t numOfBlocks);
+    
+    // Single stream kernel
+    using TransformFunction = void (*)(uint32_t* const state, const uint8_t* data, uint64_t numOfBlocks);
+    
+    // Kernels
+#if defined(HM_SIMD_X86)
+    HM_TARGET("avx2") static void TransformAVX2x8(uint32_t* const state, const uint8_t* const* const data, const uint64_t numOfBlocks);
+    HM_TARGET("avx512f") static void TransformAVX512x16(uint32_t* const state, const uint8_t* const* const data, const uint64_t numOfBlocks);
+#endif
+    
+    // A message split into parts in processing order: the whole blocks read directly from the message and the padded final blocks
+    struct MessageBlocks
+    {
+        const uint8_t*  data[2] = {nullptr};
+        uint64_t        numOfBlocks[2] = {0};
+        
+        uint8_t         finalBlocks[2 * MD5_BLOCK_LENGTH];
+        
+        MessageBlocks() = default;
+        MessageBlocks(const MessageBlocks& other) = delete; // Points into itself
+        MessageBlocks& operator=(const MessageBlocks& other) = delete;
+    };
+    
+    struct MultiBufferKernel
+    {
+        MultiBufferFunction     function = nullptr;
+        uint32_t                numOfLanes = 0;
+    };
+    
+    // Kernels for this CPU, selected at runtime. The multi-buffer kernels are sorted by number of lanes
+    std::array<MultiBufferKernel, 2>    m_MultiBufferKernels;
+    uint32_t                            m_NumOfMultiBufferKernels = 0;
+    TransformFunction                   m_TransformFunction;
+    
+    // Methods
+    static void SplitMessage(const std::span<const uint8_t>& message, MessageBlocks& blocks);
+    
+    void HashMessages(const std::vector<std::span<const uint8_t>>& messages, uint8_t* const digests) const;
+    void HashMultiBuffer(const MultiBufferKernel& kernel, const std::vector<std::span<const uint8_t>>& messages, uint8_t* const digests) const;
+    void HashSingleStream(const std::vector<std::span<const uint8_t>>& messages, uint8_t* const digests) const;
+    
+public:
+    BatchHasher();
+    virtual ~BatchHasher() = default;
+    
+    // Methods
+    [[nodiscard]] std::vector<std::vector<uint8_t>> Hash(const std::vector<std::span<const uint8_t>>& messages) const;
+    
+    // Writes the digests back to back into digests, which must hold 16 bytes per message
+    void Hash(const std::vector<std::span<const uint8_t>>& messages, uint8_t* const digests) const;
+    
+    // Maximum number of messages processed in parallel on this CPU
+    [[nodiscard]] uint32_t GetNumOfLanes() const;
+};
+
+}
+
+#endif /* MD5_Batch_hpp */
@@ -0,0 +1,279 @@
+/*
+    The zlib License
+
+    Copyright (C) 2024 Marc Schöndorf
+ 
+This software is provided 'as-is', without any express or implied warranty. In
+no event will the authors be held liable for any damages arising from the use of
+this software.
+
+Permission is granted to anyone to use this software for any purpose, including
+commercial applications, and to alter it and redistribute it freely, subject to
+the following restrictions:
+
+1.  The origin of this software must not be misrepresented; you must not claim
+    that you wrote the original software. If you use this software in a product,
+    an acknowledgment in the product documentation would be appreciated but is
+    not required.
+
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+
+3.  This notice may not be removed or altered from any source distribution.
+*/
+
+
+
+/*------------------------------------------------------------------*/
+/*                                                                  */
+/*                      (C) 2024 Marc Schöndorf                     */
+/*                            See license                           */
+/*                                                                  */
+/*  MerkleDamgard.hpp                                               */
+/*  Created: 16.10.2026                                             */
+/*------------------------------------------------------------------*/
+
+
+#ifndef MerkleDamgard_hpp
+#define MerkleDamgard_hpp
+
+namespace HashMe
+{
+
+// ***************************************************
+// Shared core of the Merkle-Damgard hashers (MD5, SHA224, SHA256, SHA384, SHA512, SHA512/224, SHA512/256).
+// Buffers the input, pads the final block(s) and stores the digest. The block function is a template argument
+// of every method, so Update() and End() call it directly instead of through a virtual function
+template <typename Word, uint32_t NumOfStateWords, uint32_t BlockLength, bool IsBigEndian>
+class MerkleDamgard
+{
+protected:
+    // ***************************************************
+    // Constants
+    inline static constexpr uint32_t BLOCK_LENGTH = BlockLength;
+    
+    // Twice the word size. SHA384 and SHA512 use a 128 bit length field, its upper half is always zero here
+    inline static constexpr uint32_t LENGTH_FIELD_SIZE = 2 * sizeof(Word);
+    
+    // Longest message which fits into one padded block together with the 0x80 marker and the length field
+    inline static constexpr uint32_t MAX_SINGLE_BLOCK_MESSAGE_LENGTH = BlockLength - LENGTH_FIELD_SIZE - 1;
+    
+    static_assert(sizeof(Word) == 4 || sizeof(Word) == 8, "Word must be 32 or 64 bit.");
+    static_assert(BlockLength % 64 == 0, "Block length must be a multiple of 64.");
+    
+    // ***************************************************
+    // Context
+    struct Context
+    {
+        Word        state[NumOfStateWords] = {0};
+        
+        uint64_t    numOfBits = 0;
+        uint32_t    bufferSize = 0;
+        uint8_t     buffer[BlockLength] = {0};
+    };
+    
+    using TransformFunction = void (*)(Word* const state, const uint8_t* data, uint64_t numOfBlocks);
+    
+    // ***************************************************
+    // Methods
+    static void InitializeContext(Context& context, const std::array<Word, NumOfStateWords>& initialHashValues);
+    
+    // Transforms all whole blocks directly from data and buffers the rest
+    template <typename Transform>
+    static void Absorb(Context& context, const Transform& transform, const uint8_t* const data, const uint64_t size);
+    
+    // Pads and transforms the buffered tail, then writes digestLength bytes of the state to digest
+    template <typename Transform>
+    static void Finalize(Context& context, const Transform& transform, uint8_t* const digest, const uint32_t digestLength);
+    
+    // Writes the padded final block(s) of a message into blocks (2 * BLOCK_LENGTH bytes). The tail is the
+    // part of the message after the last whole block. Returns the number of final blocks (1 or 2)
+    static uint32_t PadFinalBlocks(uint8_t* const blocks, const uint8_t* const tail, const uint32_t tailSize, const uint64_t numOfBits);
+    
+    // Writes the first digestLength bytes of a state. Stride is the distance between two state words
+    static void StoreDigest(const Word* const state, const uint32_t stride, uint8_t* const digest, const uint32_t digestLength);
+    
+    // Pads a short message into one block on the stack and hashes it with the given block function
+    template <typename Transform>
+    static void HashSingleBlock(const Transform& transform, const std::array<Word, NumOfStateWords>& initialHashValues,
+                                const uint8_t* const data, const uint64_t size, uint8_t* const digest, const uint32_t digestLength);
+    
+private:
+    // Byte order conversion between the algorithm and the host
+#ifdef HM_LITTLE_ENDIAN
+    using ByteOrder = std::conditional_t<IsBigEndian, Utils::REVERSE_ENDIANNESS, Utils::KEEP_ENDIANNESS>;
+#else
+    using ByteOrder = std::conditional_t<IsBigEndian, Utils::KEEP_ENDIANNESS, Utils::REVERSE_ENDIANNESS>;
+#endif
+    
+    static void StoreWord(const Word word, uint8_t* const out);
+};
+
+// ***************************************************
+// Implementation
+template <typename Word, uint32_t NumOfStateWords, uint32_t BlockLength, bool IsBigEndian>
+inline void MerkleDamgard<Word, NumOfStateWords, BlockLength, IsBigEndian>::InitializeContext(Context& context, const std::array<Word, NumOfStateWords>& initialHashValues)
+{
+    // Set state to initial hash values
+    std::copy(initialHashValues.begin(), initialHashValues.end(), context.state);
+    
+    context.bufferSize = 0;
+    context.numOfBits = 0;
+}
+
+template <typename Word, uint32_t NumOfStateWords, uint32_t BlockLength, bool IsBigEndian>
+template <typename Transform>
+inline void MerkleDamgard<Word, NumOfStateWords, BlockLength, IsBigEndian>::Absorb(Context& context, const Transform& transform, const uint8_t* const data, const uint64_t size)
+{
+    if(!data)
+        throw std::invalid_argument("Data cannot be nullptr.");
+    
+    if(size == 0)
+        throw std::invalid_argument("Data size cannot be zero.");
+    
+    uint64_t dataIndex = 0;
+    uint64_t remainingBytes = size;
+    
+    context.numOfBits += (size << 3);
+    
+    if(context.bufferSize > 0)
+    {
+        // Buffer is already partially filled and untransformed
+        const uint64_t remainingBufferSpace = BlockLength - context.bufferSize;
+        const uint64_t bytesToCopy = std::min(remainingBytes, remainingBufferSpace);
+        
+        // Copy
+        std::copy(data, data + bytesToCopy, context.buffer + context.bufferSize);
+        context.bufferSize += static_cast<uint32_t>(bytesToCopy);
+        dataIndex += bytesToCopy;
+        remainingBytes -= bytesToCopy;
+        
+        // Check if buffer is completely filled now
+        if(context.bufferSize == BlockLength)
+        {
+            // Buffer is full, transform it now
+            transform(context.state, context.buffer, 1);
+            context.bufferSize = 0;
+        }
+    }
+    
+    // Transform all whole blocks directly from the input data without copying them to the buffer
+    const uint64_t numOfBlocks = remainingBytes / BlockLength;
+    if(numOfBlocks > 0)
+    {
+        transform(context.state, data + dataIndex, numOfBlocks);
+        dataIndex += numOfBlocks * BlockLength;
+        remainingBytes -= numOfBlocks * BlockLength;
+    }
+    
+    // Copy partial (last) block to buffer, transform it in Finalize()
+    if(remainingBytes > 0)
+    {
+        std::copy(data + dataIndex, data + dataIndex + remainingBytes, context.buffer + context.bufferSize);
+        context.bufferSize += static_cast<uint32_t>(remainingBytes);
+    }
+}
+
+template <typename Word, uint32_t NumOfStateWords, uint32_t BlockLength, bool IsBigEndian>
+template <typename Transform>
+inline void MerkleDamgard<Word, NumOfStateWords, BlockLength, IsBigEndian>::Finalize(Context& context, const Transform& transform, uint8_t* const digest, const uint32_t digestLength)
+{
+#ifndef NDEBUG
+    if(context.bufferSize >= BlockLength) // Check for bug
+        throw std::runtime_error("Buffer should never be completely filled and untransformed when entering the End() function.");
+#endif
+    
+    uint8_t blocks[2 * BlockLength];
+    const uint32_t numOfBlocks = PadFinalBlocks(blocks, context.buffer, context.bufferSize, context.numOfBits);
+    
+    transform(context.state, blocks, numOfBlocks);
+    
+    StoreDigest(context.state, 1, digest, digestLength);
+    
+    // Cleanup sensitive data for security
+#ifdef HM_CLEANUP_TMP_MEMORY_AFTER_HASHING_FOR_SECURITY
+    std::memset(blocks, 0, sizeof(blocks));
+    std::memset(static_cast<void*>(&context), 0, sizeof(Context));
+#endif
+}
+
+template <typename Word, uint32_t NumOfStateWords, uint32_t BlockLength, bool IsBigEndian>
+inline uint32_t MerkleDamgard<Word, NumOfStateWords, BlockLength, IsBigEndian>::PadFinalBlocks(uint8_t* const blocks, const uint8_t* const tail, const uint32_t tailSize, const uint64_t numOfBits)
+{
+    // Length field has to fit after the 0x80 marker
+    const uint32_t numOfBlocks = (tailSize < BlockLength - LENGTH_FIELD_SIZE) ? 1 : 2;
+    const uint32_t paddedSize = numOfBlocks * BlockLength;
+    
+    if(tailSize > 0)
+        std::copy(tail, tail + tailSize, blocks);
+    
+    std::memset(blocks + tailSize, 0x00, paddedSize - tailSize);
+    blocks[tailSize] = 0x80;
+    
+    // Append full message length in the byte order of the algorithm
+    Utils::U64toU8<ByteOrder>(numOfBits, &blocks[IsBigEndian ? paddedSize - 8 : paddedSize - LENGTH_FIELD_SIZE]);
+    
+    return numOfBlocks;
+}
+
+template <typename Word, uint32_t NumOfStateWords, uint32_t BlockLength, bool IsBigEndian>
+inline void MerkleDamgard<Word, NumOfStateWords, BlockLength, IsBigEndian>::StoreWord(const Word word, uint8_t* const out)
+{
+    if constexpr(sizeof(Word) == 4)
+        Utils::U32toU8<ByteOrder>(word, out);
+    else
+        Utils::U64toU8<ByteOrder>(word, out);
+}
+
+template <typename Word, uint32_t NumOfStateWords, uint32_t BlockLength, bool IsBigEndian>
+inline void MerkleDamgard<Word, NumOfStateWords, BlockLength, IsBigEndian>::StoreDigest(const Word* const state, const uint32_t stride, uint8_t* const digest, const uint32_t digestLength)
+{
+    const uint32_t numOfWholeWords = digestLength / sizeof(Word);
+    for(uint32_t i = 0; i < numOfWholeWords; i++)
+        StoreWord(state[i * stride], &digest[i * sizeof(Word)]);
+    
+    // SHA512/224 ends in the middle of a word
+    const uint32_t remainingBytes = digestLength % sizeof(Word);
+    if(remainingBytes > 0)
+    {
+        uint8_t lastWord[sizeof(Word)];
+        StoreWord(state[numOfWholeWords * stride], lastWord);
+        std::memcpy(&digest[numOfWholeWords * sizeof(Word)], lastWord, remainingBytes);
+    }
+}
+
+template <typename Word, uint32_t NumOfStateWords, uint32_t BlockLength, bool IsBigEndian>
+template <typename Transform>
+inline void MerkleDamgard<Word, NumOfStateWords, BlockLength, IsBigEndian>::HashSingleBlock(const Transform& transform, const std::array<Word, NumOfStateWords>& initialHashValues,
+                                                                                             const uint8_t* const data, const uint64_t size, uint8_t* const digest, const uint32_t digestLength)
+{
+    if(!digest)
+        throw std::invalid_argument("Digest cannot be nullptr.");
+    
+    if(!data && size > 0)
+        throw std::invalid_argument("Data cannot be nullptr.");
+    
+    if(size > MAX_SINGLE_BLOCK_MESSAGE_LENGTH)
+        throw std::invalid_argument("Message is too long for a single block.");
+    
+    // Message, 0x80 marker and length field fit into one block
+    uint8_t block[BlockLength];
+    PadFinalBlocks(block, data, static_cast<uint32_t>(size), size << 3);
+    
+    Word state[NumOfStateWords];
+    std::copy(initialHashValues.begin(), initialHashValues.end(), state);
+    
+    transform(state, block, 1);
+    
+    StoreDigest(state, 1, digest, digestLength);
+    
+    // Cleanup sensitive data for security
+#ifdef HM_CLEANUP_TMP_MEMORY_AFTER_HASHING_FOR_SECURITY
+    std::memset(block, 0, sizeof(block));
+    std::memset(state, 0, sizeof(state));
+#endif
+}
+
+}
+
+#endif /* MerkleDamgard_hpp */
@@ -0,0 +1,140 @@
+/*
+    The zlib License
+
+    Copyright (C) 2024 Marc Schöndorf
+ 
+This software is provided 'as-is', without any express or implied warranty. In
+no event will the authors be held liable for any damages arising from the use of
+this software.
+
+Permission is granted to anyone to use this software for any purpose, including
+commercial applications, and to alter it and redistribute it freely, subject to
+the following restrictions:
+
+1.  The origin of this software must not be misrepresented; you must not claim
+    that you wrote the original software. If you use this software in a product,
+    an acknowledgment in the product documentation would be appreciated but is
+    not required.
+
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+
+3.  This notice may not be removed or altered from any source distribution.
+*/
+
+
+/*------------------------------------------------------------------*/
+/*                                                                  */
+/*                      (C) 2024 Marc Schöndorf                     */
+/*                            See license                           */
+/*                                                                  */
+/*  MerkleTree.hpp                                                  */
+/*  Created: 16.10.2026                                             */
+/*------------------------------------------------------------------*/
+
+#ifndef MerkleTree_hpp
+#define MerkleTree_hpp
+
+namespace HashMe
+{
+
+// ***************************************************
+// Merkle tree over SHA256 as specified in RFC 6962 (Certificate Transparency). Leaves are hashed as
+// SHA256(0x00 || leaf), inner nodes as SHA256(0x01 || left || right). A last node without sibling moves up unchanged
+class MerkleTree
+{
+private:
+    // ***************************************************
+    // Constants
+    inline static constexpr uint32_t DIGEST_LENGTH = 32;
+    inline static constexpr uint64_t NUM_OF_NODES_PER_TASK = 4096;
+    
+    // Hasher state after absorbing the leaf (0x00) and node (0x01) prefix. Created on first use, so a MerkleTree
+    // also works during the static initialization of another translation unit
+    static const BatchHasher<SHA256>::Midstate& LeafMidstate();
+    static const BatchHasher<SHA256>::Midstate& NodeMidstate();
+    
+    // Level 0 holds the leaf hashes, the last level the root. The digests of a level are stored back to back
+    std::vector<std::vector<uint8_t>> m_Levels;
+    
+    // Sorted indices of the leaves changed since the last Build() or Update(), may contain duplicates
+    std::vector<uint64_t> m_DirtyLeaves;
+    bool m_DirtyLeavesSorted = true;
+    
+    BatchHasher<SHA256> m_BatchHasher;
+    
+    // Methods
+    void Build(const std::vector<std::span<const uint8_t>>& leaves, ThreadPool* const threadPool);
+    void Update(ThreadPool* const threadPool);
+    void MarkDirty(const uint64_t leafIndex);
+    void CheckUpToDate() const;
+    
+    // Calls function(first, last) for chunks of NUM_OF_NODES_PER_TASK nodes, in parallel if a thread pool is given
+    static void ForEachTask(ThreadPool* const threadPool, const uint64_t numOfNodes, const std::function<void(uint64_t, uint64_t)>& function);
+    
+    [[nodiscard]] uint64_t GetNumOfNodes(const uint32_t level) const;
+    [[nodiscard]] std::vector<uint8_t> GetNode(const uint32_t level, const uint64_t index) const;
+    
+    // Root of the subtree over the leaves [begin, end), which must be a subtree of the RFC 6962 decomposition
+    [[nodiscard]] std::vector<uint8_t> GetSubtreeRoot(const uint64_t begin, const uint64_t end) const;
+    
+    // SUBPROOF of RFC 6962, section 2.1.2
+    void AppendSubproof(const uint64_t oldNumOfLeaves, const uint64_t begin, const uint64_t end, const bool isOldTree,
+                        std::vector<std::vector<uint8_t>>& proof) const;
+    
+    static void HashChildren(const BatchHasher<SHA256>& batchHasher, const uint8_t* const left, const uint8_t* const right, uint8_t* const digest);
+    
+public:
+    MerkleTree() = default;
+    ~MerkleTree() = default;
+    
+    // Methods
+    // Builds the tree, replacing the previous one. The variant with a thread pool hashes the leaves and every
+    // level in parallel
+    void Build(const std::vector<std::span<const uint8_t>>& leaves);
+    void Build(const std::vector<std::span<const uint8_t>>& leaves, ThreadPool& threadPool);
+    
+    // Replace leaves of the tree. Only the leaf hashes are computed, the inner nodes are recomputed by the next call
+    // to Update(). Until then the root, levels, proofs and the serialized form are not available
+    void SetLeaf(const uint64_t leafIndex, const std::span<const uint8_t> leaf);
+    void SetLeaves(const std::vector<uint64_t>& leafIndices, const std::vector<std::span<const uint8_t>>& leaves);
+    
+    // Recomputes the nodes on the paths from the changed leaves to the root, level by level in batches.
+    // Paths which converge are hashed only once
+    void Update();
+    void Update(ThreadPool& threadPool);
+    
+    [[nodiscard]] bool HasChangedLeaves() const;
+    
+    [[nodiscard]] uint64_t GetNumOfLeaves() const;
+    [[nodiscard]] uint32_t GetNumOfLevels() const;
+    
+    // The root of an empty tree is the hash of the empty string
+    [[nodiscard]] std::vector<uint8_t> GetRoot() const;
+    
+    // The digests of a level back to back. Level 0 are the leaf hashes
+    [[nodiscard]] std::span<const uint8_t> GetLevel(const uint32_t level) const;
+    
+    // Number of leaves (8 bytes, big endian) followed by all levels from the leaves to the root
+    [[nodiscard]] std::vector<uint8_t> Serialize() const;
+    void Deserialize(const std::vector<uint8_t>& data);
+    
+    // Audit path of a leaf, from the leaf to the root (RFC 6962, section 2.1.1)
+    [[nodiscard]] std::vector<std::vector<uint8_t>> GetInclusionProof(const uint64_t leafIndex) const;
+    
+    // Proof that the tree over the first oldNumOfLeaves leaves is a prefix of this tree (RFC 6962, section 2.1.2)
+    [[nodiscard]] std::vector<std::vector<uint8_t>> GetConsistencyProof(const uint64_t oldNumOfLeaves) const;
+    
+    // Verification as described in RFC 9162, sections 2.1.3.2 and 2.1.4.2
+    [[nodiscard]] static std::vector<uint8_t> HashLeaf(const std::span<const uint8_t> leaf);
+    
+    [[nodiscard]] static bool VerifyInclusionProof(const std::vector<uint8_t>& leafHash, const uint64_t leafIndex, const uint64_t numOfLeaves,
+                                                   const std::vector<std::vector<uint8_t>>& proof, const std::vector<uint8_t>& root);
+    
+    [[nodiscard]] static bool VerifyConsistencyProof(const uint64_t oldNumOfLeaves, const uint64_t numOfLeaves, const std::vector<std::vector<uint8_t>>& proof,
+                                                     const std::vector<uint8_t>& oldRoot, const std::vector<uint8_t>& root);
+};
+
+}
+
+#endif /* MerkleTree_hpp */
@@ -79,10 +79,22 @@ the following restrictions:
         #endif
     #elif HASH_PREDEF_HW_SIMD_X86 || HASH_PREDEF_HW_SIMD_X86_AMD
         #define HM_SIMD_X86
-        #pragma message("x86 SIMD is not yet implemented.")
     #endif
 #else
 #pragma message("Hardware acceleration (SIMD) is not available on this platform.")
 #endif
 
+// ***************************************************
+// Per function instruction set selection for the x86 kernels. The library itself is compiled for the
+// baseline ISA, the kernels are only called after the CPU features were checked at runtime
+#if defined(HM_SIMD_X86) && defined(HASH_PREDEF_COMP_GNUC_AVAILABLE) // GCC and clang
+    #define HM_TARGET(isa) __attribute__((target(isa)))
+#else
+    #define HM_TARGET(isa) // MSVC allows all intrinsics without special flags
+#endif
+
+// ***************************************************
+// Security settings. Set here, before the library headers, so the inline code in the headers sees them too
+//#define HM_CLEANUP_TMP_MEMORY_AFTER_HASHING_FOR_SECURITY // Sets temporary variables and hash states to zero after hash calculation for better security
+
 #endif /* PlatformConfig_hpp */
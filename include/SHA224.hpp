@@ -46,11 +46,17 @@ struct SHA224;
 template <typename HashAlgorithm, typename HardwareSoftwareImplementation>
 class Hasher;
 
+template <typename HashAlgorithm>
+class BatchHasher;
+
 // ***************************************************
 // Hasher class for SHA224 using software implementation
 template <>
 class Hasher<SHA224, SOFTWARE> : public Hasher<SHA256, SOFTWARE>
 {
+    // The batch hasher shares the constants
+    friend class BatchHasher<SHA224>;
+    
 private:
     // ***************************************************
     // Constants
@@ -74,6 +80,10 @@ public:
     // Methods
     virtual void Reset() override;
     [[nodiscard]] virtual std::vector<uint8_t> End() override;
+    
+    // Hashes a message of at most MAX_SHORT_MESSAGE_LENGTH bytes without a context or heap allocations.
+    // Writes the 28 byte digest to the given buffer
+    static void HashShort(const uint8_t* const data, const uint64_t size, uint8_t* const digest);
 };
 
 }
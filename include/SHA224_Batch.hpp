@@ -0,0 +1,81 @@
+/*
+    The zlib License
+
+    Copyright (C) 2024 Marc Schöndorf
+ 
+This software is provided 'as-is', without any express or implied warranty. In
+no event will the authors be held liable for any damages arising from the use of
+this software.
+
+Permission is granted to anyone to use this software for any purpose, including
+commercial applications, and to alter it and redistribute it freely, subject to
+the following restrictions:
+
+1.  The origin of this software must not be misrepresented; you must not claim
+    that you wrote the original software. If you use this software in a product,
+    an acknowledgment in the product documentation would be appreciated but is
+    not required.
+
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+
+3.  This notice may not be removed or altered from any source distribution.
+*/
+
+
+/*------------------------------------------------------------------*/
+/*                                                                  */
+/*                      (C) 2024 Marc Schöndorf                     */
+/*                            See license                           */
+/*                                                                  */
+/*  SHA224_Batch.hpp                                                */
+/*  Created: 16.10.2026                                             */
+/*------------------------------------------------------------------*/
+
+#ifndef SHA224_Batch_hpp
+#define SHA224_Batch_hpp
+
+namespace HashMe
+{
+
+// Dummy types for template
+struct SHA224;
+
+// ***************************************************
+// Forward declaration for batch hasher class
+template <typename HashAlgorithm>
+class BatchHasher;
+
+// ***************************************************
+// Batch hasher for SHA224, uses the SHA256 kernels with the SHA224 initial hash values
+template <>
+class BatchHasher<SHA224> : public BatchHasher<SHA256>
+{
+public:
+    BatchHasher() = default;
+    virtual ~BatchHasher() = default;
+    
+    // Methods
+    [[nodiscard]] std::vector<std::vector<uint8_t>> Hash(const std::vector<std::span<const uint8_t>>& messages) const;
+    
+    // Writes the digests back to back into digests, which must hold 28 bytes per message
+    void Hash(const std::vector<std::span<const uint8_t>>& messages, uint8_t* const digests) const;
+    
+    // Continue from the midstate of a Hasher<SHA224>
+    [[nodiscard]] std::vector<std::vector<uint8_t>> Hash(const Midstate& midstate, const std::vector<std::span<const uint8_t>>& suffixes) const;
+    void Hash(const Midstate& midstate, const std::vector<std::span<const uint8_t>>& suffixes, uint8_t* const digests) const;
+    void Hash(const Midstate& midstate, const std::span<const uint8_t> suffix, uint8_t* const digest) const;
+    
+    // The prefix midstate, Merkle node and SHA256d functions produce SHA256 states and digests
+    static Midstate PrefixMidstate(const uint8_t prefix) = delete;
+    void HashPair32(const uint8_t* const left, const uint8_t* const right, uint8_t* const digest) const = delete;
+    void HashPairs32(const uint8_t* const nodes, const uint64_t numOfPairs, uint8_t* const digests) const = delete;
+    std::vector<uint8_t> HashPairs32(const std::vector<uint8_t>& nodes) const = delete;
+    void HashDouble(const std::span<const uint8_t> message, uint8_t* const digest) const = delete;
+    void HashDouble(const std::vector<std::span<const uint8_t>>& messages, uint8_t* const digests) const = delete;
+    std::vector<std::vector<uint8_t>> HashDouble(const std::vector<std::span<const uint8_t>>& messages) const = delete;
+};
+
+}
+
+#endif /* SHA224_Batch_hpp */
@@ -46,26 +46,30 @@ struct SHA256;
 template <typename HashAlgorithm, typename HardwareSoftwareImplementation>
 class Hasher;
 
+template <typename HashAlgorithm>
+class BatchHasher;
+
 // ***************************************************
 // Hasher class for SHA256 using software implementation
 template <>
-class Hasher<SHA256, SOFTWARE> : public HasherBase
+class Hasher<SHA256, SOFTWARE> : public HasherBase, protected MerkleDamgard<uint32_t, 8, 64, true>
 {
+    // The batch hasher shares the constants, padding and block functions
+    friend class BatchHasher<SHA256>;
+    
 private:
+    // Methods
+    virtual void Initialize() override;
+    
+protected:
     // ***************************************************
     // Constants
     inline static constexpr std::array<uint32_t, 8> INITIAL_HASH_VALUES = {
         0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
         0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
     };
-
-    // Methods
-    virtual void Initialize() override;
     
-protected:
-    // ***************************************************
-    // Constants
-    inline static constexpr uint32_t SHA256_BLOCK_LENGTH = 64;
+    inline static constexpr uint32_t SHA256_BLOCK_LENGTH = BLOCK_LENGTH;
     inline static constexpr std::array<uint32_t, 64> K = {
         0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
         0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
@@ -79,24 +83,16 @@ protected:
     
     static_assert(SHA256_BLOCK_LENGTH == 64, "Block length is fixed at 64.");
     
-    // ***************************************************
-    // SHA256 context
-    struct Context
-    {
-        uint32_t    state[8] = {0};
-        
-        uint64_t    numOfBits = 0;
-        uint32_t    bufferSize = 0;
-        uint8_t     buffer[SHA256_BLOCK_LENGTH] = {0};
-    };
-    
     // Our context
     std::unique_ptr<Context> m_Context;
     
-    // Methods
-    virtual void Transform(const uint8_t* const data);
+    // Portable block function, also used by the hardware hasher if the CPU lacks the required extensions
+    static void TransformSoftware(uint32_t* const state, const uint8_t* data, uint64_t numOfBlocks);
     
 public:
+    // Snapshot of the context after absorbing a prefix. Plain data, can be copied and stored without heap allocations
+    using Midstate = Context;
+    
     Hasher();
     virtual ~Hasher() = default;
     
@@ -113,6 +109,17 @@ public:
     virtual void Update(const std::string& str) override;
     
     [[nodiscard]] virtual std::vector<uint8_t> End() override;
+    
+    // Messages sharing a long prefix can continue from the midstate instead of hashing the prefix again
+    [[nodiscard]] Midstate GetMidstate() const;
+    void SetMidstate(const Midstate& midstate);
+    
+    // Longest message which fits into a single padded block
+    inline static constexpr uint32_t MAX_SHORT_MESSAGE_LENGTH = MAX_SINGLE_BLOCK_MESSAGE_LENGTH;
+    
+    // Hashes a message of at most MAX_SHORT_MESSAGE_LENGTH bytes without a context or heap allocations.
+    // Writes the 32 byte digest to the given buffer
+    static void HashShort(const uint8_t* const data, const uint64_t size, uint8_t* const digest);
 };
 
 }
@@ -0,0 +1,193 @@
+/*
+    The zlib License
+
+    Copyright (C) 2024 Marc Schöndorf
+ 
+This software is provided 'as-is', without any express or implied warranty. In
+no event will the authors be held liable for any damages arising from the use of
+this software.
+
+Permission is granted to anyone to use this software for any purpose, including
+commercial applications, and to alter it and redistribute it freely, subject to
+the following restrictions:
+
+1.  The origin of this software must not be misrepresented; you must not claim
+    that you wrote the original software. If you use this software in a product,
+    an acknowledgment in the product documentation would be appreciated but is
+    not required.
+
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+
+3.  This notice may not be removed or altered from any source distribution.
+*/
+
+
+/*------------------------------------------------------------------*/
+/*                                                                  */
+/*                      (C) 2024 Marc Schöndorf                     */
+/*                            See license                           */
+/*                                                                  */
+/*  SHA256_Batch.hpp                                                */
+/*  Created: 16.10.2026                                             */
+/*------------------------------------------------------------------*/
+
+#ifndef SHA256_Batch_hpp
+#define SHA256_Batch_hpp
+
+namespace HashMe
+{
+
+// Dummy types for template
+struct SHA256;
+
+// ***************************************************
+// Forward declaration for batch hasher class
+template <typename HashAlgorithm>
+class BatchHasher;
+
+// ***************************************************
+// Hashes many independent messages at once. Multi-buffer SIMD kernels process one message per lane,
+// finished lanes are refilled with the next message. The digests are identical to Hasher<SHA256>
+template <>
+class BatchHasher<SHA256>
+{
+public:
+    // Hasher state after absorbing a prefix
+    using Midstate = Hasher<SHA256, SOFTWARE>::Midstate;
+    
+    // Midstate after absorbing a single prefix byte, e.g. the domain separation prefix of a hash tree
+    [[nodiscard]] static Midstate PrefixMidstate(const uint8_t prefix);
+    
+protected:
+    // ***************************************************
+    // Constants
+    inline static constexpr uint32_t SHA256_BLOCK_LENGTH = 64;
+    inline static constexpr uint32_t MAX_NUM_OF_LANES = 16;
+    
+    // Multi-buffer kernel. The state is stored word by word for all lanes: state[word * numOfLanes + lane].
+    // Processes numOfBlocks consecutive blocks for every lane
+    using MultiBufferFunction = void (*)(uint32_t* const state, const uint8_t* const* const data, const uint64_t numOfBlocks);
+    
+    // Single stream kernel
+    using TransformFunction = void (*)(uint32_t* const state, const uint8_t* data, uint64_t numOfBlocks);
+    
+    // Transforms the constant padding block of a 64 byte message with a precomputed message schedule.
+    // Same state layout as the matching multi-buffer or single stream kernel
+    using PaddingBlockFunction = void (*)(uint32_t* const state);
+    
+    // Second pass of SHA256d. Replaces the state (the digest of the first pass) with the state after hashing that
+    // 32 byte digest. Same state layout as the matching multi-buffer or single stream kernel
+    using DigestBlockFunction = void (*)(uint32_t* const state);
+    
+    // Methods
+    static Midstate InitialMidstate(const std::array<uint32_t, 8>& initialHashValues);
+    
+    void HashMessages(const std::vector<std::span<const uint8_t>>& messages, uint8_t* const digests, const Midstate& midstate, const uint32_t digestLength) const;
+    void HashMessage(const std::span<const uint8_t>& message, uint8_t* const digest, const Midstate& midstate, const uint32_t digestLength) const;
+    
+private:
+    // W+K of the padding block of a 64 byte message (0x80 marker, zeros and a length of 512 bits)
+    static const std::array<uint32_t, 64> PAIR_PADDING_BLOCK_WK;
+    
+    // W+K of rounds 8 to 15 of a 32 byte message, these words are the constant padding
+    static const std::array<uint32_t, 8> DIGEST_BLOCK_WK;
+    
+    // Kernels
+#if defined(HM_SIMD_X86)
+    HM_TARGET("avx2") static void TransformAVX2x8(uint32_t* const state, const uint8_t* const* const data, const uint64_t numOfBlocks);
+    HM_TARGET("avx512f,avx512bw") static void TransformAVX512x16(uint32_t* const state, const uint8_t* const* const data, const uint64_t numOfBlocks);
+    HM_TARGET("sse4.1,sha") static void TransformSHAx2(uint32_t* const state, const uint8_t* const* const data, const uint64_t numOfBlocks);
+    
+    HM_TARGET("avx2") static void TransformPaddingBlockAVX2x8(uint32_t* const state);
+    HM_TARGET("avx512f") static void TransformPaddingBlockAVX512x16(uint32_t* const state);
+    HM_TARGET("sse4.1,sha") static void TransformPaddingBlockSHAx2(uint32_t* const state);
+    HM_TARGET("sse4.1,sha") static void TransformPaddingBlockSHA(uint32_t* const state);
+    
+    HM_TARGET("avx2") static void TransformDigestBlockAVX2x8(uint32_t* const state);
+    HM_TARGET("avx512f") static void TransformDigestBlockAVX512x16(uint32_t* const state);
+    HM_TARGET("sse4.1,sha") static void TransformDigestBlockSHAx2(uint32_t* const state);
+    HM_TARGET("sse4.1,sha") static void TransformDigestBlockSHA(uint32_t* const state);
+#endif
+    static void TransformPaddingBlockSoftware(uint32_t* const state);
+    static void TransformDigestBlockSoftware(uint32_t* const state);
+    
+    // A message continued from a midstate, split into parts in processing order: the block completed from the
+    // buffered tail of the midstate, the whole blocks read directly from the message and the padded final blocks
+    struct MessageBlocks
+    {
+        const uint8_t*  data[3] = {nullptr};
+        uint64_t        numOfBlocks[3] = {0};
+        
+        uint8_t         headBlock[SHA256_BLOCK_LENGTH];
+        uint8_t         finalBlocks[2 * SHA256_BLOCK_LENGTH];
+        
+        MessageBlocks() = default;
+        MessageBlocks(const MessageBlocks& other) = delete; // Points into itself
+        MessageBlocks& operator=(const MessageBlocks& other) = delete;
+    };
+    
+    struct MultiBufferKernel
+    {
+        MultiBufferFunction     function = nullptr;
+        PaddingBlockFunction    paddingBlockFunction = nullptr;
+        DigestBlockFunction     digestBlockFunction = nullptr;
+        uint32_t                numOfLanes = 0;
+    };
+    
+    // Kernels for this CPU, selected at runtime. The multi-buffer kernels are sorted by number of lanes
+    std::array<MultiBufferKernel, 3>    m_MultiBufferKernels;
+    uint32_t                            m_NumOfMultiBufferKernels = 0;
+    TransformFunction                   m_TransformFunction;
+    PaddingBlockFunction                m_PaddingBlockFunction;
+    DigestBlockFunction                 m_DigestBlockFunction;
+    
+    // Methods
+    static void SplitMessage(const std::span<const uint8_t>& message, const Midstate& midstate, MessageBlocks& blocks);
+    
+    void HashMultiBuffer(const MultiBufferKernel& kernel, const std::vector<std::span<const uint8_t>>& messages, uint8_t* const digests, const Midstate& midstate, const uint32_t digestLength) const;
+    void HashSingleStream(const std::vector<std::span<const uint8_t>>& messages, uint8_t* const digests, const Midstate& midstate, const uint32_t digestLength) const;
+    void HashPairsMultiBuffer(const MultiBufferKernel& kernel, const uint8_t* const nodes, const uint64_t numOfPairs, uint8_t* const digests) const;
+    void RehashDigestsMultiBuffer(const MultiBufferKernel& kernel, uint8_t* const digests, const uint64_t numOfDigests) const;
+    void RehashDigests(uint8_t* const digests, const uint64_t numOfDigests) const;
+    
+public:
+    BatchHasher();
+    virtual ~BatchHasher() = default;
+    
+    // Methods
+    [[nodiscard]] std::vector<std::vector<uint8_t>> Hash(const std::vector<std::span<const uint8_t>>& messages) const;
+    
+    // Writes the digests back to back into digests, which must hold 32 bytes per message
+    void Hash(const std::vector<std::span<const uint8_t>>& messages, uint8_t* const digests) const;
+    
+    // Hashes messages which all start with the prefix absorbed into the midstate (see Hasher<SHA256>::GetMidstate()).
+    // Only the suffixes are passed, every lane starts from the midstate
+    [[nodiscard]] std::vector<std::vector<uint8_t>> Hash(const Midstate& midstate, const std::vector<std::span<const uint8_t>>& suffixes) const;
+    void Hash(const Midstate& midstate, const std::vector<std::span<const uint8_t>>& suffixes, uint8_t* const digests) const;
+    
+    // Single suffix without heap allocations
+    void Hash(const Midstate& midstate, const std::span<const uint8_t> suffix, uint8_t* const digest) const;
+    
+    // Merkle tree inner node: SHA256 of the 64 byte concatenation of two 32 byte child digests.
+    // Skips buffering and padding, the schedule of the constant padding block is precomputed
+    void HashPair32(const uint8_t* const left, const uint8_t* const right, uint8_t* const digest) const;
+    
+    // Hashes a whole tree level. nodes holds 2 * numOfPairs child digests back to back, digests receives numOfPairs parent digests.
+    // digests may point to nodes to reduce a level in place
+    void HashPairs32(const uint8_t* const nodes, const uint64_t numOfPairs, uint8_t* const digests) const;
+    [[nodiscard]] std::vector<uint8_t> HashPairs32(const std::vector<uint8_t>& nodes) const;
+    
+    // Double SHA256 (SHA256d), the SHA256 of the SHA256 digest. The second pass runs directly on the state words of
+    // the first one, the padding half of its block is constant
+    void HashDouble(const std::span<const uint8_t> message, uint8_t* const digest) const;
+    void HashDouble(const std::vector<std::span<const uint8_t>>& messages, uint8_t* const digests) const;
+    [[nodiscard]] std::vector<std::vector<uint8_t>> HashDouble(const std::vector<std::span<const uint8_t>>& messages) const;
+    
+    // Maximum number of messages processed in parallel on this CPU
+    [[nodiscard]] uint32_t GetNumOfLanes() const;
+};
+
+}
+
+#endif /* SHA256_Batch_hpp */
@@ -46,11 +46,17 @@ struct SHA384;
 template <typename HashAlgorithm, typename HardwareSoftwareImplementation>
 class Hasher;
 
+template <typename HashAlgorithm>
+class BatchHasher;
+
 // ***************************************************
 // Hasher class for SHA384 using software implementation
 template <>
 class Hasher<SHA384, SOFTWARE> : public Hasher<SHA512, SOFTWARE>
 {
+    // The batch hasher shares the constants
+    friend class BatchHasher<SHA384>;
+    
 private:
     // ***************************************************
     // Constants
@@ -76,6 +82,10 @@ public:
     // Methods
     virtual void Reset() override;
     [[nodiscard]] virtual std::vector<uint8_t> End() override;
+    
+    // Hashes a message of at most MAX_SHORT_MESSAGE_LENGTH bytes without a context or heap allocations.
+    // Writes the 48 byte digest to the given buffer
+    static void HashShort(const uint8_t* const data, const uint64_t size, uint8_t* const digest);
 };
 
 }
@@ -78,6 +78,10 @@ public:
     // Methods
     virtual void Reset() override;
     [[nodiscard]] virtual std::vector<uint8_t> End() override;
+    
+    // Hashes a message of at most MAX_SHORT_MESSAGE_LENGTH bytes without a context or heap allocations.
+    // Writes the 48 byte digest to the given buffer
+    static void HashShort(const uint8_t* const data, const uint64_t size, uint8_t* const digest);
 };
 
 }
@@ -46,12 +46,22 @@ struct SHA512;
 template <typename HashAlgorithm, typename HardwareSoftwareImplementation>
 class Hasher;
 
+template <typename HashAlgorithm>
+class BatchHasher;
+
 // ***************************************************
 // Hasher class for SHA512 using software implementation
 template <>
-class Hasher<SHA512, SOFTWARE> : public HasherBase
+class Hasher<SHA512, SOFTWARE> : public HasherBase, protected MerkleDamgard<uint64_t, 8, 128, true>
 {
+    // The batch hasher shares the constants, padding and block functions
+    friend class BatchHasher<SHA512>;
+    
 private:
+    // Methods
+    virtual void Initialize() override;
+    
+protected:
     // ***************************************************
     // Constants
     inline static constexpr std::array<uint64_t, 8> INITIAL_HASH_VALUES = {
@@ -60,14 +70,8 @@ private:
         0x510e527fade682d1, 0x9b05688c2b3e6c1f,
         0x1f83d9abfb41bd6b, 0x5be0cd19137e2179
     };
-
-    // Methods
-    virtual void Initialize() override;
     
-protected:
-    // ***************************************************
-    // Constants
-    inline static constexpr uint32_t SHA512_BLOCK_LENGTH = 128;
+    inline static constexpr uint32_t SHA512_BLOCK_LENGTH = BLOCK_LENGTH;
     inline static constexpr std::array<uint64_t, 80> K = {
         0x428a2f98d728ae22, 0x7137449123ef65cd, 0xb5c0fbcfec4d3b2f, 0xe9b5dba58189dbbc,
         0x3956c25bf348b538, 0x59f111f1b605d019, 0x923f82a4af194f9b, 0xab1c5ed5da6d8118,
@@ -93,22 +97,11 @@ protected:
     
     static_assert(SHA512_BLOCK_LENGTH == 128, "Block length is fixed at 128.");
     
-    // ***************************************************
-    // SHA512 context
-    struct Context
-    {
-        uint64_t    state[8] = {0};
-        
-        uint64_t    numOfBits = 0;
-        uint32_t    bufferSize = 0;
-        uint8_t     buffer[SHA512_BLOCK_LENGTH] = {0};
-    };
-    
     // Our context
     std::unique_ptr<Context> m_Context;
     
-    // Methods
-    virtual void Transform(const uint8_t* const data);
+    // Portable block function, also used by the hardware hasher if the CPU lacks the required extensions
+    static void TransformSoftware(uint64_t* const state, const uint8_t* data, uint64_t numOfBlocks);
     
 public:
     Hasher();
@@ -127,6 +120,13 @@ public:
     virtual void Update(const std::string& str) override;
     
     [[nodiscard]] virtual std::vector<uint8_t> End() override;
+    
+    // Longest message which fits into a single padded block
+    inline static constexpr uint32_t MAX_SHORT_MESSAGE_LENGTH = MAX_SINGLE_BLOCK_MESSAGE_LENGTH;
+    
+    // Hashes a message of at most MAX_SHORT_MESSAGE_LENGTH bytes without a context or heap allocations.
+    // Writes the 64 byte digest to the given buffer
+    static void HashShort(const uint8_t* const data, const uint64_t size, uint8_t* const digest);
 };
 
 }
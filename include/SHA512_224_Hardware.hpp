@@ -0,0 +1,91 @@
+/*
+    The zlib License
+
+    Copyright (C) 2024 Marc Schöndorf
+ 
+This software is provided 'as-is', without any express or implied warranty. In
+no event will the authors be held liable for any damages arising from the use of
+this software.
+
+Permission is granted to anyone to use this software for any purpose, including
+commercial applications, and to alter it and redistribute it freely, subject to
+the following restrictions:
+
+1.  The origin of this software must not be misrepresented; you must not claim
+    that you wrote the original software. If you use this software in a product,
+    an acknowledgment in the product documentation would be appreciated but is
+    not required.
+
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+
+3.  This notice may not be removed or altered from any source distribution.
+*/
+
+/*------------------------------------------------------------------*/
+/*                                                                  */
+/*                      (C) 2024 Marc Schöndorf                     */
+/*                            See license                           */
+/*                                                                  */
+/*  SHA512_224_Hardware.hpp                                         */
+/*  Created: 16.10.2026                                             */
+/*------------------------------------------------------------------*/
+
+#ifndef SHA512_224_Hardware_hpp
+#define SHA512_224_Hardware_hpp
+
+#if defined(HM_SIMD_ARM) || defined(HM_SIMD_X86)
+
+namespace HashMe
+{
+
+// Dummy types for template
+struct HARDWARE;
+struct SHA512_224;
+
+// ***************************************************
+// Forward declaration for hasher class
+template <typename HashAlgorithm, typename HardwareSoftwareImplementation>
+class Hasher;
+
+// ***************************************************
+// Hasher class for SHA512/224 with SIMD support
+template <>
+class Hasher<SHA512_224, HARDWARE> : public Hasher<SHA512, HARDWARE>
+{
+private:
+    // ***************************************************
+    // Constants
+    inline static constexpr std::array<uint64_t, 8> INITIAL_HASH_VALUES = {
+        0x8c3d37c819544da2, 0x73e1996689dcd4d6,
+        0x1dfab7ae32ff9c82, 0x679dd514582f9fcf,
+        0x0f6d2b697bd44da8, 0x77e36f7304c48942,
+        0x3f9d85a86a1d36c8, 0x1112e6ad91d692a1
+    };
+    
+    // Methods
+    virtual void Initialize() override;
+    
+public:
+    Hasher();
+    virtual ~Hasher() = default;
+    
+    // Allow copy but no assign
+    Hasher(const Hasher& other);
+    Hasher& operator=(const Hasher& other) = delete;
+    const Hasher& operator=(const Hasher& other) const = delete;
+    
+    // Methods
+    virtual void Reset() override;
+    [[nodiscard]] virtual std::vector<uint8_t> End() override;
+    
+    // Hashes a message of at most MAX_SHORT_MESSAGE_LENGTH bytes without a context or heap allocations.
+    // Writes the 28 byte digest to the given buffer
+    static void HashShort(const uint8_t* const data, const uint64_t size, uint8_t* const digest);
+};
+
+}
+
+#endif /* HM_SIMD_ARM || HM_SIMD_X86 */
+
+#endif /* SHA512_224_Hardware_hpp */
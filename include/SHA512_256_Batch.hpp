@@ -0,0 +1,68 @@
+/*
+    The zlib License
+
+    Copyright (C) 2024 Marc Schöndorf
+ 
+This software is provided 'as-is', without any express or implied warranty. In
+no event will the authors be held liable for any damages arising from the use of
+this software.
+
+Permission is granted to anyone to use this software for any purpose, including
+commercial applications, and to alter it and redistribute it freely, subject to
+the following restrictions:
+
+1.  The origin of this software must not be misrepresented; you must not claim
+    that you wrote the original software. If you use this software in a product,
+    an acknowledgment in the product documentation would be appreciated but is
+    not required.
+
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+
+3.  This notice may not be removed or altered from any source distribution.
+*/
+
+
+/*------------------------------------------------------------------*/
+/*                                                                  */
+/*                      (C) 2024 Marc Schöndorf                     */
+/*                            See license                           */
+/*                                                                  */
+/*  SHA512_256_Batch.hpp                                            */
+/*  Created: 16.10.2026                                             */
+/*------------------------------------------------------------------*/
+
+
+#ifndef SHA512_256_Batch_hpp
+#define SHA512_256_Batch_hpp
+
+namespace HashMe
+{
+
+// Dummy types for template
+struct SHA512_256;
+
+// ***************************************************
+// Forward declaration for batch hasher class
+template <typename HashAlgorithm>
+class BatchHasher;
+
+// ***************************************************
+// Batch hasher for SHA512/256, uses the SHA512 kernels with the SHA512/256 initial hash values and truncates the digest
+template <>
+class BatchHasher<SHA512_256> : public BatchHasher<SHA512>
+{
+public:
+    BatchHasher() = default;
+    virtual ~BatchHasher() = default;
+    
+    // Methods
+    [[nodiscard]] std::vector<std::vector<uint8_t>> Hash(const std::vector<std::span<const uint8_t>>& messages) const;
+    
+    // Writes the digests back to back into digests, which must hold 32 bytes per message
+    void Hash(const std::vector<std::span<const uint8_t>>& messages, uint8_t* const digests) const;
+};
+
+}
+
+#endif /* SHA512_256_Batch_hpp */
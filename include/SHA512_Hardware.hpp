@@ -48,23 +48,33 @@ struct SHA512;
 template <typename HashAlgorithm, typename HardwareSoftwareImplementation>
 class Hasher;
 
+template <typename HashAlgorithm>
+class BatchHasher;
+
 // ***************************************************
 // Hasher class for SHA512 with SIMD support
 template <>
 class Hasher<SHA512, HARDWARE> : public Hasher<SHA512, SOFTWARE>
 {
+    // The batch hasher uses the selected kernel for single messages
+    friend class BatchHasher<SHA512>;
+    
 private:
+    // Block function kernels
 #if defined(HM_SIMD_ARM)
-    void         TransformARM(const uint8_t* data);
+    static void TransformARM(uint64_t* const state, const uint8_t* data, uint64_t numOfBlocks);
 #elif defined(HM_SIMD_X86)
-    void         TransformX86(const uint8_t* data);
+    HM_TARGET("avx2,bmi,bmi2") static void TransformAVX2(uint64_t* const state, const uint8_t* data, uint64_t numOfBlocks);
 #endif
     
 protected:
-    virtual void Transform(const uint8_t* const data) override;
+    // Kernel for this CPU, selected at runtime. Falls back to the software implementation
+    TransformFunction m_TransformFunction;
+    
+    static TransformFunction SelectTransformFunction();
     
 public:
-    Hasher() = default;
+    Hasher();
     virtual ~Hasher() = default;
     
     // Allow copy but no assign
@@ -78,6 +88,10 @@ public:
     virtual void Update(const std::string& str) override;
     
     [[nodiscard]] virtual std::vector<uint8_t> End() override;
+    
+    // Hashes a message of at most MAX_SHORT_MESSAGE_LENGTH bytes without a context or heap allocations.
+    // Writes the 64 byte digest to the given buffer
+    static void HashShort(const uint8_t* const data, const uint64_t size, uint8_t* const digest);
 };
 
 }
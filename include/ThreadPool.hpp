@@ -0,0 +1,92 @@
+/*
+    The zlib License
+
+    Copyright (C) 2024 Marc Schöndorf
+ 
+This software is provided 'as-is', without any express or implied warranty. In
+no event will the authors be held liable for any damages arising from the use of
+this software.
+
+Permission is granted to anyone to use this software for any purpose, including
+commercial applications, and to alter it and redistribute it freely, subject to
+the following restrictions:
+
+1.  The origin of this software must not be misrepresented; you must not claim
+    that you wrote the original software. If you use this software in a product,
+    an acknowledgment in the product documentation would be appreciated but is
+    not required.
+
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+
+3.  This notice may not be removed or altered from any source distribution.
+*/
+
+
+/*------------------------------------------------------------------*/
+/*                                                                  */
+/*                      (C) 2024 Marc Schöndorf                     */
+/*                            See license                           */
+/*                                                                  */
+/*  ThreadPool.hpp                                                  */
+/*  Created: 16.10.2026                                             */
+/*------------------------------------------------------------------*/
+
+#ifndef ThreadPool_hpp
+#define ThreadPool_hpp
+
+namespace HashMe
+{
+
+// ***************************************************
+// Fixed set of worker threads for the parallel hashing modes
+class ThreadPool
+{
+private:
+    // Shared state of one ParallelFor call. Workers which start after all tasks are taken only touch this state
+    struct ParallelForState
+    {
+        const std::function<void(uint64_t)>*    function = nullptr;
+        uint64_t                                numOfTasks = 0;
+        
+        std::atomic<uint64_t>                   nextTask = 0;
+        uint64_t                                numOfCompletedTasks = 0;
+        std::exception_ptr                      exception;
+        
+        std::mutex                              mutex;
+        std::condition_variable                 completed;
+    };
+    
+    std::vector<std::thread>                    m_Threads;
+    std::deque<std::function<void()>>           m_Tasks;
+    std::mutex                                  m_Mutex;
+    std::condition_variable                     m_TaskAvailable;
+    bool                                        m_Stop = false;
+    
+    // Methods
+    void WorkerLoop();
+    static void RunParallelForTasks(ParallelForState& state);
+    
+public:
+    // Zero threads uses one thread per hardware thread
+    explicit ThreadPool(const uint32_t numOfThreads = 0);
+    ~ThreadPool();
+    
+    // No copy and no assign
+    ThreadPool(const ThreadPool& other) = delete;
+    ThreadPool& operator=(const ThreadPool& other) = delete;
+    
+    // Methods
+    [[nodiscard]] uint32_t GetNumOfThreads() const;
+    
+    // Queues a task for the next free worker
+    void Submit(std::function<void()> task);
+    
+    // Runs function(task) for every task in [0, numOfTasks) and returns when all are done. The calling thread takes
+    // part, so this can be called from inside a task. The first exception thrown by a task is rethrown here
+    void ParallelFor(const uint64_t numOfTasks, const std::function<void(uint64_t)>& function);
+};
+
+}
+
+#endif /* ThreadPool_hpp */
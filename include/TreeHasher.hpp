@@ -0,0 +1,155 @@
+/*
+    The zlib License
+
+    Copyright (C) 2024 Marc Schöndorf
+ 
+This software is provided 'as-is', without any express or implied warranty. In
+no event will the authors be held liable for any damages arising from the use of
+this software.
+
+Permission is granted to anyone to use this software for any purpose, including
+commercial applications, and to alter it and redistribute it freely, subject to
+the following restrictions:
+
+1.  The origin of this software must not be misrepresented; you must not claim
+    that you wrote the original software. If you use this software in a product,
+    an acknowledgment in the product documentation would be appreciated but is
+    not required.
+
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+
+3.  This notice may not be removed or altered from any source distribution.
+*/
+
+
+/*------------------------------------------------------------------*/
+/*                                                                  */
+/*                      (C) 2024 Marc Schöndorf                     */
+/*                            See license                           */
+/*                                                                  */
+/*  TreeHasher.hpp                                                  */
+/*  Created: 16.10.2026                                             */
+/*------------------------------------------------------------------*/
+
+
+#ifndef TreeHasher_hpp
+#define TreeHasher_hpp
+
+namespace HashMe
+{
+
+// Dummy types for template
+struct SHA256;
+
+// ***************************************************
+// Forward declaration for tree hasher class
+template <typename HashAlgorithm>
+class TreeHasher;
+
+// ***************************************************
+// Hashes a single large message on all cores. The message is split into chunks of chunkSize bytes (the last one
+// may be shorter, an empty message is one empty chunk) which are hashed concurrently:
+//
+//     chunk digest = SHA256(0x00 || chunk)
+//     node digest  = SHA256(0x01 || up to fanout digests of the level below)
+//     root digest  = SHA256(0x02 || message length || chunk size || fanout || top digest)
+//
+// The levels are reduced until a single top digest remains. The lengths in the root are 8 byte big endian, the fanout
+// 4 byte big endian. The digest differs from SHA256 of the message, producer and verifier must use this class with
+// the same chunk size and fanout
+template <>
+class TreeHasher<SHA256> : public HasherBase
+{
+public:
+    // ***************************************************
+    // Constants
+    inline static constexpr uint64_t DEFAULT_CHUNK_SIZE = 1024 * 1024;
+    inline static constexpr uint32_t DEFAULT_FANOUT = 16;
+    
+private:
+    // ***************************************************
+    // Constants
+    inline static constexpr uint32_t DIGEST_LENGTH = 32;
+    inline static constexpr uint32_t BLOCK_LENGTH = 64;
+    inline static constexpr uint64_t NUM_OF_NODES_PER_TASK = 4096;
+    
+    // Hasher state after absorbing the chunk (0x00) and node (0x01) prefix. Created on first use, so a TreeHasher
+    // also works during the static initialization of another translation unit
+    static const BatchHasher<SHA256>::Midstate& ChunkMidstate();
+    static const BatchHasher<SHA256>::Midstate& NodeMidstate();
+    
+    // Chunks which are not hashed yet and the chunk digests, guarded by mutex. The tasks on the thread pool only hold
+    // this state, so a task may still run after the hasher is gone and then finds the queue empty
+    struct StreamState
+    {
+        BatchHasher<SHA256>                                     batchHasher;
+        std::deque<std::pair<uint64_t, std::vector<uint8_t>>>   chunks; // Chunk index and data, oldest first
+        std::vector<uint8_t>                                    chunkDigests;
+        std::vector<std::vector<uint8_t>>                       freeChunks;
+        uint64_t                                                numOfPendingChunks = 0; // Queued and being hashed
+        std::exception_ptr                                      exception;
+        
+        std::mutex                                              mutex;
+        std::condition_variable                                 chunkDone;
+    };
+    
+    ThreadPool&             m_ThreadPool;
+    const uint64_t          m_ChunkSize;
+    const uint32_t          m_Fanout;
+    BatchHasher<SHA256>     m_BatchHasher;
+    
+    // Streaming state. Full chunks are copied and dispatched to the thread pool, at most m_MaxNumOfPendingChunks at a time
+    std::vector<uint8_t>                m_Chunk;
+    uint64_t                            m_MessageLength = 0;
+    uint64_t                            m_NumOfChunks = 0;
+    const uint64_t                      m_MaxNumOfPendingChunks;
+    std::shared_ptr<StreamState>        m_StreamState;
+    
+    // Methods
+    virtual void Initialize() override;
+    
+    // Hashes the oldest queued chunk on the calling thread. Returns false if no chunk is queued
+    static bool HashQueuedChunk(StreamState& state);
+    
+    void DispatchChunk();
+    void HashQueuedChunks(const uint64_t maxNumOfPendingChunks);
+    void WaitForPendingChunks();
+    
+    // Reduces the chunk digests to the top digest and writes the root digest
+    void Finalize(std::vector<uint8_t>& digests, const uint64_t messageLength, uint8_t* const root) const;
+    
+public:
+    // chunkSize must be a multiple of 64 bytes, fanout at least 2
+    explicit TreeHasher(ThreadPool& threadPool, const uint64_t chunkSize = DEFAULT_CHUNK_SIZE, const uint32_t fanout = DEFAULT_FANOUT);
+    virtual ~TreeHasher();
+    
+    // No copy and no assign
+    TreeHasher(const TreeHasher& other) = delete;
+    TreeHasher& operator=(const TreeHasher& other) = delete;
+    const TreeHasher& operator=(const TreeHasher& other) const = delete;
+    
+    // Methods
+    virtual void Reset() override;
+    
+    // Streaming. Update() copies the data, every completed chunk is hashed on the thread pool while more data arrives.
+    // If too many chunks are pending, Update() hashes the oldest ones itself instead of waiting for a worker, so it can
+    // also be called from a task on the same pool. End() hashes the remaining chunks, returns the root digest and
+    // resets the hasher
+    virtual void Update(const uint8_t* const data, const uint64_t size) override;
+    virtual void Update(const std::vector<uint8_t>& data) override;
+    virtual void Update(const std::string& str) override;
+    
+    [[nodiscard]] virtual std::vector<uint8_t> End() override;
+    
+    // Hashes a message which is completely in memory, without copying it
+    [[nodiscard]] std::vector<uint8_t> Hash(const uint8_t* const data, const uint64_t size) const;
+    [[nodiscard]] std::vector<uint8_t> Hash(const std::vector<uint8_t>& data) const;
+    
+    [[nodiscard]] uint64_t GetChunkSize() const;
+    [[nodiscard]] uint32_t GetFanout() const;
+};
+
+}
+
+#endif /* TreeHasher_hpp */
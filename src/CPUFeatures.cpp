@@ -0,0 +1,214 @@
+/*
+    The zlib License
+
+    Copyright (C) 2024 Marc Schöndorf
+ 
+This software is provided 'as-is', without any express or implied warranty. In
+no event will the authors be held liable for any damages arising from the use of
+this software.
+
+Permission is granted to anyone to use this software for any purpose, including
+commercial applications, and to alter it and redistribute it freely, subject to
+the following restrictions:
+
+1.  The origin of this software must not be misrepresented; you must not claim
+    that you wrote the original software. If you use this software in a product,
+    an acknowledgment in the product documentation would be appreciated but is
+    not required.
+
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+
+3.  This notice may not be removed or altered from any source distribution.
+*/
+
+
+/*------------------------------------------------------------------*/
+/*                                                                  */
+/*                      (C) 2024 Marc Schöndorf                     */
+/*                            See license                           */
+/*                                                                  */
+/*  CPUFeatures.cpp                                                 */
+/*  Created: 16.10.2026                                             */
+/*------------------------------------------------------------------*/
+
+#include "HashMe.hpp"
+
+#if defined(HM_SIMD_X86) && defined(HASH_PREDEF_COMP_GNUC_AVAILABLE)
+#include <cpuid.h>
+#elif defined(HM_SIMD_X86) && defined(HASH_PREDEF_COMP_MSVC_AVAILABLE)
+#include <intrin.h>
+#endif
+
+using namespace HashMe;
+
+#if defined(HM_SIMD_X86)
+// Executes CPUID for the given leaf and subleaf. Result is EAX, EBX, ECX, EDX
+static void CPUID(const uint32_t leaf, const uint32_t subleaf, uint32_t (&regs)[4])
+{
+#if defined(HASH_PREDEF_COMP_GNUC_AVAILABLE)
+    if(!__get_cpuid_count(leaf, subleaf, &regs[0], &regs[1], &regs[2], &regs[3]))
+        regs[0] = regs[1] = regs[2] = regs[3] = 0;
+#elif defined(HASH_PREDEF_COMP_MSVC_AVAILABLE)
+    int32_t info[4];
+    __cpuidex(info, static_cast<int32_t>(leaf), static_cast<int32_t>(subleaf));
+    
+    for(uint32_t i = 0; i < 4; i++)
+        regs[i] = static_cast<uint32_t>(info[i]);
+#endif
+}
+
+// Reads the XCR0 register to check which register states are saved by the OS
+static uint64_t ReadXCR0()
+{
+#if defined(HASH_PREDEF_COMP_GNUC_AVAILABLE)
+    uint32_t eax, edx;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    
+    return (static_cast<uint64_t>(edx) << 32) | eax;
+#elif defined(HASH_PREDEF_COMP_MSVC_AVAILABLE)
+    return _xgetbv(0);
+#endif
+}
+#endif
+
+static CPU::Features ProbeFeatures()
+{
+    CPU::Features features;
+    
+#if defined(HM_SIMD_X86)
+    uint32_t regs[4];
+    
+    CPUID(0, 0, regs);
+    const uint32_t maxLeaf = regs[0];
+    
+    if(maxLeaf >= 1)
+    {
+        CPUID(1, 0, regs);
+        
+        features.hasPCLMULQDQ   = regs[2] & (1u << 1);
+        features.hasSSSE3       = regs[2] & (1u << 9);
+        features.hasSSE41       = regs[2] & (1u << 19);
+        features.hasSSE42       = regs[2] & (1u << 20);
+        
+        // AVX also needs the OS to save the YMM registers
+        const bool hasOSXSAVE = regs[2] & (1u << 27);
+        const uint64_t xcr0 = hasOSXSAVE ? ReadXCR0() : 0;
+        const bool osSavesYMM = (xcr0 & 0x06) == 0x06;
+        const bool osSavesZMM = (xcr0 & 0xE6) == 0xE6;
+        
+        features.hasAVX = (regs[2] & (1u << 28)) && osSavesYMM;
+        
+        if(maxLeaf >= 7)
+        {
+            CPUID(7, 0, regs);
+            
+            features.hasBMI1        = regs[1] & (1u << 3);
+            features.hasAVX2        = (regs[1] & (1u << 5)) && osSavesYMM;
+            features.hasBMI2        = regs[1] & (1u << 8);
+            features.hasAVX512F     = (regs[1] & (1u << 16)) && osSavesZMM;
+            features.hasSHA         = regs[1] & (1u << 29);
+            features.hasAVX512BW    = (regs[1] & (1u << 30)) && osSavesZMM;
+            features.hasAVX512VL    = (regs[1] & (1u << 31)) && osSavesZMM;
+            features.hasVPCLMULQDQ  = (regs[2] & (1u << 10)) && osSavesYMM;
+        }
+    }
+#elif defined(HM_SIMD_ARM)
+    // The library is compiled for ARMv8 with these extensions, so they are known at compile time
+#if defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO)
+    features.hasARMSHA2 = true;
+#endif
+#if defined(__ARM_FEATURE_SHA512)
+    features.hasARMSHA512 = true;
+#endif
+#if defined(__ARM_FEATURE_CRC32)
+    features.hasARMCRC32 = true;
+#endif
+#if defined(__ARM_FEATURE_AES) || defined(__ARM_FEATURE_CRYPTO)
+    features.hasARMPMULL = true;
+#endif
+#endif
+    
+    return features;
+}
+
+// Names of the features for printing and for the HASHME_DISABLE_CPU_FEATURES environment variable
+static constexpr std::pair<const char*, bool CPU::Features::*> FEATURE_NAMES[] =
+{
+    { "ssse3",      &CPU::Features::hasSSSE3 },
+    { "sse41",      &CPU::Features::hasSSE41 },
+    { "sse42",      &CPU::Features::hasSSE42 },
+    { "pclmulqdq",  &CPU::Features::hasPCLMULQDQ },
+    { "avx",        &CPU::Features::hasAVX },
+    { "avx2",       &CPU::Features::hasAVX2 },
+    { "bmi",        &CPU::Features::hasBMI1 },
+    { "bmi2",       &CPU::Features::hasBMI2 },
+    { "sha",        &CPU::Features::hasSHA },
+    { "avx512f",    &CPU::Features::hasAVX512F },
+    { "avx512bw",   &CPU::Features::hasAVX512BW },
+    { "avx512vl",   &CPU::Features::hasAVX512VL },
+    { "vpclmulqdq", &CPU::Features::hasVPCLMULQDQ },
+    { "armsha2",    &CPU::Features::hasARMSHA2 },
+    { "armsha512",  &CPU::Features::hasARMSHA512 },
+    { "armcrc32",   &CPU::Features::hasARMCRC32 },
+    { "armpmull",   &CPU::Features::hasARMPMULL },
+};
+
+static void DisableFeaturesFromEnvironment(CPU::Features& features)
+{
+    const char* const env = std::getenv("HASHME_DISABLE_CPU_FEATURES");
+    if(!env)
+        return;
+    
+    const std::string list(env);
+    size_t start = 0;
+    
+    while(start <= list.size())
+    {
+        size_t end = list.find(',', start);
+        if(end == std::string::npos)
+            end = list.size();
+        
+        const std::string name = list.substr(start, end - start);
+        
+        for(const auto& [featureName, member] : FEATURE_NAMES)
+        {
+            if(name == featureName || name == "all")
+                features.*member = false;
+        }
+        
+        start = end + 1;
+    }
+}
+
+const CPU::Features& CPU::GetFeatures()
+{
+    static const Features features = []()
+    {
+        Features probed = ProbeFeatures();
+        DisableFeaturesFromEnvironment(probed);
+        
+        return probed;
+    }();
+    
+    return features;
+}
+
+std::string CPU::GetFeaturesString()
+{
+    const Features& features = GetFeatures();
+    std::string result;
+    
+    for(const auto& [featureName, member] : FEATURE_NAMES)
+    {
+        if(features.*member)
+        {
+            if(!result.empty())
+                result += ' ';
+            
+            result += featureName;
+        }
+    }
+    
+    return result.empty() ? "none" : result;
+}
@@ -0,0 +1,121 @@
+/*
+    The zlib License
+
+    Copyright (C) 2024 Marc Schöndorf
+ 
+This software is provided 'as-is', without any express or implied warranty. In
+no event will the authors be held liable for any damages arising from the use of
+this software.
+
+Permission is granted to anyone to use this software for any purpose, including
+commercial applications, and to alter it and redistribute it freely, subject to
+the following restrictions:
+
+1.  The origin of this software must not be misrepresented; you must not claim
+    that you wrote the original software. If you use this software in a product,
+    an acknowledgment in the product documentation would be appreciated but is
+    not required.
+
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+
+3.  This notice may not be removed or altered from any source distribution.
+*/
+
+/*------------------------------------------------------------------*/
+/*                                                                  */
+/*                      (C) 2024 Marc Schöndorf                     */
+/*                            See license                           */
+/*                                                                  */
+/*  CRC16_Hardware.cpp                                              */
+/*  Created: 16.10.2026                                             */
+/*------------------------------------------------------------------*/
+
+#include "HashMe.hpp"
+
+#if defined(HM_SIMD_ARM) || defined(HM_SIMD_X86)
+
+using namespace HashMe;
+
+Hasher<CRC16, HARDWARE>::Hasher()
+    : m_UpdateFunction(SelectUpdateFunction())
+{
+}
+
+Hasher<CRC16, HARDWARE>::Hasher(const Hasher& other)
+    : Hasher<CRC16, SOFTWARE>(other)
+    , m_UpdateFunction(other.m_UpdateFunction)
+{
+}
+
+Hasher<CRC16, HARDWARE>::UpdateFunction Hasher<CRC16, HARDWARE>::SelectUpdateFunction()
+{
+#if defined(HM_SIMD_X86)
+    const CPU::Features& features = CPU::GetFeatures();
+    
+    if(features.hasVPCLMULQDQ && features.hasAVX512F && features.hasPCLMULQDQ && features.hasSSE41)
+        return UpdateVPCLMUL;
+    
+    if(features.hasPCLMULQDQ && features.hasSSE41)
+        return UpdatePCLMUL;
+#endif
+    
+    return nullptr;
+}
+
+#if defined(HM_SIMD_X86)
+uint16_t Hasher<CRC16, HARDWARE>::UpdatePCLMUL(const uint16_t crc, const uint8_t* const data, const uint64_t size)
+{
+    return CRCFolding<uint16_t, 0xA001>::Update(crc, data, size); // No first remainder and final XOR
+}
+
+uint16_t Hasher<CRC16, HARDWARE>::UpdateVPCLMUL(const uint16_t crc, const uint8_t* const data, const uint64_t size)
+{
+    return CRCFolding<uint16_t, 0xA001>::UpdateWide(crc, data, size);
+}
+#endif
+
+uint16_t Hasher<CRC16, HARDWARE>::ComputeRange(const uint16_t currentCRC, const uint8_t* const data, const uint64_t size)
+{
+    if(!m_UpdateFunction)
+        return Compute(currentCRC, data, size);
+    
+#if defined(HM_SIMD_X86)
+    if(size < CRCFolding<uint16_t, 0xA001>::MIN_SIZE)
+        return Compute(currentCRC, data, size);
+    
+    // The kernel folds the whole 16 byte chunks, the tail goes through the lookup tables
+    const uint64_t foldedSize = size & ~0x0FULL;
+    const uint16_t crc = m_UpdateFunction(currentCRC, data, foldedSize);
+    
+    if(foldedSize == size)
+        return crc;
+    
+    return Compute(crc, data + foldedSize, size - foldedSize);
+#else
+    return m_UpdateFunction(currentCRC, data, size);
+#endif
+}
+
+void Hasher<CRC16, HARDWARE>::Update(const uint8_t* const data, const uint64_t size)
+{
+    if(!data)
+        throw std::invalid_argument("Data cannot be nullptr.");
+    
+    if(size == 0)
+        throw std::invalid_argument("Data size cannot be zero.");
+    
+    m_CRC16Result = ComputeRange(m_CRC16Result, data, size);
+}
+
+void Hasher<CRC16, HARDWARE>::Update(const std::vector<uint8_t>& data)
+{
+    Update(data.data(), data.size());
+}
+
+void Hasher<CRC16, HARDWARE>::Update(const std::string& str)
+{
+    Update(reinterpret_cast<const uint8_t*>(str.data()), str.size());
+}
+
+#endif /* HM_SIMD_ARM || HM_SIMD_X86 */
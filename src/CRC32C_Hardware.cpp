@@ -0,0 +1,281 @@
+/*
+    The zlib License
+
+    Copyright (C) 2024 Marc Schöndorf
+ 
+This software is provided 'as-is', without any express or implied warranty. In
+no event will the authors be held liable for any damages arising from the use of
+this software.
+
+Permission is granted to anyone to use this software for any purpose, including
+commercial applications, and to alter it and redistribute it freely, subject to
+the following restrictions:
+
+1.  The origin of this software must not be misrepresented; you must not claim
+    that you wrote the original software. If you use this software in a product,
+    an acknowledgment in the product documentation would be appreciated but is
+    not required.
+
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+
+3.  This notice may not be removed or altered from any source distribution.
+*/
+
+
+/*------------------------------------------------------------------*/
+/*                                                                  */
+/*                      (C) 2024 Marc Schöndorf                     */
+/*                            See license                           */
+/*                                                                  */
+/*  CRC32C_Hardware.cpp                                             */
+/*  Created: 16.10.2026                                             */
+/*------------------------------------------------------------------*/
+
+#include "HashMe.hpp"
+
+#if defined(HM_SIMD_ARM) || defined(HM_SIMD_X86)
+
+using namespace HashMe;
+
+Hasher<CRC32C, HARDWARE>::Hasher()
+    : m_UpdateFunction(SelectUpdateFunction())
+{
+}
+
+Hasher<CRC32C, HARDWARE>::Hasher(const Hasher& other)
+    : Hasher<CRC32C, SOFTWARE>(other)
+    , m_UpdateFunction(other.m_UpdateFunction)
+{
+}
+
+Hasher<CRC32C, HARDWARE>::UpdateFunction Hasher<CRC32C, HARDWARE>::SelectUpdateFunction()
+{
+#if defined(HM_SIMD_ARM)
+    if(CPU::GetFeatures().hasARMCRC32)
+        return UpdateARM;
+#elif defined(HM_SIMD_X86)
+    const CPU::Features& features = CPU::GetFeatures();
+    
+    if(features.hasSSE42 && features.hasVPCLMULQDQ && features.hasAVX512F && features.hasPCLMULQDQ && features.hasSSE41)
+        return UpdateVPCLMUL;
+    
+    if(features.hasSSE42)
+        return UpdateSSE42;
+#endif
+    
+    return nullptr;
+}
+
+#if defined(HM_SIMD_ARM)
+uint32_t Hasher<CRC32C, HARDWARE>::UpdateARM(const uint32_t crc, const uint8_t* const data, const uint64_t size)
+{
+    const uint8_t* buffer8 = data;
+    
+    uint32_t result = ~crc;
+    uint64_t bytesToProcess = size;
+    
+    while(bytesToProcess > 0 && (reinterpret_cast<std::uintptr_t>(buffer8) & 7) > 0)
+    {
+        result = __crc32cb(result, *buffer8++);
+        bytesToProcess--;
+    }
+    
+    // Buffer is aligned now
+    const uint64_t* buffer64 = reinterpret_cast<const uint64_t*>(buffer8);
+    
+    while(bytesToProcess >= 64)
+    {
+        result = __crc32cd(result, *buffer64++);
+        result = __crc32cd(result, *buffer64++);
+        result = __crc32cd(result, *buffer64++);
+        result = __crc32cd(result, *buffer64++);
+        
+        result = __crc32cd(result, *buffer64++);
+        result = __crc32cd(result, *buffer64++);
+        result = __crc32cd(result, *buffer64++);
+        result = __crc32cd(result, *buffer64++);
+        
+        bytesToProcess -= 64;
+    }
+    
+    while(bytesToProcess >= 8)
+    {
+        result = __crc32cd(result, *buffer64++);
+        bytesToProcess -= 8;
+    }
+    
+    buffer8 = reinterpret_cast<const uint8_t*>(buffer64);
+    
+    while(bytesToProcess > 0)
+    {
+        result = __crc32cb(result, *buffer8++);
+        bytesToProcess--;
+    }
+    
+    return ~result;
+}
+#elif defined(HM_SIMD_X86)
+// ***************************************************
+// Tables for shifting a CRC over a block of zero bytes. The crc32 instruction has a latency of 3 cycles but a throughput of 1,
+// so three consecutive blocks are processed as independent streams. Afterwards the CRC of the first block is shifted
+// over the second block and combined with its CRC, the same again for the third block
+inline static constexpr uint32_t CRC32C_POLYNOMIAL = 0x82F63B78;
+
+// Multiplies a and b modulo the bit reflected polynomial
+static constexpr uint32_t MultiplyModP(const uint32_t a, uint32_t b)
+{
+    uint32_t product = 0;
+    
+    for(uint32_t mask = 0x80000000; mask > 0; mask >>= 1)
+    {
+        if(a & mask)
+            product ^= b;
+        
+        b = (b & 1) ? (b >> 1) ^ CRC32C_POLYNOMIAL : (b >> 1);
+    }
+    
+    return product;
+}
+
+// Lookup tables for multiplying a CRC by x^(8 * numOfBytes), one table per byte of the CRC
+static constexpr std::array<std::array<uint32_t, 256>, 4> CreateShiftTables(const uint64_t numOfBytes)
+{
+    // x^(8 * numOfBytes) modulo the polynomial, x^0 is the highest bit in the reflected representation
+    uint32_t power = 0x80000000;
+    for(uint64_t i = 0; i < 8 * numOfBytes; i++)
+        power = (power & 1) ? (power >> 1) ^ CRC32C_POLYNOMIAL : (power >> 1);
+    
+    std::array<std::array<uint32_t, 256>, 4> tables{};
+    for(uint32_t byte = 0; byte < 4; byte++)
+    {
+        for(uint32_t i = 0; i < 256; i++)
+            tables[byte][i] = MultiplyModP(power, i << (8 * byte));
+    }
+    
+    return tables;
+}
+
+// Long blocks for big buffers and short blocks for the rest, like 4 KiB pages
+inline static constexpr uint64_t LONG_BLOCK_LENGTH = 8192;
+inline static constexpr uint64_t SHORT_BLOCK_LENGTH = 256;
+
+inline static constexpr std::array<std::array<uint32_t, 256>, 4> LONG_SHIFT_TABLES = CreateShiftTables(LONG_BLOCK_LENGTH);
+inline static constexpr std::array<std::array<uint32_t, 256>, 4> SHORT_SHIFT_TABLES = CreateShiftTables(SHORT_BLOCK_LENGTH);
+
+static inline uint64_t Shift(const std::array<std::array<uint32_t, 256>, 4>& tables, const uint64_t crc)
+{
+    return tables[0][crc & 0xFF] ^ tables[1][(crc >> 8) & 0xFF] ^ tables[2][(crc >> 16) & 0xFF] ^ tables[3][(crc >> 24) & 0xFF];
+}
+
+// Processes as many groups of three consecutive blocks as fit into the buffer
+template <uint64_t BlockLength>
+HM_TARGET("sse4.2") static inline uint64_t Update3Way(uint64_t crc, const uint64_t*& buffer64, uint64_t& bytesToProcess,
+                                                     const std::array<std::array<uint32_t, 256>, 4>& shiftTables)
+{
+    constexpr uint64_t NUM_OF_WORDS = BlockLength / 8;
+    
+    while(bytesToProcess >= 3 * BlockLength)
+    {
+        uint64_t crc1 = 0;
+        uint64_t crc2 = 0;
+        
+        for(uint64_t i = 0; i < NUM_OF_WORDS; i++)
+        {
+            crc = _mm_crc32_u64(crc, buffer64[i]);
+            crc1 = _mm_crc32_u64(crc1, buffer64[NUM_OF_WORDS + i]);
+            crc2 = _mm_crc32_u64(crc2, buffer64[2 * NUM_OF_WORDS + i]);
+        }
+        
+        crc = Shift(shiftTables, crc) ^ crc1;
+        crc = Shift(shiftTables, crc) ^ crc2;
+        
+        buffer64 += 3 * NUM_OF_WORDS;
+        bytesToProcess -= 3 * BlockLength;
+    }
+    
+    return crc;
+}
+
+HM_TARGET("sse4.2") uint32_t Hasher<CRC32C, HARDWARE>::UpdateSSE42(const uint32_t crc, const uint8_t* const data, const uint64_t size)
+{
+    const uint8_t* buffer8 = data;
+    
+    uint64_t result = ~crc;
+    uint64_t bytesToProcess = size;
+    
+    while(bytesToProcess > 0 && (reinterpret_cast<std::uintptr_t>(buffer8) & 7) > 0)
+    {
+        result = _mm_crc32_u8(static_cast<uint32_t>(result), *buffer8++);
+        bytesToProcess--;
+    }
+    
+    // Buffer is aligned now
+    const uint64_t* buffer64 = reinterpret_cast<const uint64_t*>(buffer8);
+    
+    result = Update3Way<LONG_BLOCK_LENGTH>(result, buffer64, bytesToProcess, LONG_SHIFT_TABLES);
+    result = Update3Way<SHORT_BLOCK_LENGTH>(result, buffer64, bytesToProcess, SHORT_SHIFT_TABLES);
+    
+    while(bytesToProcess >= 8)
+    {
+        result = _mm_crc32_u64(result, *buffer64++);
+        bytesToProcess -= 8;
+    }
+    
+    buffer8 = reinterpret_cast<const uint8_t*>(buffer64);
+    
+    while(bytesToProcess > 0)
+    {
+        result = _mm_crc32_u8(static_cast<uint32_t>(result), *buffer8++);
+        bytesToProcess--;
+    }
+    
+    return ~static_cast<uint32_t>(result);
+}
+
+uint32_t Hasher<CRC32C, HARDWARE>::UpdateVPCLMUL(const uint32_t crc, const uint8_t* const data, const uint64_t size)
+{
+    // The 3-way crc32 kernel is faster than 128 bit folding, so only the wide folding is used
+    if(size < CRCFolding<uint32_t, 0x82F63B78>::WIDE_MIN_SIZE)
+        return UpdateSSE42(crc, data, size);
+    
+    const uint64_t foldedSize = size & ~static_cast<uint64_t>(0x0F);
+    const uint32_t result = ~CRCFolding<uint32_t, 0x82F63B78>::UpdateWide(~crc, data, foldedSize);
+    
+    if(foldedSize == size)
+        return result;
+    
+    return UpdateSSE42(result, data + foldedSize, size - foldedSize);
+}
+#endif
+
+uint32_t Hasher<CRC32C, HARDWARE>::ComputeRange(const uint32_t currentCRC, const uint8_t* const data, const uint64_t size)
+{
+    if(m_UpdateFunction)
+        return m_UpdateFunction(currentCRC, data, size);
+    
+    return Compute(currentCRC, data, size);
+}
+
+void Hasher<CRC32C, HARDWARE>::Update(const uint8_t* const data, const uint64_t size)
+{
+    if(!data)
+        throw std::invalid_argument("Data cannot be nullptr.");
+    
+    if(size == 0)
+        throw std::invalid_argument("Data size cannot be zero.");
+    
+    m_CRC32CResult = ComputeRange(m_CRC32CResult, data, size);
+}
+
+void Hasher<CRC32C, HARDWARE>::Update(const std::vector<uint8_t>& data)
+{
+    Update(data.data(), data.size());
+}
+
+void Hasher<CRC32C, HARDWARE>::Update(const std::string& str)
+{
+    Update(reinterpret_cast<const uint8_t*>(str.data()), str.size());
+}
+
+#endif /* HM_SIMD_ARM || HM_SIMD_X86 */
@@ -37,29 +37,42 @@ the following restrictions:
 
 using namespace HashMe;
 
-Hasher<CRC32, HARDWARE>::Hasher(const Hasher& other)
+Hasher<CRC32, HARDWARE>::Hasher()
+    : m_UpdateFunction(SelectUpdateFunction())
 {
-    m_CRC32Result = other.m_CRC32Result;
 }
 
-void Hasher<CRC32, HARDWARE>::Reset()
+Hasher<CRC32, HARDWARE>::Hasher(const Hasher& other)
+    : Hasher<CRC32, SOFTWARE>(other)
+    , m_UpdateFunction(other.m_UpdateFunction)
 {
-    m_CRC32Result = 0;
 }
 
-#if defined(HM_SIMD_ARM)
-void Hasher<CRC32, HARDWARE>::Update(const uint8_t* const data, const uint64_t size)
+Hasher<CRC32, HARDWARE>::UpdateFunction Hasher<CRC32, HARDWARE>::SelectUpdateFunction()
 {
-    if(!data)
-        throw std::invalid_argument("Data cannot be nullptr.");
+#if defined(HM_SIMD_ARM)
+    if(CPU::GetFeatures().hasARMCRC32)
+        return UpdateARM;
+#elif defined(HM_SIMD_X86)
+    // The SSE4.2 crc32 instruction uses the Castagnoli polynomial and can't be used here, so we fold with carry-less multiplication
+    const CPU::Features& features = CPU::GetFeatures();
     
-    if(size == 0)
-        throw std::invalid_argument("Data size cannot be zero.");
+    if(features.hasVPCLMULQDQ && features.hasAVX512F && features.hasPCLMULQDQ && features.hasSSE41)
+        return UpdateVPCLMUL;
     
+    if(features.hasPCLMULQDQ && features.hasSSE41)
+        return UpdatePCLMUL;
+#endif
+    
+    return nullptr;
+}
+
+#if defined(HM_SIMD_ARM)
+uint32_t Hasher<CRC32, HARDWARE>::UpdateARM(const uint32_t crc, const uint8_t* const data, const uint64_t size)
+{
     const uint8_t* buffer8 = data;
-    const uint64_t* buffer64 = reinterpret_cast<const uint64_t*>(data);
     
-    uint32_t result = ~m_CRC32Result;
+    uint32_t result = ~crc;
     uint64_t bytesToProcess = size;
     
     while(bytesToProcess > 0 && (reinterpret_cast<std::uintptr_t>(buffer8) & 7) > 0)
@@ -68,6 +81,9 @@ void Hasher<CRC32, HARDWARE>::Update(const uint8_t* const data, const uint64_t s
         bytesToProcess--;
     }
     
+    // Buffer is aligned now
+    const uint64_t* buffer64 = reinterpret_cast<const uint64_t*>(buffer8);
+    
     while(bytesToProcess >= 64)
     {
         result = __crc32d(result, *buffer64++);
@@ -97,36 +113,61 @@ void Hasher<CRC32, HARDWARE>::Update(const uint8_t* const data, const uint64_t s
         bytesToProcess--;
     }
     
-    m_CRC32Result = ~result;
+    return ~result;
 }
 #elif defined(HM_SIMD_X86)
-void Hasher<CRC32, HARDWARE>::Update(const uint8_t* const data, const uint64_t size)
+uint32_t Hasher<CRC32, HARDWARE>::UpdatePCLMUL(const uint32_t crc, const uint8_t* const data, const uint64_t size)
 {
-    //static_assert(0, "Not implemented");
+    return ~CRCFolding<uint32_t, 0xEDB88320>::Update(~crc, data, size);
 }
-#endif
 
-void Hasher<CRC32, HARDWARE>::Update(const std::vector<uint8_t>& data)
+uint32_t Hasher<CRC32, HARDWARE>::UpdateVPCLMUL(const uint32_t crc, const uint8_t* const data, const uint64_t size)
 {
-    Update(data.data(), data.size());
+    return ~CRCFolding<uint32_t, 0xEDB88320>::UpdateWide(~crc, data, size);
 }
+#endif
 
-void Hasher<CRC32, HARDWARE>::Update(const std::string& str)
+uint32_t Hasher<CRC32, HARDWARE>::ComputeRange(const uint32_t currentCRC, const uint8_t* const data, const uint64_t size)
 {
-    Update(reinterpret_cast<const uint8_t*>(str.data()), str.size());
+    if(!m_UpdateFunction)
+        return Compute(currentCRC, data, size);
+    
+#if defined(HM_SIMD_X86)
+    if(size < CRCFolding<uint32_t, 0xEDB88320>::MIN_SIZE)
+        return Compute(currentCRC, data, size);
+    
+    // The kernel folds the whole 16 byte chunks, the tail goes through the lookup tables
+    const uint64_t foldedSize = size & ~0x0FULL;
+    const uint32_t crc = m_UpdateFunction(currentCRC, data, foldedSize);
+    
+    if(foldedSize == size)
+        return crc;
+    
+    return Compute(crc, data + foldedSize, size - foldedSize);
+#else
+    return m_UpdateFunction(currentCRC, data, size);
+#endif
 }
 
-std::vector<uint8_t> Hasher<CRC32, HARDWARE>::End()
+void Hasher<CRC32, HARDWARE>::Update(const uint8_t* const data, const uint64_t size)
 {
-    std::vector<uint8_t> result(4);
-    Utils::U32toU8<Utils::REVERSE_ENDIANNESS>(m_CRC32Result, &result[0]);
+    if(!data)
+        throw std::invalid_argument("Data cannot be nullptr.");
     
-    return result;
+    if(size == 0)
+        throw std::invalid_argument("Data size cannot be zero.");
+    
+    m_CRC32Result = ComputeRange(m_CRC32Result, data, size);
+}
+
+void Hasher<CRC32, HARDWARE>::Update(const std::vector<uint8_t>& data)
+{
+    Update(data.data(), data.size());
 }
 
-uint32_t Hasher<CRC32, HARDWARE>::End_GetAsInteger32()
+void Hasher<CRC32, HARDWARE>::Update(const std::string& str)
 {
-    return m_CRC32Result;
+    Update(reinterpret_cast<const uint8_t*>(str.data()), str.size());
 }
 
 #endif /* HM_SIMD_ARM || HM_SIMD_X86 */
@@ -0,0 +1,289 @@
+/*
+    The zlib License
+
+    Copyright (C) 2024 Marc Schöndorf
+ 
+This software is provided 'as-is', without any express or implied warranty. In
+no event will the authors be held liable for any damages arising from the use of
+this software.
+
+Permission is granted to anyone to use this software for any purpose, including
+commercial applications, and to alter it and redistribute it freely, subject to
+the following restrictions:
+
+1.  The origin of this software must not be misrepresented; you must not claim
+    that you wrote the original software. If you use this software in a product,
+    an acknowledgment in the product documentation would be appreciated but is
+    not required.
+
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+
+3.  This notice may not be removed or altered from any source distribution.
+*/
+
+
+/*------------------------------------------------------------------*/
+/*                                                                  */
+/*                      (C) 2024 Marc Schöndorf                     */
+/*                            See license                           */
+/*                                                                  */
+/*  CRC_Folding.cpp                                                 */
+/*  Created: 16.10.2026                                             */
+/*------------------------------------------------------------------*/
+
+#include "HashMe.hpp"
+
+#if defined(HM_SIMD_X86)
+
+using namespace HashMe;
+
+// ***************************************************
+// A bit reflected CRC of width n equals the low n bits of a 64 bit reflected CRC with the polynomial P(x) * x^(64 - n).
+// Its reflected form is the zero extended polynomial of the CRC, so all widths share the 64 bit folding and reduction.
+// In reflected form x^0 is the highest bit and multiplying by x is a right shift
+
+// x^n modulo the polynomial
+static constexpr uint64_t XPowModP(const uint64_t polynomial, const uint32_t n)
+{
+    uint64_t result = 1ULL << 63;
+    
+    for(uint32_t i = 0; i < n; i++)
+        result = (result & 1) ? (result >> 1) ^ polynomial : (result >> 1);
+    
+    return result;
+}
+
+static constexpr uint64_t Reflect64(const uint64_t data)
+{
+    uint64_t result = 0;
+    
+    for(uint32_t bit = 0; bit < 64; bit++)
+    {
+        if(data & (1ULL << bit))
+            result |= 1ULL << (63 - bit);
+    }
+    
+    return result;
+}
+
+// Low 64 bits of floor(x^128 / P(x)) for the Barrett reduction, the quotient always has the term x^64
+static constexpr uint64_t BarrettConstant(const uint64_t polynomial)
+{
+    const uint64_t polynomialLow = Reflect64(polynomial); // P(x) without x^64, not reflected
+    
+    uint64_t quotient = 0;
+    uint64_t remainder = 0;
+    bool leadingTerm = true;
+    
+    // Long division, the remainder holds the 64 terms below the leading one
+    for(int32_t i = 64; i >= 0; i--)
+    {
+        if(leadingTerm)
+        {
+            if(i < 64)
+                quotient |= 1ULL << i;
+            
+            remainder ^= polynomialLow;
+        }
+        
+        leadingTerm = (remainder >> 63) != 0;
+        remainder <<= 1;
+    }
+    
+    return Reflect64(quotient);
+}
+
+// Folds the accumulator forward by the distance encoded in the constants and adds the next 128 bits of data
+HM_TARGET("pclmul") static inline __m128i Fold(const __m128i x, const __m128i constants, const __m128i next)
+{
+    const __m128i low = _mm_clmulepi64_si128(x, constants, 0x00);
+    const __m128i high = _mm_clmulepi64_si128(x, constants, 0x11);
+    
+    return _mm_xor_si128(_mm_xor_si128(low, high), next);
+}
+
+// Folding constants for a distance of numOfBits. The low half of the accumulator holds the higher powers and is folded over
+// 64 bits more. Multiplying two reflected values adds one factor x, so the constants use one power less
+template <uint64_t Polynomial, uint32_t NumOfBits>
+struct FoldConstants
+{
+    inline static constexpr uint64_t LOW = XPowModP(Polynomial, NumOfBits + 64 - 1);
+    inline static constexpr uint64_t HIGH = XPowModP(Polynomial, NumOfBits - 1);
+};
+
+// Folds the remaining 16 byte chunks into the accumulator and reduces it to the CRC
+template <uint64_t Polynomial>
+HM_TARGET("sse4.1,pclmul") static inline uint64_t FoldTailAndReduce(__m128i x, const uint8_t* const data, const uint64_t size)
+{
+    using FOLD_128 = FoldConstants<Polynomial, 128>;
+    constexpr uint64_t MU = BarrettConstant(Polynomial);
+    
+    const __m128i FOLD_BY_1 = _mm_set_epi64x(static_cast<int64_t>(FOLD_128::HIGH), static_cast<int64_t>(FOLD_128::LOW));
+    const __m128i BARRETT = _mm_set_epi64x(static_cast<int64_t>(Polynomial), static_cast<int64_t>(MU));
+    
+    const __m128i* buffer128 = reinterpret_cast<const __m128i*>(data);
+    uint64_t bytesToProcess = size;
+    
+    while(bytesToProcess >= 16)
+    {
+        x = Fold(x, FOLD_BY_1, _mm_loadu_si128(buffer128++));
+        bytesToProcess -= 16;
+    }
+    
+    // Multiply by x^64 for the CRC and fold the low half, which leaves a 128 bit value with the same remainder
+    const __m128i y = _mm_xor_si128(_mm_clmulepi64_si128(x, FOLD_BY_1, 0x10), _mm_srli_si128(x, 8));
+    
+    // Barrett reduction. The quotient is the low half plus the high bits of its product with the constant
+    __m128i t = _mm_clmulepi64_si128(y, BARRETT, 0x00);
+    const __m128i quotient = _mm_xor_si128(y, _mm_slli_epi64(t, 1));
+    
+    // The remainder is the high half plus the low 64 bits of quotient * P(x), which start at bit 63 of the product
+    t = _mm_clmulepi64_si128(quotient, BARRETT, 0x10);
+    
+    const uint64_t productLow = static_cast<uint64_t>(_mm_cvtsi128_si64(t));
+    const uint64_t productHigh = static_cast<uint64_t>(_mm_extract_epi64(t, 1));
+    
+    return static_cast<uint64_t>(_mm_extract_epi64(y, 1)) ^ (productHigh << 1) ^ (productLow >> 63);
+}
+
+template <typename CRCSize, CRCSize Polynomial>
+HM_TARGET("sse4.1,pclmul") CRCSize CRCFolding<CRCSize, Polynomial>::Update(const CRCSize crc, const uint8_t* const data, const uint64_t size)
+{
+    constexpr uint64_t P = static_cast<uint64_t>(Polynomial);
+    using FOLD_512 = FoldConstants<P, 512>;
+    using FOLD_128 = FoldConstants<P, 128>;
+    
+    const __m128i FOLD_BY_4 = _mm_set_epi64x(static_cast<int64_t>(FOLD_512::HIGH), static_cast<int64_t>(FOLD_512::LOW));
+    const __m128i FOLD_BY_1 = _mm_set_epi64x(static_cast<int64_t>(FOLD_128::HIGH), static_cast<int64_t>(FOLD_128::LOW));
+    
+    const __m128i* buffer128 = reinterpret_cast<const __m128i*>(data);
+    uint64_t bytesToProcess = size - 64;
+    
+    // The CRC register is added to the first bytes
+    __m128i x0 = _mm_xor_si128(_mm_loadu_si128(buffer128++), _mm_cvtsi64_si128(static_cast<int64_t>(crc)));
+    __m128i x1 = _mm_loadu_si128(buffer128++);
+    __m128i x2 = _mm_loadu_si128(buffer128++);
+    __m128i x3 = _mm_loadu_si128(buffer128++);
+    
+    // Four independent accumulators hide the latency of pclmulqdq
+    while(bytesToProcess >= 64)
+    {
+        x0 = Fold(x0, FOLD_BY_4, _mm_loadu_si128(buffer128++));
+        x1 = Fold(x1, FOLD_BY_4, _mm_loadu_si128(buffer128++));
+        x2 = Fold(x2, FOLD_BY_4, _mm_loadu_si128(buffer128++));
+        x3 = Fold(x3, FOLD_BY_4, _mm_loadu_si128(buffer128++));
+        
+        bytesToProcess -= 64;
+    }
+    
+    // Fold the accumulators into one
+    x0 = Fold(x0, FOLD_BY_1, x1);
+    x0 = Fold(x0, FOLD_BY_1, x2);
+    x0 = Fold(x0, FOLD_BY_1, x3);
+    
+    return static_cast<CRCSize>(FoldTailAndReduce<P>(x0, reinterpret_cast<const uint8_t*>(buffer128), bytesToProcess));
+}
+
+// The 512 bit clmul and ternary logic intrinsics inline GCC's self initialized _mm512_undefined_epi32(),
+// which gives false positive uninitialized warnings
+#if defined(HASH_PREDEF_COMP_GNUC_AVAILABLE) && !defined(HASH_PREDEF_COMP_CLANG_AVAILABLE) // GCC
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+// The same as Fold() for the four 128 bit lanes of a 512 bit vector. Uses vpternlogq for the three way XOR
+HM_TARGET("avx512f,vpclmulqdq") static inline __m512i Fold512(const __m512i x, const __m512i constants, const __m512i next)
+{
+    const __m512i low = _mm512_clmulepi64_epi128(x, constants, 0x00);
+    const __m512i high = _mm512_clmulepi64_epi128(x, constants, 0x11);
+    
+    return _mm512_ternarylogic_epi64(low, high, next, 0x96); // XOR
+}
+
+template <typename CRCSize, CRCSize Polynomial>
+HM_TARGET("avx512f,vpclmulqdq,sse4.1,pclmul") CRCSize CRCFolding<CRCSize, Polynomial>::UpdateWide(const CRCSize crc, const uint8_t* const data, const uint64_t size)
+{
+    if(size < WIDE_MIN_SIZE)
+        return Update(crc, data, size);
+    
+    constexpr uint64_t P = static_cast<uint64_t>(Polynomial);
+    using FOLD_2048 = FoldConstants<P, 2048>;
+    using FOLD_512 = FoldConstants<P, 512>;
+    using FOLD_384 = FoldConstants<P, 384>;
+    using FOLD_256 = FoldConstants<P, 256>;
+    using FOLD_128 = FoldConstants<P, 128>;
+    
+    const __m512i FOLD_BY_16 = _mm512_set_epi64(static_cast<int64_t>(FOLD_2048::HIGH), static_cast<int64_t>(FOLD_2048::LOW),
+                                                 static_cast<int64_t>(FOLD_2048::HIGH), static_cast<int64_t>(FOLD_2048::LOW),
+                                                 static_cast<int64_t>(FOLD_2048::HIGH), static_cast<int64_t>(FOLD_2048::LOW),
+                                                 static_cast<int64_t>(FOLD_2048::HIGH), static_cast<int64_t>(FOLD_2048::LOW));
+    
+    const __m512i FOLD_BY_4 = _mm512_set_epi64(static_cast<int64_t>(FOLD_512::HIGH), static_cast<int64_t>(FOLD_512::LOW),
+                                                static_cast<int64_t>(FOLD_512::HIGH), static_cast<int64_t>(FOLD_512::LOW),
+                                                static_cast<int64_t>(FOLD_512::HIGH), static_cast<int64_t>(FOLD_512::LOW),
+                                                static_cast<int64_t>(FOLD_512::HIGH), static_cast<int64_t>(FOLD_512::LOW));
+    
+    // Every lane is folded onto the last one, the last one itself is kept
+    const __m512i FOLD_LANES = _mm512_set_epi64(0, 0,
+                                                 static_cast<int64_t>(FOLD_128::HIGH), static_cast<int64_t>(FOLD_128::LOW),
+                                                 static_cast<int64_t>(FOLD_256::HIGH), static_cast<int64_t>(FOLD_256::LOW),
+                                                 static_cast<int64_t>(FOLD_384::HIGH), static_cast<int64_t>(FOLD_384::LOW));
+    
+    const uint8_t* buffer8 = data;
+    uint64_t bytesToProcess = size - 256;
+    
+    // The CRC register is added to the first bytes
+    __m512i x0 = _mm512_xor_si512(_mm512_loadu_si512(buffer8), _mm512_set_epi64(0, 0, 0, 0, 0, 0, 0, static_cast<int64_t>(crc)));
+    __m512i x1 = _mm512_loadu_si512(buffer8 + 64);
+    __m512i x2 = _mm512_loadu_si512(buffer8 + 128);
+    __m512i x3 = _mm512_loadu_si512(buffer8 + 192);
+    buffer8 += 256;
+    
+    // Four independent accumulators of 4x128 bits each
+    while(bytesToProcess >= 256)
+    {
+        x0 = Fold512(x0, FOLD_BY_16, _mm512_loadu_si512(buffer8));
+        x1 = Fold512(x1, FOLD_BY_16, _mm512_loadu_si512(buffer8 + 64));
+        x2 = Fold512(x2, FOLD_BY_16, _mm512_loadu_si512(buffer8 + 128));
+        x3 = Fold512(x3, FOLD_BY_16, _mm512_loadu_si512(buffer8 + 192));
+        
+        buffer8 += 256;
+        bytesToProcess -= 256;
+    }
+    
+    // Fold the accumulators into one
+    x0 = Fold512(x0, FOLD_BY_4, x1);
+    x0 = Fold512(x0, FOLD_BY_4, x2);
+    x0 = Fold512(x0, FOLD_BY_4, x3);
+    
+    while(bytesToProcess >= 64)
+    {
+        x0 = Fold512(x0, FOLD_BY_4, _mm512_loadu_si512(buffer8));
+        
+        buffer8 += 64;
+        bytesToProcess -= 64;
+    }
+    
+    // Fold the four lanes into 128 bits
+    const __m512i lanes = Fold512(x0, FOLD_LANES, _mm512_setzero_si512());
+    
+    __m128i x = _mm_xor_si128(_mm512_extracti32x4_epi32(lanes, 0), _mm512_extracti32x4_epi32(lanes, 1));
+    x = _mm_xor_si128(x, _mm_xor_si128(_mm512_extracti32x4_epi32(lanes, 2), _mm512_extracti32x4_epi32(x0, 3)));
+    
+    return static_cast<CRCSize>(FoldTailAndReduce<P>(x, buffer8, bytesToProcess));
+}
+
+#if defined(HASH_PREDEF_COMP_GNUC_AVAILABLE) && !defined(HASH_PREDEF_COMP_CLANG_AVAILABLE) // GCC
+#pragma GCC diagnostic pop
+#endif
+
+// ***************************************************
+// Polynomials of the CRC hashers
+template class HashMe::CRCFolding<uint16_t, 0xA001>;
+template class HashMe::CRCFolding<uint32_t, 0xEDB88320>;
+template class HashMe::CRCFolding<uint32_t, 0x82F63B78>;
+template class HashMe::CRCFolding<uint64_t, 0xC96C5795D7870F42>;
+
+#endif /* HM_SIMD_X86 */
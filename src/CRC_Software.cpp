@@ -50,8 +50,8 @@ CRCBase<CRCSize>::CRCBase(const CRCBase& other)
     : m_Polynomial(other.m_Polynomial)
     , m_FirstRemainder(other.m_FirstRemainder)
     , m_FinalXOR(other.m_FinalXOR)
+    , m_LookupTables(other.m_LookupTables)
 {
-    std::copy(other.m_LookupTable.begin(), other.m_LookupTable.end(), m_LookupTable.begin());
 }
 
 // Reflect data around the middle bit
@@ -105,9 +105,9 @@ WordSize CRCBase<CRCSize>::Reflect(WordSize data, const uint8_t numOfBits) const
 //    }
 //}
 
-// Precompute lookup table
+// Precompute lookup tables
 template <typename CRCSize>
-void CRCBase<CRCSize>::CreateLookupTable()
+void CRCBase<CRCSize>::CreateLookupTables()
 {
     CRCSize remainder;
     
@@ -125,7 +125,17 @@ void CRCBase<CRCSize>::CreateLookupTable()
         }
         
         // Write result to lookup table
-        m_LookupTable[div] = remainder;
+        m_LookupTables[0][div] = remainder;
+    }
+    
+    // Each further table feeds the result of the previous one through one more zero byte
+    for(uint32_t table = 1; table < NUM_OF_SLICES; table++)
+    {
+        for(uint16_t div = 0; div <= 255; div++)
+        {
+            const CRCSize previous = m_LookupTables[table - 1][div];
+            m_LookupTables[table][div] = static_cast<CRCSize>((previous >> 8) ^ m_LookupTables[0][previous & 0xFF]);
+        }
     }
 }
 
@@ -161,20 +171,155 @@ CRCSize CRCBase<CRCSize>::Compute(const CRCSize currentCRC, const uint8_t* const
 {
     CRCSize remainder = currentCRC ^ m_FirstRemainder;
     
-    for(uint64_t i = 0; i < size; i++)
+    const uint8_t* buffer8 = data;
+    uint64_t bytesToProcess = size;
+    
+    // Lambda for processing a single byte
+    auto ComputeByte = [this](const CRCSize crc, const uint8_t byte) -> CRCSize
+    {
+        const uint8_t lookupIndex = (crc ^ byte) & 0xFF;
+        return static_cast<CRCSize>((crc >> 8) ^ m_LookupTables[0][lookupIndex]);
+    };
+    
+    while(bytesToProcess > 0 && (reinterpret_cast<std::uintptr_t>(buffer8) & 7) > 0)
+    {
+        remainder = ComputeByte(remainder, *buffer8++);
+        bytesToProcess--;
+    }
+    
+    // Buffer is aligned now. The remainder is added to the first bytes of each 16 byte chunk,
+    // then every byte is looked up in the table for its distance to the end of the chunk
+    const std::array<std::array<CRCSize, 256>, NUM_OF_SLICES>& T = m_LookupTables;
+    
+    while(bytesToProcess >= NUM_OF_SLICES)
+    {
+#ifdef HM_LITTLE_ENDIAN
+        const uint64_t low = Utils::U8toU64<Utils::KEEP_ENDIANNESS>(buffer8) ^ remainder;
+        const uint64_t high = Utils::U8toU64<Utils::KEEP_ENDIANNESS>(buffer8 + 8);
+#else
+        const uint64_t low = Utils::U8toU64<Utils::REVERSE_ENDIANNESS>(buffer8) ^ remainder; // The reflected CRC reads the bytes as little endian
+        const uint64_t high = Utils::U8toU64<Utils::REVERSE_ENDIANNESS>(buffer8 + 8);
+#endif
+        
+        remainder = static_cast<CRCSize>(T[15][low & 0xFF] ^ T[14][(low >> 8) & 0xFF] ^ T[13][(low >> 16) & 0xFF] ^ T[12][(low >> 24) & 0xFF] ^
+                                         T[11][(low >> 32) & 0xFF] ^ T[10][(low >> 40) & 0xFF] ^ T[9][(low >> 48) & 0xFF] ^ T[8][low >> 56] ^
+                                         T[7][high & 0xFF] ^ T[6][(high >> 8) & 0xFF] ^ T[5][(high >> 16) & 0xFF] ^ T[4][(high >> 24) & 0xFF] ^
+                                         T[3][(high >> 32) & 0xFF] ^ T[2][(high >> 40) & 0xFF] ^ T[1][(high >> 48) & 0xFF] ^ T[0][high >> 56]);
+        
+        buffer8 += NUM_OF_SLICES;
+        bytesToProcess -= NUM_OF_SLICES;
+    }
+    
+    while(bytesToProcess > 0)
     {
-        const uint8_t lookupIndex = (remainder ^ data[i]) & 0xFF;
-        remainder = (remainder >> 8) ^ m_LookupTable[lookupIndex];
+        remainder = ComputeByte(remainder, *buffer8++);
+        bytesToProcess--;
     }
     
     return remainder ^ m_FinalXOR;
 }
 
+// Multiplies a and b modulo the polynomial. All of them are bit reflected, x^0 is the highest bit
+template <typename CRCSize>
+constexpr CRCSize CRCBase<CRCSize>::MultiplyModP(const CRCSize polynomial, const CRCSize a, CRCSize b)
+{
+    CRCSize product = 0;
+    
+    for(CRCSize mask = static_cast<CRCSize>(CRCSize(1) << (8 * sizeof(CRCSize) - 1)); mask > 0; mask = static_cast<CRCSize>(mask >> 1))
+    {
+        if(a & mask)
+            product ^= b;
+        
+        b = (b & 0x01) ? static_cast<CRCSize>((b >> 1) ^ polynomial) : static_cast<CRCSize>(b >> 1);
+    }
+    
+    return product;
+}
+
+// x^(8 * 2^k) modulo the polynomial for k = 0 to 63, multiplying by it shifts a CRC over 2^k zero bytes
+template <typename CRCSize>
+constexpr std::array<CRCSize, 64> CRCBase<CRCSize>::CreatePowerTable(const CRCSize polynomial)
+{
+    std::array<CRCSize, 64> powers{};
+    
+    // x^8, starting with x^0
+    CRCSize power = static_cast<CRCSize>(CRCSize(1) << (8 * sizeof(CRCSize) - 1));
+    for(uint8_t bit = 8; bit > 0; bit--)
+        power = (power & 0x01) ? static_cast<CRCSize>((power >> 1) ^ polynomial) : static_cast<CRCSize>(power >> 1);
+    
+    powers[0] = power;
+    
+    for(uint32_t k = 1; k < 64; k++)
+        powers[k] = MultiplyModP(polynomial, powers[k - 1], powers[k - 1]);
+    
+    return powers;
+}
+
+// Combine the CRCs of two consecutive messages A and B. The register after A is shifted over the length of B
+// and added to the CRC of B. The first remainder is shifted along in crcB and the final XOR is added twice,
+// both have to be removed from crcA first
+template <typename CRCSize>
+template <CRCSize Polynomial, CRCSize FirstRemainder, CRCSize FinalXOR>
+CRCSize CRCBase<CRCSize>::Combine(const CRCSize crcA, const CRCSize crcB, const uint64_t lengthB)
+{
+    static constexpr std::array<CRCSize, 64> POWERS = CreatePowerTable(Polynomial);
+    
+    CRCSize crc = crcA ^ FirstRemainder ^ FinalXOR;
+    
+    // One multiplication per set bit of the length
+    uint64_t length = lengthB;
+    for(uint32_t k = 0; length > 0; k++, length >>= 1)
+    {
+        if(length & 0x01)
+            crc = MultiplyModP(Polynomial, POWERS[k], crc);
+    }
+    
+    return crc ^ crcB;
+}
+
+template <typename CRCSize>
+CRCSize CRCBase<CRCSize>::ComputeRange(const CRCSize currentCRC, const uint8_t* const data, const uint64_t size)
+{
+    return Compute(currentCRC, data, size);
+}
+
+template <typename CRCSize>
+CRCSize CRCBase<CRCSize>::ComputeParallel(ThreadPool& threadPool, const CRCSize currentCRC, const uint8_t* const data, const uint64_t size,
+                                          const CombineFunction combine)
+{
+    if(!data)
+        throw std::invalid_argument("Data cannot be nullptr.");
+    
+    // A few ranges per thread balance the load. Ranges are multiples of 4 KiB, the last one may be shorter
+    const uint64_t numOfThreads = threadPool.GetNumOfThreads() + 1;
+    const uint64_t maxNumOfRanges = std::clamp<uint64_t>(size / PARALLEL_MIN_RANGE_LENGTH, 1, 4 * numOfThreads);
+    const uint64_t rangeLength = ((size + maxNumOfRanges - 1) / maxNumOfRanges + 4095) & ~4095ULL;
+    const uint64_t numOfRanges = (size + rangeLength - 1) / rangeLength;
+    
+    std::vector<CRCSize> crcs(numOfRanges);
+    threadPool.ParallelFor(numOfRanges, [this, currentCRC, data, size, rangeLength, &crcs](const uint64_t range)
+    {
+        const uint64_t offset = range * rangeLength;
+        
+        // Every range but the first one is a new message
+        crcs[range] = ComputeRange(range == 0 ? currentCRC : 0, data + offset, std::min(rangeLength, size - offset));
+    });
+    
+    CRCSize crc = crcs[0];
+    for(uint64_t range = 1; range < numOfRanges; range++)
+    {
+        const uint64_t offset = range * rangeLength;
+        crc = combine(crc, crcs[range], std::min(rangeLength, size - offset));
+    }
+    
+    return crc;
+}
+
 // ***************************************************
 // Hasher class for CRC16
 Hasher<CRC16, SOFTWARE>::Hasher() : CRCBase<uint16_t>(0xA001, 0x0000, 0x0000)
 {
-    CreateLookupTable();
+    CreateLookupTables();
 }
 
 Hasher<CRC16, SOFTWARE>::Hasher(const Hasher& other) : CRCBase<uint16_t>(other)
@@ -201,6 +346,20 @@ void Hasher<CRC16, SOFTWARE>::Update(const std::string& str)
     Update(reinterpret_cast<const uint8_t*>(str.data()), str.size());
 }
 
+void Hasher<CRC16, SOFTWARE>::Update(ThreadPool& threadPool, const uint8_t* const data, const uint64_t size)
+{
+    // Short buffers are not worth waking up the workers
+    if(size < 2 * PARALLEL_MIN_RANGE_LENGTH)
+        Update(data, size);
+    else
+        m_CRC16Result = ComputeParallel(threadPool, m_CRC16Result, data, size, Combine);
+}
+
+void Hasher<CRC16, SOFTWARE>::Update(ThreadPool& threadPool, const std::vector<uint8_t>& data)
+{
+    Update(threadPool, data.data(), data.size());
+}
+
 std::vector<uint8_t> Hasher<CRC16, SOFTWARE>::End()
 {
     std::vector<uint8_t> result(2);
@@ -214,11 +373,16 @@ uint16_t Hasher<CRC16, SOFTWARE>::End_GetAsInteger16()
     return m_CRC16Result;
 }
 
+uint16_t Hasher<CRC16, SOFTWARE>::Combine(const uint16_t crcA, const uint16_t crcB, const uint64_t lengthB)
+{
+    return CRCBase<uint16_t>::Combine<0xA001, 0x0000, 0x0000>(crcA, crcB, lengthB);
+}
+
 // ***************************************************
 // Hasher class for CRC32
 Hasher<CRC32, SOFTWARE>::Hasher() : CRCBase<uint32_t>(0xEDB88320, 0xFFFFFFFF, 0xFFFFFFFF)
 {
-    CreateLookupTable();
+    CreateLookupTables();
 }
 
 Hasher<CRC32, SOFTWARE>::Hasher(const Hasher& other) : CRCBase<uint32_t>(other)
@@ -245,6 +409,20 @@ void Hasher<CRC32, SOFTWARE>::Update(const std::string& str)
     Update(reinterpret_cast<const uint8_t*>(str.data()), str.size());
 }
 
+void Hasher<CRC32, SOFTWARE>::Update(ThreadPool& threadPool, const uint8_t* const data, const uint64_t size)
+{
+    // Short buffers are not worth waking up the workers
+    if(size < 2 * PARALLEL_MIN_RANGE_LENGTH)
+        Update(data, size);
+    else
+        m_CRC32Result = ComputeParallel(threadPool, m_CRC32Result, data, size, Combine);
+}
+
+void Hasher<CRC32, SOFTWARE>::Update(ThreadPool& threadPool, const std::vector<uint8_t>& data)
+{
+    Update(threadPool, data.data(), data.size());
+}
+
 std::vector<uint8_t> Hasher<CRC32, SOFTWARE>::End()
 {
     std::vector<uint8_t> result(4);
@@ -258,11 +436,79 @@ uint32_t Hasher<CRC32, SOFTWARE>::End_GetAsInteger32()
     return m_CRC32Result;
 }
 
+uint32_t Hasher<CRC32, SOFTWARE>::Combine(const uint32_t crcA, const uint32_t crcB, const uint64_t lengthB)
+{
+    return CRCBase<uint32_t>::Combine<0xEDB88320, 0xFFFFFFFF, 0xFFFFFFFF>(crcA, crcB, lengthB);
+}
+
+// ***************************************************
+// Hasher class for CRC32C (Castagnoli)
+Hasher<CRC32C, SOFTWARE>::Hasher() : CRCBase<uint32_t>(0x82F63B78, 0xFFFFFFFF, 0xFFFFFFFF)
+{
+    CreateLookupTables();
+}
+
+Hasher<CRC32C, SOFTWARE>::Hasher(const Hasher& other) : CRCBase<uint32_t>(other)
+{
+}
+
+void Hasher<CRC32C, SOFTWARE>::Reset()
+{
+    m_CRC32CResult = 0;
+}
+
+void Hasher<CRC32C, SOFTWARE>::Update(const uint8_t* const data, const uint64_t size)
+{
+    m_CRC32CResult = Compute(m_CRC32CResult, data, size);
+}
+
+void Hasher<CRC32C, SOFTWARE>::Update(const std::vector<uint8_t>& data)
+{
+    Update(data.data(), data.size());
+}
+
+void Hasher<CRC32C, SOFTWARE>::Update(const std::string& str)
+{
+    Update(reinterpret_cast<const uint8_t*>(str.data()), str.size());
+}
+
+void Hasher<CRC32C, SOFTWARE>::Update(ThreadPool& threadPool, const uint8_t* const data, const uint64_t size)
+{
+    // Short buffers are not worth waking up the workers
+    if(size < 2 * PARALLEL_MIN_RANGE_LENGTH)
+        Update(data, size);
+    else
+        m_CRC32CResult = ComputeParallel(threadPool, m_CRC32CResult, data, size, Combine);
+}
+
+void Hasher<CRC32C, SOFTWARE>::Update(ThreadPool& threadPool, const std::vector<uint8_t>& data)
+{
+    Update(threadPool, data.data(), data.size());
+}
+
+std::vector<uint8_t> Hasher<CRC32C, SOFTWARE>::End()
+{
+    std::vector<uint8_t> result(4);
+    Utils::U32toU8<Utils::REVERSE_ENDIANNESS>(m_CRC32CResult, &result[0]);
+    
+    return result;
+}
+
+uint32_t Hasher<CRC32C, SOFTWARE>::End_GetAsInteger32()
+{
+    return m_CRC32CResult;
+}
+
+uint32_t Hasher<CRC32C, SOFTWARE>::Combine(const uint32_t crcA, const uint32_t crcB, const uint64_t lengthB)
+{
+    return CRCBase<uint32_t>::Combine<0x82F63B78, 0xFFFFFFFF, 0xFFFFFFFF>(crcA, crcB, lengthB);
+}
+
 // ***************************************************
 // Hasher class for CRC64 (ECMA)
 Hasher<CRC64, SOFTWARE>::Hasher() : CRCBase<uint64_t>(0xC96C5795D7870F42, 0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF)
 {
-    CreateLookupTable();
+    CreateLookupTables();
 }
 
 Hasher<CRC64, SOFTWARE>::Hasher(const Hasher& other) : CRCBase<uint64_t>(other)
@@ -289,6 +535,20 @@ void Hasher<CRC64, SOFTWARE>::Update(const std::string& str)
     Update(reinterpret_cast<const uint8_t*>(str.data()), str.size());
 }
 
+void Hasher<CRC64, SOFTWARE>::Update(ThreadPool& threadPool, const uint8_t* const data, const uint64_t size)
+{
+    // Short buffers are not worth waking up the workers
+    if(size < 2 * PARALLEL_MIN_RANGE_LENGTH)
+        Update(data, size);
+    else
+        m_CRC64Result = ComputeParallel(threadPool, m_CRC64Result, data, size, Combine);
+}
+
+void Hasher<CRC64, SOFTWARE>::Update(ThreadPool& threadPool, const std::vector<uint8_t>& data)
+{
+    Update(threadPool, data.data(), data.size());
+}
+
 std::vector<uint8_t> Hasher<CRC64, SOFTWARE>::End()
 {
     std::vector<uint8_t> result(8);
@@ -301,3 +561,8 @@ uint64_t Hasher<CRC64, SOFTWARE>::End_GetAsInteger64()
 {
     return m_CRC64Result;
 }
+
+uint64_t Hasher<CRC64, SOFTWARE>::Combine(const uint64_t crcA, const uint64_t crcB, const uint64_t lengthB)
+{
+    return CRCBase<uint64_t>::Combine<0xC96C5795D7870F42, 0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF>(crcA, crcB, lengthB);
+}
@@ -35,28 +35,6 @@ the following restrictions:
 
 using namespace HashMe;
 
-// ***************************************************
-// MD5 transform constants
-inline static constexpr uint32_t S11 = 7;
-inline static constexpr uint32_t S12 = 12;
-inline static constexpr uint32_t S13 = 17;
-inline static constexpr uint32_t S14 = 22;
-
-inline static constexpr uint32_t S21 = 5;
-inline static constexpr uint32_t S22 = 9;
-inline static constexpr uint32_t S23 = 14;
-inline static constexpr uint32_t S24 = 20;
-
-inline static constexpr uint32_t S31 = 4;
-inline static constexpr uint32_t S32 = 11;
-inline static constexpr uint32_t S33 = 16;
-inline static constexpr uint32_t S34 = 23;
-
-inline static constexpr uint32_t S41 = 6;
-inline static constexpr uint32_t S42 = 10;
-inline static constexpr uint32_t S43 = 15;
-inline static constexpr uint32_t S44 = 21;
-
 // ***************************************************
 // Basic MD5 functions. Inline is implied by constexpr, but we leave it for convenience
 inline static constexpr uint32_t F(const uint32_t x, const uint32_t y, const uint32_t z) { return (x & y) | (~x & z); }
@@ -100,157 +78,140 @@ Hasher<MD5, SOFTWARE>::Hasher(const Hasher& other)
 {
     m_Context = std::make_unique<Context>();
     
-    std::copy(other.m_Context->count, other.m_Context->count + 2, m_Context->count);
-    std::copy(other.m_Context->state, other.m_Context->state + 4, m_Context->state);
-    std::copy(other.m_Context->buffer, other.m_Context->buffer + MD5_BLOCK_LENGTH, m_Context->buffer);
+    *m_Context = *other.m_Context;
 }
 
 void Hasher<MD5, SOFTWARE>::Initialize()
 {
-    // Set state to initial hash values
-    std::copy(INITIAL_HASH_VALUES.begin(), INITIAL_HASH_VALUES.end(), m_Context->state);
+    InitializeContext(*m_Context, INITIAL_HASH_VALUES);
 }
 
 void Hasher<MD5, SOFTWARE>::Reset()
 {
     Initialize();
     
-    m_Context->count[0] = 0;
-    m_Context->count[1] = 0;
-    
     // Zero out buffer
     std::memset(m_Context->buffer, 0, MD5_BLOCK_LENGTH);
 }
 
-void Hasher<MD5, SOFTWARE>::Transform(const uint8_t block[MD5_BLOCK_LENGTH])
+// Transform function for multiple consecutive blocks. The state is kept in local variables for the whole run
+void Hasher<MD5, SOFTWARE>::TransformBlocks(uint32_t* const stateOut, const uint8_t* data, uint64_t numOfBlocks)
 {
     uint32_t x[16];
-    uint32_t a = m_Context->state[0];
-    uint32_t b = m_Context->state[1];
-    uint32_t c = m_Context->state[2];
-    uint32_t d = m_Context->state[3];
     
-    for(uint32_t i = 0; i < (MD5_BLOCK_LENGTH >> 2); i++)
-        x[i] = Utils::U8toU32<Utils::KEEP_ENDIANNESS>(&block[(i << 2)]);
+    uint32_t state[4];
+    std::copy(stateOut, stateOut + 4, state);
     
-    // Round 1
-    FF (a, b, c, d, x[ 0], S11, 0xd76aa478); /* 1 */
-    FF (d, a, b, c, x[ 1], S12, 0xe8c7b756); /* 2 */
-    FF (c, d, a, b, x[ 2], S13, 0x242070db); /* 3 */
-    FF (b, c, d, a, x[ 3], S14, 0xc1bdceee); /* 4 */
-    FF (a, b, c, d, x[ 4], S11, 0xf57c0faf); /* 5 */
-    FF (d, a, b, c, x[ 5], S12, 0x4787c62a); /* 6 */
-    FF (c, d, a, b, x[ 6], S13, 0xa8304613); /* 7 */
-    FF (b, c, d, a, x[ 7], S14, 0xfd469501); /* 8 */
-    FF (a, b, c, d, x[ 8], S11, 0x698098d8); /* 9 */
-    FF (d, a, b, c, x[ 9], S12, 0x8b44f7af); /* 10 */
-    FF (c, d, a, b, x[10], S13, 0xffff5bb1); /* 11 */
-    FF (b, c, d, a, x[11], S14, 0x895cd7be); /* 12 */
-    FF (a, b, c, d, x[12], S11, 0x6b901122); /* 13 */
-    FF (d, a, b, c, x[13], S12, 0xfd987193); /* 14 */
-    FF (c, d, a, b, x[14], S13, 0xa679438e); /* 15 */
-    FF (b, c, d, a, x[15], S14, 0x49b40821); /* 16 */
-   
-    // Round 2
-    GG (a, b, c, d, x[ 1], S21, 0xf61e2562); /* 17 */
-    GG (d, a, b, c, x[ 6], S22, 0xc040b340); /* 18 */
-    GG (c, d, a, b, x[11], S23, 0x265e5a51); /* 19 */
-    GG (b, c, d, a, x[ 0], S24, 0xe9b6c7aa); /* 20 */
-    GG (a, b, c, d, x[ 5], S21, 0xd62f105d); /* 21 */
-    GG (d, a, b, c, x[10], S22,  0x2441453); /* 22 */
-    GG (c, d, a, b, x[15], S23, 0xd8a1e681); /* 23 */
-    GG (b, c, d, a, x[ 4], S24, 0xe7d3fbc8); /* 24 */
-    GG (a, b, c, d, x[ 9], S21, 0x21e1cde6); /* 25 */
-    GG (d, a, b, c, x[14], S22, 0xc33707d6); /* 26 */
-    GG (c, d, a, b, x[ 3], S23, 0xf4d50d87); /* 27 */
-    GG (b, c, d, a, x[ 8], S24, 0x455a14ed); /* 28 */
-    GG (a, b, c, d, x[13], S21, 0xa9e3e905); /* 29 */
-    GG (d, a, b, c, x[ 2], S22, 0xfcefa3f8); /* 30 */
-    GG (c, d, a, b, x[ 7], S23, 0x676f02d9); /* 31 */
-    GG (b, c, d, a, x[12], S24, 0x8d2a4c8a); /* 32 */
-   
-    // Round 3
-    HH (a, b, c, d, x[ 5], S31, 0xfffa3942); /* 33 */
-    HH (d, a, b, c, x[ 8], S32, 0x8771f681); /* 34 */
-    HH (c, d, a, b, x[11], S33, 0x6d9d6122); /* 35 */
-    HH (b, c, d, a, x[14], S34, 0xfde5380c); /* 36 */
-    HH (a, b, c, d, x[ 1], S31, 0xa4beea44); /* 37 */
-    HH (d, a, b, c, x[ 4], S32, 0x4bdecfa9); /* 38 */
-    HH (c, d, a, b, x[ 7], S33, 0xf6bb4b60); /* 39 */
-    HH (b, c, d, a, x[10], S34, 0xbebfbc70); /* 40 */
-    HH (a, b, c, d, x[13], S31, 0x289b7ec6); /* 41 */
-    HH (d, a, b, c, x[ 0], S32, 0xeaa127fa); /* 42 */
-    HH (c, d, a, b, x[ 3], S33, 0xd4ef3085); /* 43 */
-    HH (b, c, d, a, x[ 6], S34,  0x4881d05); /* 44 */
-    HH (a, b, c, d, x[ 9], S31, 0xd9d4d039); /* 45 */
-    HH (d, a, b, c, x[12], S32, 0xe6db99e5); /* 46 */
-    HH (c, d, a, b, x[15], S33, 0x1fa27cf8); /* 47 */
-    HH (b, c, d, a, x[ 2], S34, 0xc4ac5665); /* 48 */
-   
-    // Round 4
-    II (a, b, c, d, x[ 0], S41, 0xf4292244); /* 49 */
-    II (d, a, b, c, x[ 7], S42, 0x432aff97); /* 50 */
-    II (c, d, a, b, x[14], S43, 0xab9423a7); /* 51 */
-    II (b, c, d, a, x[ 5], S44, 0xfc93a039); /* 52 */
-    II (a, b, c, d, x[12], S41, 0x655b59c3); /* 53 */
-    II (d, a, b, c, x[ 3], S42, 0x8f0ccc92); /* 54 */
-    II (c, d, a, b, x[10], S43, 0xffeff47d); /* 55 */
-    II (b, c, d, a, x[ 1], S44, 0x85845dd1); /* 56 */
-    II (a, b, c, d, x[ 8], S41, 0x6fa87e4f); /* 57 */
-    II (d, a, b, c, x[15], S42, 0xfe2ce6e0); /* 58 */
-    II (c, d, a, b, x[ 6], S43, 0xa3014314); /* 59 */
-    II (b, c, d, a, x[13], S44, 0x4e0811a1); /* 60 */
-    II (a, b, c, d, x[ 4], S41, 0xf7537e82); /* 61 */
-    II (d, a, b, c, x[11], S42, 0xbd3af235); /* 62 */
-    II (c, d, a, b, x[ 2], S43, 0x2ad7d2bb); /* 63 */
-    II (b, c, d, a, x[ 9], S44, 0xeb86d391); /* 64 */
+    for(uint64_t n = 0; n < numOfBlocks; n++)
+    {
+        const uint8_t* const block = data + n * MD5_BLOCK_LENGTH;
+        
+        uint32_t a = state[0];
+        uint32_t b = state[1];
+        uint32_t c = state[2];
+        uint32_t d = state[3];
+        
+        for(uint32_t i = 0; i < (MD5_BLOCK_LENGTH >> 2); i++)
+        {
+#ifdef HM_LITTLE_ENDIAN
+            x[i] = Utils::U8toU32<Utils::KEEP_ENDIANNESS>(&block[(i << 2)]);
+#else
+            x[i] = Utils::U8toU32<Utils::REVERSE_ENDIANNESS>(&block[(i << 2)]); // MD5 is little endian
+#endif
+        }
+        
+        // Round 1
+        FF (a, b, c, d, x[ 0], S[ 0], K[ 0]); /* 1 */
+        FF (d, a, b, c, x[ 1], S[ 1], K[ 1]); /* 2 */
+        FF (c, d, a, b, x[ 2], S[ 2], K[ 2]); /* 3 */
+        FF (b, c, d, a, x[ 3], S[ 3], K[ 3]); /* 4 */
+        FF (a, b, c, d, x[ 4], S[ 0], K[ 4]); /* 5 */
+        FF (d, a, b, c, x[ 5], S[ 1], K[ 5]); /* 6 */
+        FF (c, d, a, b, x[ 6], S[ 2], K[ 6]); /* 7 */
+        FF (b, c, d, a, x[ 7], S[ 3], K[ 7]); /* 8 */
+        FF (a, b, c, d, x[ 8], S[ 0], K[ 8]); /* 9 */
+        FF (d, a, b, c, x[ 9], S[ 1], K[ 9]); /* 10 */
+        FF (c, d, a, b, x[10], S[ 2], K[10]); /* 11 */
+        FF (b, c, d, a, x[11], S[ 3], K[11]); /* 12 */
+        FF (a, b, c, d, x[12], S[ 0], K[12]); /* 13 */
+        FF (d, a, b, c, x[13], S[ 1], K[13]); /* 14 */
+        FF (c, d, a, b, x[14], S[ 2], K[14]); /* 15 */
+        FF (b, c, d, a, x[15], S[ 3], K[15]); /* 16 */
+        
+        // Round 2
+        GG (a, b, c, d, x[ 1], S[ 4], K[16]); /* 17 */
+        GG (d, a, b, c, x[ 6], S[ 5], K[17]); /* 18 */
+        GG (c, d, a, b, x[11], S[ 6], K[18]); /* 19 */
+        GG (b, c, d, a, x[ 0], S[ 7], K[19]); /* 20 */
+        GG (a, b, c, d, x[ 5], S[ 4], K[20]); /* 21 */
+        GG (d, a, b, c, x[10], S[ 5], K[21]); /* 22 */
+        GG (c, d, a, b, x[15], S[ 6], K[22]); /* 23 */
+        GG (b, c, d, a, x[ 4], S[ 7], K[23]); /* 24 */
+        GG (a, b, c, d, x[ 9], S[ 4], K[24]); /* 25 */
+        GG (d, a, b, c, x[14], S[ 5], K[25]); /* 26 */
+        GG (c, d, a, b, x[ 3], S[ 6], K[26]); /* 27 */
+        GG (b, c, d, a, x[ 8], S[ 7], K[27]); /* 28 */
+        GG (a, b, c, d, x[13], S[ 4], K[28]); /* 29 */
+        GG (d, a, b, c, x[ 2], S[ 5], K[29]); /* 30 */
+        GG (c, d, a, b, x[ 7], S[ 6], K[30]); /* 31 */
+        GG (b, c, d, a, x[12], S[ 7], K[31]); /* 32 */
+        
+        // Round 3
+        HH (a, b, c, d, x[ 5], S[ 8], K[32]); /* 33 */
+        HH (d, a, b, c, x[ 8], S[ 9], K[33]); /* 34 */
+        HH (c, d, a, b, x[11], S[10], K[34]); /* 35 */
+        HH (b, c, d, a, x[14], S[11], K[35]); /* 36 */
+        HH (a, b, c, d, x[ 1], S[ 8], K[36]); /* 37 */
+        HH (d, a, b, c, x[ 4], S[ 9], K[37]); /* 38 */
+        HH (c, d, a, b, x[ 7], S[10], K[38]); /* 39 */
+        HH (b, c, d, a, x[10], S[11], K[39]); /* 40 */
+        HH (a, b, c, d, x[13], S[ 8], K[40]); /* 41 */
+        HH (d, a, b, c, x[ 0], S[ 9], K[41]); /* 42 */
+        HH (c, d, a, b, x[ 3], S[10], K[42]); /* 43 */
+        HH (b, c, d, a, x[ 6], S[11], K[43]); /* 44 */
+        HH (a, b, c, d, x[ 9], S[ 8], K[44]); /* 45 */
+        HH (d, a, b, c, x[12], S[ 9], K[45]); /* 46 */
+        HH (c, d, a, b, x[15], S[10], K[46]); /* 47 */
+        HH (b, c, d, a, x[ 2], S[11], K[47]); /* 48 */
+        
+        // Round 4
+        II (a, b, c, d, x[ 0], S[12], K[48]); /* 49 */
+        II (d, a, b, c, x[ 7], S[13], K[49]); /* 50 */
+        II (c, d, a, b, x[14], S[14], K[50]); /* 51 */
+        II (b, c, d, a, x[ 5], S[15], K[51]); /* 52 */
+        II (a, b, c, d, x[12], S[12], K[52]); /* 53 */
+        II (d, a, b, c, x[ 3], S[13], K[53]); /* 54 */
+        II (c, d, a, b, x[10], S[14], K[54]); /* 55 */
+        II (b, c, d, a, x[ 1], S[15], K[55]); /* 56 */
+        II (a, b, c, d, x[ 8], S[12], K[56]); /* 57 */
+        II (d, a, b, c, x[15], S[13], K[57]); /* 58 */
+        II (c, d, a, b, x[ 6], S[14], K[58]); /* 59 */
+        II (b, c, d, a, x[13], S[15], K[59]); /* 60 */
+        II (a, b, c, d, x[ 4], S[12], K[60]); /* 61 */
+        II (d, a, b, c, x[11], S[13], K[61]); /* 62 */
+        II (c, d, a, b, x[ 2], S[14], K[62]); /* 63 */
+        II (b, c, d, a, x[ 9], S[15], K[63]); /* 64 */
+        
+        // Update state
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+    }
     
-    // Update state
-    m_Context->state[0] += a;
-    m_Context->state[1] += b;
-    m_Context->state[2] += c;
-    m_Context->state[3] += d;
+    // Write back the state once at the end of the run
+    std::copy(state, state + 4, stateOut);
     
     // Cleanup sensitive data for security
 #ifdef HM_CLEANUP_TMP_MEMORY_AFTER_HASHING_FOR_SECURITY
-    std::memset(x, 0, MD5_BLOCK_LENGTH);
+    std::memset(x, 0, sizeof(x));
+    std::memset(state, 0, sizeof(state));
 #endif
 }
 
 void Hasher<MD5, SOFTWARE>::Update(const uint8_t* const data, const uint64_t size)
 {
-    if(!data)
-        throw std::invalid_argument("Data cannot be nullptr.");
-    
-    if(size == 0)
-        throw std::invalid_argument("Data size cannot be zero.");
-    
-    uint32_t index = (m_Context->count[0] >> 3) & (MD5_BLOCK_LENGTH - 1); // mod MD5_BLOCK_LENGTH
-    const uint32_t partialBlockSize = MD5_BLOCK_LENGTH - index;
-    
-    m_Context->count[0] += static_cast<uint32_t>(size << 3);
-    m_Context->count[1] += static_cast<uint32_t>(size >> 29);
-    
-    if (m_Context->count[0] < (size << 3))
-        m_Context->count[1]++;
-    
-    uint64_t i = 0;
-    
-    // Transform as often as possible
-    if(size >= partialBlockSize)
-    {
-        std::memcpy(&m_Context->buffer[index], data, partialBlockSize);
-        
-        Transform(m_Context->buffer);
-        
-        for(i = partialBlockSize; i + MD5_BLOCK_LENGTH <= size; i += MD5_BLOCK_LENGTH)
-            Transform(&data[i]);
-        
-        index = 0;
-    }
-    
-    // Remaining input data
-    std::memcpy(&m_Context->buffer[index], &data[i], size - i);
+    Absorb(*m_Context, TransformBlocks, data, size);
 }
 
 void Hasher<MD5, SOFTWARE>::Update(const std::vector<uint8_t>& data)
@@ -265,28 +226,13 @@ void Hasher<MD5, SOFTWARE>::Update(const std::string& str)
 
 std::vector<uint8_t> Hasher<MD5, SOFTWARE>::End()
 {
-    // Number of bits
-    uint8_t numOfBits[8];
-    Utils::U32toU8<Utils::KEEP_ENDIANNESS>(m_Context->count[0], &numOfBits[0]);
-    Utils::U32toU8<Utils::KEEP_ENDIANNESS>(m_Context->count[1], &numOfBits[4]);
-    
-    uint32_t index = (m_Context->count[0] >> 3) & 0x3F; // Modulo 64
-    uint32_t paddingSize = (index < 56) ? (56 - index) : (120 - index);
-    
-    Update(PADDING.data(), paddingSize);
-    
-    // Append size before padding
-    Update(numOfBits, 8);
-    
-    // Assemble hash
     std::vector<uint8_t> hash(16); // 128 bit hash
-    for(uint8_t i = 0; i < 4; i++)
-        Utils::U32toU8<Utils::KEEP_ENDIANNESS>(m_Context->state[i], &hash.data()[(i << 2)]);
-    
-    // Cleanup sensitive data for security
-#ifdef HM_CLEANUP_TMP_MEMORY_AFTER_HASHING_FOR_SECURITY
-    std::memset(m_Context, 0, sizeof(Context));
-#endif
+    Finalize(*m_Context, TransformBlocks, hash.data(), 16);
     
     return hash;
 }
+
+void Hasher<MD5, SOFTWARE>::HashShort(const uint8_t* const data, const uint64_t size, uint8_t* const digest)
+{
+    HashSingleBlock(TransformBlocks, INITIAL_HASH_VALUES, data, size, digest, 16);
+}
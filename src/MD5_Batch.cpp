@@ -0,0 +1,592 @@
+/*
+    The zlib License
+
+    Copyright (C) 2024 Marc Schöndorf
+ 
+This software is provided 'as-is', without any express or implied warranty. In
+no event will the authors be held liable for any damages arising from the use of
+this software.
+
+Permission is granted to anyone to use this software for any purpose, including
+commercial applications, and to alter it and redistribute it freely, subject to
+the following restrictions:
+
+1.  The origin of this software must not be misrepresented; you must not claim
+    that you wrote the original software. If you use this software in a product,
+    an acknowledgment in the product documentation would be appreciated but is
+    not required.
+
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+
+3.  This notice may not be removed or altered from any source distribution.
+*/
+
+
+/*------------------------------------------------------------------*/
+/*                                                                  */
+/*                      (C) 2024 Marc Schöndorf                     */
+/*                            See license                           */
+/*                                                                  */
+/*  MD5_Batch.cpp                                                   */
+/*  Created: 16.10.2026                                             */
+/*------------------------------------------------------------------*/
+
+
+#include "HashMe.hpp"
+
+using namespace HashMe;
+
+#if defined(HM_SIMD_X86)
+// ***************************************************
+// AVX2 helpers, every vector holds the same word of 8 different messages. The steps mirror FF, GG, HH and II
+// of the scalar hasher
+template <uint32_t N>
+HM_TARGET("avx2") static inline __m256i Rotl32x8(const __m256i x)
+{
+    return _mm256_or_si256(_mm256_slli_epi32(x, N), _mm256_srli_epi32(x, 32 - N));
+}
+
+// a = rotl(a + f + x + ac, s) + b, where xk already holds x + ac
+template <uint32_t S>
+HM_TARGET("avx2") static inline void Stepx8(__m256i& a, const __m256i b, const __m256i f, const __m256i xk)
+{
+    a = _mm256_add_epi32(Rotl32x8<S>(_mm256_add_epi32(_mm256_add_epi32(a, f), xk)), b);
+}
+
+template <uint32_t S>
+HM_TARGET("avx2") static inline void FFx8(__m256i& a, const __m256i b, const __m256i c, const __m256i d, const __m256i x, const uint32_t ac)
+{
+    const __m256i f = _mm256_xor_si256(d, _mm256_and_si256(b, _mm256_xor_si256(c, d))); // (b & c) | (~b & d)
+    Stepx8<S>(a, b, f, _mm256_add_epi32(x, _mm256_set1_epi32(static_cast<int32_t>(ac))));
+}
+
+template <uint32_t S>
+HM_TARGET("avx2") static inline void GGx8(__m256i& a, const __m256i b, const __m256i c, const __m256i d, const __m256i x, const uint32_t ac)
+{
+    const __m256i g = _mm256_xor_si256(c, _mm256_and_si256(d, _mm256_xor_si256(b, c))); // (b & d) | (c & ~d)
+    Stepx8<S>(a, b, g, _mm256_add_epi32(x, _mm256_set1_epi32(static_cast<int32_t>(ac))));
+}
+
+template <uint32_t S>
+HM_TARGET("avx2") static inline void HHx8(__m256i& a, const __m256i b, const __m256i c, const __m256i d, const __m256i x, const uint32_t ac)
+{
+    const __m256i h = _mm256_xor_si256(_mm256_xor_si256(b, c), d);
+    Stepx8<S>(a, b, h, _mm256_add_epi32(x, _mm256_set1_epi32(static_cast<int32_t>(ac))));
+}
+
+template <uint32_t S>
+HM_TARGET("avx2") static inline void IIx8(__m256i& a, const __m256i b, const __m256i c, const __m256i d, const __m256i x, const uint32_t ac)
+{
+    const __m256i i = _mm256_xor_si256(c, _mm256_or_si256(b, _mm256_xor_si256(d, _mm256_set1_epi32(-1)))); // c ^ (b | ~d)
+    Stepx8<S>(a, b, i, _mm256_add_epi32(x, _mm256_set1_epi32(static_cast<int32_t>(ac))));
+}
+
+// Loads 32 bytes from each of the 8 lanes and transposes them, so that out[i] holds word i of all lanes.
+// MD5 is little endian, so the words are used as loaded
+HM_TARGET("avx2") static inline void LoadTransposed8x8(const uint8_t* const* const data, const uint64_t offset, __m256i out[8])
+{
+    __m256i rows[8];
+    for(uint32_t i = 0; i < 8; i++)
+        rows[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data[i] + offset));
+    
+    const __m256i t0 = _mm256_unpacklo_epi32(rows[0], rows[1]);
+    const __m256i t1 = _mm256_unpackhi_epi32(rows[0], rows[1]);
+    const __m256i t2 = _mm256_unpacklo_epi32(rows[2], rows[3]);
+    const __m256i t3 = _mm256_unpackhi_epi32(rows[2], rows[3]);
+    const __m256i t4 = _mm256_unpacklo_epi32(rows[4], rows[5]);
+    const __m256i t5 = _mm256_unpackhi_epi32(rows[4], rows[5]);
+    const __m256i t6 = _mm256_unpacklo_epi32(rows[6], rows[7]);
+    const __m256i t7 = _mm256_unpackhi_epi32(rows[6], rows[7]);
+    
+    const __m256i u0 = _mm256_unpacklo_epi64(t0, t2);
+    const __m256i u1 = _mm256_unpackhi_epi64(t0, t2);
+    const __m256i u2 = _mm256_unpacklo_epi64(t1, t3);
+    const __m256i u3 = _mm256_unpackhi_epi64(t1, t3);
+    const __m256i u4 = _mm256_unpacklo_epi64(t4, t6);
+    const __m256i u5 = _mm256_unpackhi_epi64(t4, t6);
+    const __m256i u6 = _mm256_unpacklo_epi64(t5, t7);
+    const __m256i u7 = _mm256_unpackhi_epi64(t5, t7);
+    
+    out[0] = _mm256_permute2x128_si256(u0, u4, 0x20);
+    out[1] = _mm256_permute2x128_si256(u1, u5, 0x20);
+    out[2] = _mm256_permute2x128_si256(u2, u6, 0x20);
+    out[3] = _mm256_permute2x128_si256(u3, u7, 0x20);
+    out[4] = _mm256_permute2x128_si256(u0, u4, 0x31);
+    out[5] = _mm256_permute2x128_si256(u1, u5, 0x31);
+    out[6] = _mm256_permute2x128_si256(u2, u6, 0x31);
+    out[7] = _mm256_permute2x128_si256(u3, u7, 0x31);
+}
+
+HM_TARGET("avx2") void BatchHasher<MD5>::TransformAVX2x8(uint32_t* const state, const uint8_t* const* const data, const uint64_t numOfBlocks)
+{
+    using MD5Hasher = Hasher<MD5, SOFTWARE>;
+    constexpr const std::array<uint32_t, 16>& S = MD5Hasher::S;
+    constexpr const std::array<uint32_t, 64>& K = MD5Hasher::K;
+    
+    // Load state, it stays in registers for all blocks
+    __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&state[0 * 8]));
+    __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&state[1 * 8]));
+    __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&state[2 * 8]));
+    __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&state[3 * 8]));
+    
+    __m256i x[16];
+    
+    for(uint64_t n = 0; n < numOfBlocks; n++)
+    {
+        const uint64_t offset = n * MD5_BLOCK_LENGTH;
+        
+        LoadTransposed8x8(data, offset, &x[0]);
+        LoadTransposed8x8(data, offset + 32, &x[8]);
+        
+        // Save current state
+        const __m256i aSave = a;
+        const __m256i bSave = b;
+        const __m256i cSave = c;
+        const __m256i dSave = d;
+        
+        // Round 1
+        for(uint32_t i = 0; i < 16; i += 4)
+        {
+            FFx8<S[0]>(a, b, c, d, x[i + 0], K[i + 0]);
+            FFx8<S[1]>(d, a, b, c, x[i + 1], K[i + 1]);
+            FFx8<S[2]>(c, d, a, b, x[i + 2], K[i + 2]);
+            FFx8<S[3]>(b, c, d, a, x[i + 3], K[i + 3]);
+        }
+        
+        // Round 2, message word (1 + 5 * step) mod 16
+        for(uint32_t i = 0; i < 16; i += 4)
+        {
+            GGx8<S[4]>(a, b, c, d, x[(1 + 5 * i) & 15], K[16 + i]);
+            GGx8<S[5]>(d, a, b, c, x[(6 + 5 * i) & 15], K[17 + i]);
+            GGx8<S[6]>(c, d, a, b, x[(11 + 5 * i) & 15], K[18 + i]);
+            GGx8<S[7]>(b, c, d, a, x[(16 + 5 * i) & 15], K[19 + i]);
+        }
+        
+        // Round 3, message word (5 + 3 * step) mod 16
+        for(uint32_t i = 0; i < 16; i += 4)
+        {
+            HHx8<S[8]>(a, b, c, d, x[(5 + 3 * i) & 15], K[32 + i]);
+            HHx8<S[9]>(d, a, b, c, x[(8 + 3 * i) & 15], K[33 + i]);
+            HHx8<S[10]>(c, d, a, b, x[(11 + 3 * i) & 15], K[34 + i]);
+            HHx8<S[11]>(b, c, d, a, x[(14 + 3 * i) & 15], K[35 + i]);
+        }
+        
+        // Round 4, message word (7 * step) mod 16
+        for(uint32_t i = 0; i < 16; i += 4)
+        {
+            IIx8<S[12]>(a, b, c, d, x[(7 * i) & 15], K[48 + i]);
+            IIx8<S[13]>(d, a, b, c, x[(7 + 7 * i) & 15], K[49 + i]);
+            IIx8<S[14]>(c, d, a, b, x[(14 + 7 * i) & 15], K[50 + i]);
+            IIx8<S[15]>(b, c, d, a, x[(21 + 7 * i) & 15], K[51 + i]);
+        }
+        
+        // Update state
+        a = _mm256_add_epi32(a, aSave);
+        b = _mm256_add_epi32(b, bSave);
+        c = _mm256_add_epi32(c, cSave);
+        d = _mm256_add_epi32(d, dSave);
+    }
+    
+    // Save the new state
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&state[0 * 8]), a);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&state[1 * 8]), b);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&state[2 * 8]), c);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&state[3 * 8]), d);
+    
+    // Cleanup sensitive data for security
+#ifdef HM_CLEANUP_TMP_MEMORY_AFTER_HASHING_FOR_SECURITY
+    for(uint32_t i = 0; i < 16; i++)
+        x[i] = _mm256_setzero_si256();
+#endif
+}
+
+// vprold and vpternlogd inline GCC's self initialized _mm512_undefined_epi32(), which is reported as uninitialized
+#if defined(HASH_PREDEF_COMP_GNUC_AVAILABLE) && !defined(HASH_PREDEF_COMP_CLANG_AVAILABLE) // GCC
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+// ***************************************************
+// AVX-512 helpers, every vector holds the same word of 16 different messages. Uses vprold for the rotations
+// and vpternlogd for the three input logic functions
+template <uint32_t S>
+HM_TARGET("avx512f") static inline void Stepx16(__m512i& a, const __m512i b, const __m512i f, const __m512i xk)
+{
+    a = _mm512_add_epi32(_mm512_rol_epi32(_mm512_add_epi32(_mm512_add_epi32(a, f), xk), S), b);
+}
+
+template <uint32_t S>
+HM_TARGET("avx512f") static inline void FFx16(__m512i& a, const __m512i b, const __m512i c, const __m512i d, const __m512i x, const uint32_t ac)
+{
+    const __m512i f = _mm512_ternarylogic_epi32(b, c, d, 0xCA); // b ? c : d
+    Stepx16<S>(a, b, f, _mm512_add_epi32(x, _mm512_set1_epi32(static_cast<int32_t>(ac))));
+}
+
+template <uint32_t S>
+HM_TARGET("avx512f") static inline void GGx16(__m512i& a, const __m512i b, const __m512i c, const __m512i d, const __m512i x, const uint32_t ac)
+{
+    const __m512i g = _mm512_ternarylogic_epi32(d, b, c, 0xCA); // d ? b : c
+    Stepx16<S>(a, b, g, _mm512_add_epi32(x, _mm512_set1_epi32(static_cast<int32_t>(ac))));
+}
+
+template <uint32_t S>
+HM_TARGET("avx512f") static inline void HHx16(__m512i& a, const __m512i b, const __m512i c, const __m512i d, const __m512i x, const uint32_t ac)
+{
+    const __m512i h = _mm512_ternarylogic_epi32(b, c, d, 0x96); // XOR
+    Stepx16<S>(a, b, h, _mm512_add_epi32(x, _mm512_set1_epi32(static_cast<int32_t>(ac))));
+}
+
+template <uint32_t S>
+HM_TARGET("avx512f") static inline void IIx16(__m512i& a, const __m512i b, const __m512i c, const __m512i d, const __m512i x, const uint32_t ac)
+{
+    const __m512i i = _mm512_ternarylogic_epi32(b, c, d, 0x39); // c ^ (b | ~d)
+    Stepx16<S>(a, b, i, _mm512_add_epi32(x, _mm512_set1_epi32(static_cast<int32_t>(ac))));
+}
+
+// Loads one block from each of the 16 lanes and transposes them, so that out[i] holds word i of all lanes
+HM_TARGET("avx512f") static inline void LoadTransposed16x16(const uint8_t* const* const data, const uint64_t offset, __m512i out[16])
+{
+    __m512i rows[16];
+    for(uint32_t i = 0; i < 16; i++)
+        rows[i] = _mm512_loadu_si512(data[i] + offset);
+    
+    // 4x4 transposes inside the 128 bit chunks of each group of 4 lanes
+    __m512i chunks[16];
+    for(uint32_t i = 0; i < 16; i += 4)
+    {
+        const __m512i t0 = _mm512_unpacklo_epi32(rows[i + 0], rows[i + 1]);
+        const __m512i t1 = _mm512_unpackhi_epi32(rows[i + 0], rows[i + 1]);
+        const __m512i t2 = _mm512_unpacklo_epi32(rows[i + 2], rows[i + 3]);
+        const __m512i t3 = _mm512_unpackhi_epi32(rows[i + 2], rows[i + 3]);
+        
+        chunks[i + 0] = _mm512_unpacklo_epi64(t0, t2);
+        chunks[i + 1] = _mm512_unpackhi_epi64(t0, t2);
+        chunks[i + 2] = _mm512_unpacklo_epi64(t1, t3);
+        chunks[i + 3] = _mm512_unpackhi_epi64(t1, t3);
+    }
+    
+    // Transpose the 128 bit chunks across the 4 groups
+    for(uint32_t j = 0; j < 4; j++)
+    {
+        const __m512i x0 = _mm512_shuffle_i32x4(chunks[j], chunks[4 + j], 0x44);
+        const __m512i x1 = _mm512_shuffle_i32x4(chunks[j], chunks[4 + j], 0xEE);
+        const __m512i x2 = _mm512_shuffle_i32x4(chunks[8 + j], chunks[12 + j], 0x44);
+        const __m512i x3 = _mm512_shuffle_i32x4(chunks[8 + j], chunks[12 + j], 0xEE);
+        
+        out[0 + j] = _mm512_shuffle_i32x4(x0, x2, 0x88);
+        out[4 + j] = _mm512_shuffle_i32x4(x0, x2, 0xDD);
+        out[8 + j] = _mm512_shuffle_i32x4(x1, x3, 0x88);
+        out[12 + j] = _mm512_shuffle_i32x4(x1, x3, 0xDD);
+    }
+}
+
+HM_TARGET("avx512f") void BatchHasher<MD5>::TransformAVX512x16(uint32_t* const state, const uint8_t* const* const data, const uint64_t numOfBlocks)
+{
+    using MD5Hasher = Hasher<MD5, SOFTWARE>;
+    constexpr const std::array<uint32_t, 16>& S = MD5Hasher::S;
+    constexpr const std::array<uint32_t, 64>& K = MD5Hasher::K;
+    
+    // Load state, it stays in registers for all blocks
+    __m512i a = _mm512_loadu_si512(&state[0 * 16]);
+    __m512i b = _mm512_loadu_si512(&state[1 * 16]);
+    __m512i c = _mm512_loadu_si512(&state[2 * 16]);
+    __m512i d = _mm512_loadu_si512(&state[3 * 16]);
+    
+    __m512i x[16];
+    
+    for(uint64_t n = 0; n < numOfBlocks; n++)
+    {
+        LoadTransposed16x16(data, n * MD5_BLOCK_LENGTH, x);
+        
+        // Save current state
+        const __m512i aSave = a;
+        const __m512i bSave = b;
+        const __m512i cSave = c;
+        const __m512i dSave = d;
+        
+        // Round 1
+        for(uint32_t i = 0; i < 16; i += 4)
+        {
+            FFx16<S[0]>(a, b, c, d, x[i + 0], K[i + 0]);
+            FFx16<S[1]>(d, a, b, c, x[i + 1], K[i + 1]);
+            FFx16<S[2]>(c, d, a, b, x[i + 2], K[i + 2]);
+            FFx16<S[3]>(b, c, d, a, x[i + 3], K[i + 3]);
+        }
+        
+        // Round 2, message word (1 + 5 * step) mod 16
+        for(uint32_t i = 0; i < 16; i += 4)
+        {
+            GGx16<S[4]>(a, b, c, d, x[(1 + 5 * i) & 15], K[16 + i]);
+            GGx16<S[5]>(d, a, b, c, x[(6 + 5 * i) & 15], K[17 + i]);
+            GGx16<S[6]>(c, d, a, b, x[(11 + 5 * i) & 15], K[18 + i]);
+            GGx16<S[7]>(b, c, d, a, x[(16 + 5 * i) & 15], K[19 + i]);
+        }
+        
+        // Round 3, message word (5 + 3 * step) mod 16
+        for(uint32_t i = 0; i < 16; i += 4)
+        {
+            HHx16<S[8]>(a, b, c, d, x[(5 + 3 * i) & 15], K[32 + i]);
+            HHx16<S[9]>(d, a, b, c, x[(8 + 3 * i) & 15], K[33 + i]);
+            HHx16<S[10]>(c, d, a, b, x[(11 + 3 * i) & 15], K[34 + i]);
+            HHx16<S[11]>(b, c, d, a, x[(14 + 3 * i) & 15], K[35 + i]);
+        }
+        
+        // Round 4, message word (7 * step) mod 16
+        for(uint32_t i = 0; i < 16; i += 4)
+        {
+            IIx16<S[12]>(a, b, c, d, x[(7 * i) & 15], K[48 + i]);
+            IIx16<S[13]>(d, a, b, c, x[(7 + 7 * i) & 15], K[49 + i]);
+            IIx16<S[14]>(c, d, a, b, x[(14 + 7 * i) & 15], K[50 + i]);
+            IIx16<S[15]>(b, c, d, a, x[(21 + 7 * i) & 15], K[51 + i]);
+        }
+        
+        // Update state
+        a = _mm512_add_epi32(a, aSave);
+        b = _mm512_add_epi32(b, bSave);
+        c = _mm512_add_epi32(c, cSave);
+        d = _mm512_add_epi32(d, dSave);
+    }
+    
+    // Save the new state
+    _mm512_storeu_si512(&state[0 * 16], a);
+    _mm512_storeu_si512(&state[1 * 16], b);
+    _mm512_storeu_si512(&state[2 * 16], c);
+    _mm512_storeu_si512(&state[3 * 16], d);
+    
+    // Cleanup sensitive data for security
+#ifdef HM_CLEANUP_TMP_MEMORY_AFTER_HASHING_FOR_SECURITY
+    for(uint32_t i = 0; i < 16; i++)
+        x[i] = _mm512_setzero_si512();
+#endif
+}
+
+#if defined(HASH_PREDEF_COMP_GNUC_AVAILABLE) && !defined(HASH_PREDEF_COMP_CLANG_AVAILABLE) // GCC
+#pragma GCC diagnostic pop
+#endif
+#endif
+
+BatchHasher<MD5>::BatchHasher()
+{
+    // Single messages use the block function of the hasher
+    m_TransformFunction = Hasher<MD5, SOFTWARE>::TransformBlocks;
+    
+#if defined(HM_SIMD_X86)
+    const CPU::Features& features = CPU::GetFeatures();
+    
+    // Sorted by number of lanes
+    if(features.hasAVX512F)
+        m_MultiBufferKernels[m_NumOfMultiBufferKernels++] = { TransformAVX512x16, 16 };
+    
+    if(features.hasAVX2)
+        m_MultiBufferKernels[m_NumOfMultiBufferKernels++] = { TransformAVX2x8, 8 };
+#endif
+}
+
+void BatchHasher<MD5>::SplitMessage(const std::span<const uint8_t>& message, MessageBlocks& blocks)
+{
+    blocks.data[0] = message.data();
+    blocks.numOfBlocks[0] = message.size() / MD5_BLOCK_LENGTH;
+    
+    const uint8_t* const tail = message.data() + blocks.numOfBlocks[0] * MD5_BLOCK_LENGTH;
+    const uint32_t tailSize = static_cast<uint32_t>(message.size() % MD5_BLOCK_LENGTH);
+    
+    blocks.data[1] = blocks.finalBlocks;
+    blocks.numOfBlocks[1] = Hasher<MD5, SOFTWARE>::PadFinalBlocks(blocks.finalBlocks, tail, tailSize, message.size() << 3);
+}
+
+void BatchHasher<MD5>::HashSingleStream(const std::vector<std::span<const uint8_t>>& messages, uint8_t* const digests) const
+{
+    uint32_t state[4];
+    MessageBlocks blocks;
+    
+    for(uint64_t i = 0; i < messages.size(); i++)
+    {
+        std::copy(Hasher<MD5, SOFTWARE>::INITIAL_HASH_VALUES.begin(), Hasher<MD5, SOFTWARE>::INITIAL_HASH_VALUES.end(), state);
+        SplitMessage(messages[i], blocks);
+        
+        for(uint32_t j = 0; j < 2; j++)
+        {
+            if(blocks.numOfBlocks[j] > 0)
+                m_TransformFunction(state, blocks.data[j], blocks.numOfBlocks[j]);
+        }
+        
+        Hasher<MD5, SOFTWARE>::StoreDigest(state, 1, digests + i * 16, 16);
+    }
+    
+    // Cleanup sensitive data for security
+#ifdef HM_CLEANUP_TMP_MEMORY_AFTER_HASHING_FOR_SECURITY
+    std::memset(state, 0, sizeof(state));
+    std::memset(blocks.finalBlocks, 0, sizeof(blocks.finalBlocks));
+#endif
+}
+
+void BatchHasher<MD5>::HashMultiBuffer(const MultiBufferKernel& kernel, const std::vector<std::span<const uint8_t>>& messages, uint8_t* const digests) const
+{
+    // Message currently processed by a lane. The whole blocks are read directly from the message,
+    // the final blocks from a copy
+    struct Lane
+    {
+        bool            isActive = false;
+        uint64_t        messageIndex = 0;
+        uint32_t        nextPart = 0;
+        const uint8_t*  data = nullptr;
+        uint64_t        remainingBlocks = 0;
+        MessageBlocks   blocks;
+    };
+    
+    const uint32_t numOfLanes = kernel.numOfLanes;
+    
+    alignas(64) uint32_t state[4 * MAX_NUM_OF_LANES];
+    Lane lanes[MAX_NUM_OF_LANES];
+    const uint8_t* dataPointers[MAX_NUM_OF_LANES];
+    
+    uint64_t nextMessage = 0;
+    uint32_t numOfActiveLanes = 0;
+    
+    // Continues a lane with the next part of its message which has blocks. Returns false if the message is done
+    auto StartNextPart = [](Lane& lane) -> bool
+    {
+        while(lane.nextPart < 2)
+        {
+            const uint32_t part = lane.nextPart++;
+            
+            if(lane.blocks.numOfBlocks[part] > 0)
+            {
+                lane.data = lane.blocks.data[part];
+                lane.remainingBlocks = lane.blocks.numOfBlocks[part];
+                return true;
+            }
+        }
+        
+        return false;
+    };
+    
+    // Assigns the next message to a lane. Returns false if all messages are already assigned
+    auto StartNextMessage = [&](const uint32_t laneIndex) -> bool
+    {
+        Lane& lane = lanes[laneIndex];
+        
+        lane.isActive = (nextMessage < messages.size());
+        if(!lane.isActive)
+            return false;
+        
+        lane.messageIndex = nextMessage++;
+        
+        for(uint32_t i = 0; i < 4; i++)
+            state[i * numOfLanes + laneIndex] = Hasher<MD5, SOFTWARE>::INITIAL_HASH_VALUES[i];
+        
+        SplitMessage(messages[lane.messageIndex], lane.blocks);
+        
+        // There is always at least one final block
+        lane.nextPart = 0;
+        StartNextPart(lane);
+        
+        return true;
+    };
+    
+    for(uint32_t i = 0; i < numOfLanes; i++)
+    {
+        if(StartNextMessage(i))
+            numOfActiveLanes++;
+    }
+    
+    while(numOfActiveLanes > 0)
+    {
+        // Run all lanes for the smallest number of remaining blocks, so that at least one lane finishes its current part
+        uint64_t numOfBlocks = UINT64_MAX;
+        const uint8_t* activeData = nullptr;
+        
+        for(uint32_t i = 0; i < numOfLanes; i++)
+        {
+            if(lanes[i].isActive && lanes[i].remainingBlocks < numOfBlocks)
+            {
+                numOfBlocks = lanes[i].remainingBlocks;
+                activeData = lanes[i].data;
+            }
+        }
+        
+        // Idle lanes hash the data of an active lane, their result is discarded
+        for(uint32_t i = 0; i < numOfLanes; i++)
+            dataPointers[i] = lanes[i].isActive ? lanes[i].data : activeData;
+        
+        kernel.function(state, dataPointers, numOfBlocks);
+        
+        for(uint32_t i = 0; i < numOfLanes; i++)
+        {
+            Lane& lane = lanes[i];
+            if(!lane.isActive)
+                continue;
+            
+            lane.data += numOfBlocks * MD5_BLOCK_LENGTH;
+            lane.remainingBlocks -= numOfBlocks;
+            
+            if(lane.remainingBlocks > 0 || StartNextPart(lane))
+                continue;
+            
+            // Message is done, retire it and refill the lane
+            Hasher<MD5, SOFTWARE>::StoreDigest(&state[i], numOfLanes, digests + lane.messageIndex * 16, 16);
+            
+            if(!StartNextMessage(i))
+                numOfActiveLanes--;
+        }
+    }
+    
+    // Cleanup sensitive data for security
+#ifdef HM_CLEANUP_TMP_MEMORY_AFTER_HASHING_FOR_SECURITY
+    std::memset(state, 0, sizeof(state));
+    for(uint32_t i = 0; i < numOfLanes; i++)
+        std::memset(lanes[i].blocks.finalBlocks, 0, sizeof(lanes[i].blocks.finalBlocks));
+#endif
+}
+
+void BatchHasher<MD5>::HashMessages(const std::vector<std::span<const uint8_t>>& messages, uint8_t* const digests) const
+{
+    // An empty batch has no digests, the digest buffer may be nullptr then
+    if(messages.empty())
+        return;
+    
+    if(!digests)
+        throw std::invalid_argument("Digests cannot be nullptr.");
+    
+    for(const std::span<const uint8_t>& message : messages)
+    {
+        if(!message.data() && message.size() > 0)
+            throw std::invalid_argument("Data cannot be nullptr.");
+    }
+    
+    // Use the widest kernel that can fill all of its lanes
+    for(uint32_t i = 0; i < m_NumOfMultiBufferKernels; i++)
+    {
+        if(messages.size() >= m_MultiBufferKernels[i].numOfLanes)
+        {
+            HashMultiBuffer(m_MultiBufferKernels[i], messages, digests);
+            return;
+        }
+    }
+    
+    HashSingleStream(messages, digests);
+}
+
+uint32_t BatchHasher<MD5>::GetNumOfLanes() const
+{
+    return (m_NumOfMultiBufferKernels > 0) ? m_MultiBufferKernels[0].numOfLanes : 1;
+}
+
+void BatchHasher<MD5>::Hash(const std::vector<std::span<const uint8_t>>& messages, uint8_t* const digests) const
+{
+    HashMessages(messages, digests);
+}
+
+std::vector<std::vector<uint8_t>> BatchHasher<MD5>::Hash(const std::vector<std::span<const uint8_t>>& messages) const
+{
+    std::vector<uint8_t> digests(messages.size() * 16);
+    Hash(messages, digests.data());
+    
+    std::vector<std::vector<uint8_t>> result(messages.size());
+    for(uint64_t i = 0; i < messages.size(); i++)
+        result[i].assign(digests.begin() + static_cast<std::ptrdiff_t>(i * 16), digests.begin() + static_cast<std::ptrdiff_t>((i + 1) * 16));
+    
+    return result;
+}
@@ -0,0 +1,540 @@
+/*
+    The zlib License
+
+    Copyright (C) 2024 Marc Schöndorf
+ 
+This software is provided 'as-is', without any express or implied warranty. In
+no event will the authors be held liable for any damages arising from the use of
+this software.
+
+Permission is granted to anyone to use this software for any purpose, including
+commercial applications, and to alter it and redistribute it freely, subject to
+the following restrictions:
+
+1.  The origin of this software must not be misrepresented; you must not claim
+    that you wrote the original software. If you use this software in a product,
+    an acknowledgment in the product documentation would be appreciated but is
+    not required.
+
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+
+3.  This notice may not be removed or altered from any source distribution.
+*/
+
+
+/*------------------------------------------------------------------*/
+/*                                                                  */
+/*                      (C) 2024 Marc Schöndorf                     */
+/*                            See license                           */
+/*                                                                  */
+/*  MerkleTree.cpp                                                  */
+/*  Created: 16.10.2026                                             */
+/*------------------------------------------------------------------*/
+
+#include "HashMe.hpp"
+
+using namespace HashMe;
+
+// ***************************************************
+// Domain separation prefixes of RFC 6962
+const BatchHasher<SHA256>::Midstate& MerkleTree::LeafMidstate()
+{
+    static const BatchHasher<SHA256>::Midstate midstate = BatchHasher<SHA256>::PrefixMidstate(0x00);
+    return midstate;
+}
+
+const BatchHasher<SHA256>::Midstate& MerkleTree::NodeMidstate()
+{
+    static const BatchHasher<SHA256>::Midstate midstate = BatchHasher<SHA256>::PrefixMidstate(0x01);
+    return midstate;
+}
+
+void MerkleTree::HashChildren(const BatchHasher<SHA256>& batchHasher, const uint8_t* const left, const uint8_t* const right, uint8_t* const digest)
+{
+    uint8_t children[2 * DIGEST_LENGTH];
+    std::copy(left, left + DIGEST_LENGTH, children);
+    std::copy(right, right + DIGEST_LENGTH, children + DIGEST_LENGTH);
+    
+    batchHasher.Hash(NodeMidstate(), std::span<const uint8_t>(children, sizeof(children)), digest);
+}
+
+std::vector<uint8_t> MerkleTree::HashLeaf(const std::span<const uint8_t> leaf)
+{
+    std::vector<uint8_t> digest(DIGEST_LENGTH);
+    BatchHasher<SHA256>().Hash(LeafMidstate(), leaf, digest.data());
+    
+    return digest;
+}
+
+void MerkleTree::Build(const std::vector<std::span<const uint8_t>>& leaves)
+{
+    Build(leaves, nullptr);
+}
+
+void MerkleTree::Build(const std::vector<std::span<const uint8_t>>& leaves, ThreadPool& threadPool)
+{
+    Build(leaves, &threadPool);
+}
+
+void MerkleTree::ForEachTask(ThreadPool* const threadPool, const uint64_t numOfNodes, const std::function<void(uint64_t, uint64_t)>& function)
+{
+    // Every task hashes up to NUM_OF_NODES_PER_TASK nodes, enough to keep all lanes of the batch hasher busy
+    const uint64_t numOfTasks = (numOfNodes + NUM_OF_NODES_PER_TASK - 1) / NUM_OF_NODES_PER_TASK;
+    auto Task = [numOfNodes, &function](const uint64_t task)
+    {
+        const uint64_t first = task * NUM_OF_NODES_PER_TASK;
+        function(first, std::min(first + NUM_OF_NODES_PER_TASK, numOfNodes));
+    };
+    
+    if(threadPool)
+        threadPool->ParallelFor(numOfTasks, Task);
+    else
+    {
+        for(uint64_t task = 0; task < numOfTasks; task++)
+            Task(task);
+    }
+}
+
+void MerkleTree::Build(const std::vector<std::span<const uint8_t>>& leaves, ThreadPool* const threadPool)
+{
+    m_Levels.clear();
+    m_DirtyLeaves.clear();
+    m_DirtyLeavesSorted = true;
+    
+    if(leaves.empty())
+        return;
+    
+    // Leaf hashes
+    std::vector<uint8_t> leafHashes(leaves.size() * DIGEST_LENGTH);
+    ForEachTask(threadPool, leaves.size(), [this, &leaves, &leafHashes](const uint64_t first, const uint64_t last)
+    {
+        const std::vector<std::span<const uint8_t>> messages(leaves.begin() + static_cast<std::ptrdiff_t>(first), leaves.begin() + static_cast<std::ptrdiff_t>(last));
+        m_BatchHasher.Hash(LeafMidstate(), messages, leafHashes.data() + first * DIGEST_LENGTH);
+    });
+    
+    m_Levels.push_back(std::move(leafHashes));
+    
+    // Inner levels. The two children of a node are adjacent, so the message after the prefix points into the level below
+    while(m_Levels.back().size() > DIGEST_LENGTH)
+    {
+        const std::vector<uint8_t>& children = m_Levels.back();
+        const uint64_t numOfChildren = children.size() / DIGEST_LENGTH;
+        
+        std::vector<uint8_t> parents((numOfChildren + 1) / 2 * DIGEST_LENGTH);
+        ForEachTask(threadPool, numOfChildren / 2, [this, &children, &parents](const uint64_t first, const uint64_t last)
+        {
+            std::vector<std::span<const uint8_t>> messages;
+            messages.reserve(last - first);
+            
+            for(uint64_t i = first; i < last; i++)
+                messages.emplace_back(children.data() + i * 2 * DIGEST_LENGTH, 2 * DIGEST_LENGTH);
+            
+            m_BatchHasher.Hash(NodeMidstate(), messages, parents.data() + first * DIGEST_LENGTH);
+        });
+        
+        // A last node without sibling moves up unchanged
+        if(numOfChildren % 2 == 1)
+            std::copy(children.end() - DIGEST_LENGTH, children.end(), parents.end() - DIGEST_LENGTH);
+        
+        m_Levels.push_back(std::move(parents));
+    }
+}
+
+void MerkleTree::MarkDirty(const uint64_t leafIndex)
+{
+    if(!m_DirtyLeaves.empty() && leafIndex < m_DirtyLeaves.back())
+        m_DirtyLeavesSorted = false;
+    
+    m_DirtyLeaves.push_back(leafIndex);
+}
+
+void MerkleTree::SetLeaf(const uint64_t leafIndex, const std::span<const uint8_t> leaf)
+{
+    if(leafIndex >= GetNumOfLeaves())
+        throw std::invalid_argument("Leaf index is out of range.");
+    
+    m_BatchHasher.Hash(LeafMidstate(), leaf, m_Levels[0].data() + leafIndex * DIGEST_LENGTH);
+    MarkDirty(leafIndex);
+}
+
+void MerkleTree::SetLeaves(const std::vector<uint64_t>& leafIndices, const std::vector<std::span<const uint8_t>>& leaves)
+{
+    if(leafIndices.size() != leaves.size())
+        throw std::invalid_argument("Number of leaf indices and leaves differs.");
+    
+    for(const uint64_t leafIndex : leafIndices)
+    {
+        if(leafIndex >= GetNumOfLeaves())
+            throw std::invalid_argument("Leaf index is out of range.");
+    }
+    
+    // Hash all leaves in one batch, then scatter the digests. A leaf set twice keeps the last value
+    std::vector<uint8_t> leafHashes(leaves.size() * DIGEST_LENGTH);
+    m_BatchHasher.Hash(LeafMidstate(), leaves, leafHashes.data());
+    
+    for(uint64_t i = 0; i < leafIndices.size(); i++)
+    {
+        const auto leafHash = leafHashes.begin() + static_cast<std::ptrdiff_t>(i * DIGEST_LENGTH);
+        std::copy(leafHash, leafHash + DIGEST_LENGTH, m_Levels[0].begin() + static_cast<std::ptrdiff_t>(leafIndices[i] * DIGEST_LENGTH));
+        
+        MarkDirty(leafIndices[i]);
+    }
+}
+
+void MerkleTree::Update()
+{
+    Update(nullptr);
+}
+
+void MerkleTree::Update(ThreadPool& threadPool)
+{
+    Update(&threadPool);
+}
+
+void MerkleTree::Update(ThreadPool* const threadPool)
+{
+    if(m_DirtyLeaves.empty())
+        return;
+    
+    if(!m_DirtyLeavesSorted)
+        std::sort(m_DirtyLeaves.begin(), m_DirtyLeaves.end());
+    
+    // Dirty nodes of the current level, sorted. Shifting keeps them sorted, so converging paths become adjacent duplicates
+    std::vector<uint64_t> dirtyNodes = std::move(m_DirtyLeaves);
+    std::vector<uint8_t> parentHashes;
+    
+    for(uint32_t level = 0; level + 1 < m_Levels.size(); level++)
+    {
+        for(uint64_t& node : dirtyNodes)
+            node >>= 1;
+        
+        dirtyNodes.erase(std::unique(dirtyNodes.begin(), dirtyNodes.end()), dirtyNodes.end());
+        
+        const std::vector<uint8_t>& children = m_Levels[level];
+        std::vector<uint8_t>& parents = m_Levels[level + 1];
+        const uint64_t numOfChildren = children.size() / DIGEST_LENGTH;
+        
+        // A last node without sibling moves up unchanged
+        uint64_t numOfPairs = dirtyNodes.size();
+        if(numOfChildren % 2 == 1 && dirtyNodes.back() == numOfChildren / 2)
+        {
+            std::copy(children.end() - DIGEST_LENGTH, children.end(), parents.end() - DIGEST_LENGTH);
+            numOfPairs--;
+        }
+        
+        // The parents are not contiguous, hash into a buffer and scatter
+        parentHashes.resize(numOfPairs * DIGEST_LENGTH);
+        ForEachTask(threadPool, numOfPairs, [this, &dirtyNodes, &children, &parents, &parentHashes](const uint64_t first, const uint64_t last)
+        {
+            std::vector<std::span<const uint8_t>> messages;
+            messages.reserve(last - first);
+            
+            for(uint64_t i = first; i < last; i++)
+                messages.emplace_back(children.data() + dirtyNodes[i] * 2 * DIGEST_LENGTH, 2 * DIGEST_LENGTH);
+            
+            m_BatchHasher.Hash(NodeMidstate(), messages, parentHashes.data() + first * DIGEST_LENGTH);
+            
+            for(uint64_t i = first; i < last; i++)
+            {
+                const auto parentHash = parentHashes.begin() + static_cast<std::ptrdiff_t>(i * DIGEST_LENGTH);
+                std::copy(parentHash, parentHash + DIGEST_LENGTH, parents.begin() + static_cast<std::ptrdiff_t>(dirtyNodes[i] * DIGEST_LENGTH));
+            }
+        });
+    }
+    
+    m_DirtyLeaves.clear();
+    m_DirtyLeavesSorted = true;
+}
+
+bool MerkleTree::HasChangedLeaves() const
+{
+    return !m_DirtyLeaves.empty();
+}
+
+void MerkleTree::CheckUpToDate() const
+{
+    if(HasChangedLeaves())
+        throw std::logic_error("Tree has changed leaves, call Update() first.");
+}
+
+uint64_t MerkleTree::GetNumOfLeaves() const
+{
+    return m_Levels.empty() ? 0 : GetNumOfNodes(0);
+}
+
+uint32_t MerkleTree::GetNumOfLevels() const
+{
+    return static_cast<uint32_t>(m_Levels.size());
+}
+
+uint64_t MerkleTree::GetNumOfNodes(const uint32_t level) const
+{
+    return m_Levels[level].size() / DIGEST_LENGTH;
+}
+
+std::vector<uint8_t> MerkleTree::GetNode(const uint32_t level, const uint64_t index) const
+{
+    const auto node = m_Levels[level].begin() + static_cast<std::ptrdiff_t>(index * DIGEST_LENGTH);
+    
+    return std::vector<uint8_t>(node, node + DIGEST_LENGTH);
+}
+
+std::vector<uint8_t> MerkleTree::GetRoot() const
+{
+    CheckUpToDate();
+    
+    if(m_Levels.empty())
+    {
+        std::vector<uint8_t> digest(DIGEST_LENGTH);
+        Hasher<SHA256, SOFTWARE>::HashShort(nullptr, 0, digest.data());
+        
+        return digest;
+    }
+    
+    return m_Levels.back();
+}
+
+std::span<const uint8_t> MerkleTree::GetLevel(const uint32_t level) const
+{
+    CheckUpToDate();
+    
+    if(level >= m_Levels.size())
+        throw std::invalid_argument("Level does not exist.");
+    
+    return std::span<const uint8_t>(m_Levels[level]);
+}
+
+std::vector<uint8_t> MerkleTree::Serialize() const
+{
+    CheckUpToDate();
+    
+    const uint64_t numOfLeaves = GetNumOfLeaves();
+    
+    uint64_t size = 8;
+    for(const std::vector<uint8_t>& level : m_Levels)
+        size += level.size();
+    
+    std::vector<uint8_t> data;
+    data.reserve(size);
+    
+    for(uint32_t i = 0; i < 8; i++)
+        data.push_back(static_cast<uint8_t>(numOfLeaves >> ((7 - i) * 8)));
+    
+    for(const std::vector<uint8_t>& level : m_Levels)
+        data.insert(data.end(), level.begin(), level.end());
+    
+    return data;
+}
+
+void MerkleTree::Deserialize(const std::vector<uint8_t>& data)
+{
+    if(data.size() < 8)
+        throw std::invalid_argument("Serialized tree is too short.");
+    
+    uint64_t numOfLeaves = 0;
+    for(uint32_t i = 0; i < 8; i++)
+        numOfLeaves = (numOfLeaves << 8) | data[i];
+    
+    // Check the size before allocating anything
+    uint64_t size = 8;
+    for(uint64_t numOfNodes = numOfLeaves; numOfNodes > 0; numOfNodes = (numOfNodes == 1) ? 0 : (numOfNodes + 1) / 2)
+    {
+        if(numOfNodes > (data.size() - size) / DIGEST_LENGTH)
+            throw std::invalid_argument("Serialized tree has the wrong size.");
+        
+        size += numOfNodes * DIGEST_LENGTH;
+    }
+    
+    if(size != data.size())
+        throw std::invalid_argument("Serialized tree has the wrong size.");
+    
+    m_Levels.clear();
+    m_DirtyLeaves.clear();
+    m_DirtyLeavesSorted = true;
+    
+    auto level = data.begin() + 8;
+    for(uint64_t numOfNodes = numOfLeaves; numOfNodes > 0; numOfNodes = (numOfNodes == 1) ? 0 : (numOfNodes + 1) / 2)
+    {
+        const auto levelEnd = level + static_cast<std::ptrdiff_t>(numOfNodes * DIGEST_LENGTH);
+        m_Levels.emplace_back(level, levelEnd);
+        level = levelEnd;
+    }
+}
+
+std::vector<std::vector<uint8_t>> MerkleTree::GetInclusionProof(const uint64_t leafIndex) const
+{
+    CheckUpToDate();
+    
+    if(leafIndex >= GetNumOfLeaves())
+        throw std::invalid_argument("Leaf index is out of range.");
+    
+    std::vector<std::vector<uint8_t>> proof;
+    
+    uint64_t index = leafIndex;
+    for(uint32_t level = 0; level + 1 < m_Levels.size(); level++)
+    {
+        // A node without sibling moved up unchanged and adds nothing to the path
+        const uint64_t sibling = index ^ 1;
+        if(sibling < GetNumOfNodes(level))
+            proof.push_back(GetNode(level, sibling));
+        
+        index >>= 1;
+    }
+    
+    return proof;
+}
+
+std::vector<uint8_t> MerkleTree::GetSubtreeRoot(const uint64_t begin, const uint64_t end) const
+{
+    // Subtrees of the decomposition start at a multiple of their height's power of two
+    const uint32_t level = static_cast<uint32_t>(std::bit_width(end - begin - 1));
+    
+    return GetNode(level, begin >> level);
+}
+
+void MerkleTree::AppendSubproof(const uint64_t oldNumOfLeaves, const uint64_t begin, const uint64_t end, const bool isOldTree,
+                                std::vector<std::vector<uint8_t>>& proof) const
+{
+    const uint64_t numOfLeaves = end - begin;
+    
+    if(oldNumOfLeaves == numOfLeaves)
+    {
+        // The verifier knows the root of the old tree
+        if(!isOldTree)
+            proof.push_back(GetSubtreeRoot(begin, end));
+        
+        return;
+    }
+    
+    // Largest power of two smaller than the number of leaves
+    const uint64_t split = std::bit_floor(numOfLeaves - 1);
+    
+    if(oldNumOfLeaves <= split)
+    {
+        AppendSubproof(oldNumOfLeaves, begin, begin + split, isOldTree, proof);
+        proof.push_back(GetSubtreeRoot(begin + split, end));
+    }
+    else
+    {
+        AppendSubproof(oldNumOfLeaves - split, begin + split, end, false, proof);
+        proof.push_back(GetSubtreeRoot(begin, begin + split));
+    }
+}
+
+std::vector<std::vector<uint8_t>> MerkleTree::GetConsistencyProof(const uint64_t oldNumOfLeaves) const
+{
+    CheckUpToDate();
+    
+    if(oldNumOfLeaves == 0 || oldNumOfLeaves > GetNumOfLeaves())
+        throw std::invalid_argument("Old number of leaves is out of range.");
+    
+    std::vector<std::vector<uint8_t>> proof;
+    AppendSubproof(oldNumOfLeaves, 0, GetNumOfLeaves(), true, proof);
+    
+    return proof;
+}
+
+bool MerkleTree::VerifyInclusionProof(const std::vector<uint8_t>& leafHash, const uint64_t leafIndex, const uint64_t numOfLeaves,
+                                      const std::vector<std::vector<uint8_t>>& proof, const std::vector<uint8_t>& root)
+{
+    if(leafIndex >= numOfLeaves || leafHash.size() != DIGEST_LENGTH || root.size() != DIGEST_LENGTH)
+        return false;
+    
+    const BatchHasher<SHA256> batchHasher;
+    
+    uint64_t fn = leafIndex;
+    uint64_t sn = numOfLeaves - 1;
+    std::vector<uint8_t> r = leafHash;
+    
+    for(const std::vector<uint8_t>& p : proof)
+    {
+        if(sn == 0 || p.size() != DIGEST_LENGTH)
+            return false;
+        
+        if((fn & 1) || fn == sn)
+        {
+            HashChildren(batchHasher, p.data(), r.data(), r.data());
+            
+            while(!(fn & 1) && fn != 0)
+            {
+                fn >>= 1;
+                sn >>= 1;
+            }
+        }
+        else
+            HashChildren(batchHasher, r.data(), p.data(), r.data());
+        
+        fn >>= 1;
+        sn >>= 1;
+    }
+    
+    return sn == 0 && r == root;
+}
+
+bool MerkleTree::VerifyConsistencyProof(const uint64_t oldNumOfLeaves, const uint64_t numOfLeaves, const std::vector<std::vector<uint8_t>>& proof,
+                                        const std::vector<uint8_t>& oldRoot, const std::vector<uint8_t>& root)
+{
+    if(oldNumOfLeaves == 0 || oldNumOfLeaves > numOfLeaves || oldRoot.size() != DIGEST_LENGTH || root.size() != DIGEST_LENGTH)
+        return false;
+    
+    if(oldNumOfLeaves == numOfLeaves)
+        return proof.empty() && oldRoot == root;
+    
+    // The root of an old tree with a power of two leaves is not part of the proof
+    std::vector<std::vector<uint8_t>> path;
+    if(std::has_single_bit(oldNumOfLeaves))
+        path.push_back(oldRoot);
+    
+    path.insert(path.end(), proof.begin(), proof.end());
+    
+    if(path.empty())
+        return false;
+    
+    for(const std::vector<uint8_t>& c : path)
+    {
+        if(c.size() != DIGEST_LENGTH)
+            return false;
+    }
+    
+    const BatchHasher<SHA256> batchHasher;
+    
+    uint64_t fn = oldNumOfLeaves - 1;
+    uint64_t sn = numOfLeaves - 1;
+    
+    while(fn & 1)
+    {
+        fn >>= 1;
+        sn >>= 1;
+    }
+    
+    std::vector<uint8_t> fr = path[0];
+    std::vector<uint8_t> sr = path[0];
+    
+    for(uint64_t i = 1; i < path.size(); i++)
+    {
+        const std::vector<uint8_t>& c = path[i];
+        
+        if(sn == 0)
+            return false;
+        
+        if((fn & 1) || fn == sn)
+        {
+            HashChildren(batchHasher, c.data(), fr.data(), fr.data());
+            HashChildren(batchHasher, c.data(), sr.data(), sr.data());
+            
+            while(!(fn & 1) && fn != 0)
+            {
+                fn >>= 1;
+                sn >>= 1;
+            }
+        }
+        else
+            HashChildren(batchHasher, sr.data(), c.data(), sr.data());
+        
+        fn >>= 1;
+        sn >>= 1;
+    }
+    
+    return fr == oldRoot && sr == root && sn == 0;
+}
@@ -46,11 +46,7 @@ Hasher<SHA224, SOFTWARE>::Hasher(const Hasher& other) : Hasher<SHA256, SOFTWARE>
 
 void Hasher<SHA224, SOFTWARE>::Initialize()
 {
-    // Set state to initial hash values
-    std::copy(INITIAL_HASH_VALUES.begin(), INITIAL_HASH_VALUES.end(), m_Context->state);
-    
-    m_Context->bufferSize = 0;
-    m_Context->numOfBits = 0;
+    InitializeContext(*m_Context, INITIAL_HASH_VALUES);
 }
 
 void Hasher<SHA224, SOFTWARE>::Reset()
@@ -63,45 +59,13 @@ void Hasher<SHA224, SOFTWARE>::Reset()
 
 std::vector<uint8_t> Hasher<SHA224, SOFTWARE>::End()
 {
-    // Pad last block
-    if(m_Context->bufferSize < SHA256_BLOCK_LENGTH - 8)
-    {
-        std::memset(m_Context->buffer + m_Context->bufferSize, 0x00, SHA256_BLOCK_LENGTH - 8 - m_Context->bufferSize);
-        m_Context->buffer[m_Context->bufferSize] = 0x80;
-    }
-    else
-    {
-        std::memset(m_Context->buffer + m_Context->bufferSize, 0x00, SHA256_BLOCK_LENGTH - m_Context->bufferSize);
-        m_Context->buffer[m_Context->bufferSize] = 0x80;
-        
-        Transform(m_Context->buffer);
-        
-        std::memset(m_Context->buffer, 0x00, SHA256_BLOCK_LENGTH - 8);
-    }
-    
-    // Append full message length to padding block
-    m_Context->buffer[SHA256_BLOCK_LENGTH - 1] = static_cast<uint8_t>(m_Context->numOfBits);
-    m_Context->buffer[SHA256_BLOCK_LENGTH - 2] = static_cast<uint8_t>(m_Context->numOfBits >> 8);
-    m_Context->buffer[SHA256_BLOCK_LENGTH - 3] = static_cast<uint8_t>(m_Context->numOfBits >> 16);
-    m_Context->buffer[SHA256_BLOCK_LENGTH - 4] = static_cast<uint8_t>(m_Context->numOfBits >> 24);
-    m_Context->buffer[SHA256_BLOCK_LENGTH - 5] = static_cast<uint8_t>(m_Context->numOfBits >> 32);
-    m_Context->buffer[SHA256_BLOCK_LENGTH - 6] = static_cast<uint8_t>(m_Context->numOfBits >> 40);
-    m_Context->buffer[SHA256_BLOCK_LENGTH - 7] = static_cast<uint8_t>(m_Context->numOfBits >> 48);
-    m_Context->buffer[SHA256_BLOCK_LENGTH - 8] = static_cast<uint8_t>(m_Context->numOfBits >> 56);
-    
-    // Transform
-    Transform(m_Context->buffer);
-    
-    // Assemble hash, omit last 4 bytes for SHA224
     std::vector<uint8_t> hash(28); // 224 bit hash
-    for(uint32_t i = 0; i < 7; i++)
-    {
-#ifdef HM_LITTLE_ENDIAN
-        Utils::U32toU8<Utils::REVERSE_ENDIANNESS>(m_Context->state[i], &hash[i << 2]); // Transform SHA big endian to host little endian
-#else
-        Utils::U32toU8<Utils::KEEP_ENDIANNESS>(m_Context->state[i], &hash[i << 2]);
-#endif
-    }
+    Finalize(*m_Context, TransformSoftware, hash.data(), 28);
     
     return hash;
 }
+
+void Hasher<SHA224, SOFTWARE>::HashShort(const uint8_t* const data, const uint64_t size, uint8_t* const digest)
+{
+    HashSingleBlock(TransformSoftware, INITIAL_HASH_VALUES, data, size, digest, 28);
+}
@@ -0,0 +1,85 @@
+/*
+    The zlib License
+
+    Copyright (C) 2024 Marc Schöndorf
+ 
+This software is provided 'as-is', without any express or implied warranty. In
+no event will the authors be held liable for any damages arising from the use of
+this software.
+
+Permission is granted to anyone to use this software for any purpose, including
+commercial applications, and to alter it and redistribute it freely, subject to
+the following restrictions:
+
+1.  The origin of this software must not be misrepresented; you must not claim
+    that you wrote the original software. If you use this software in a product,
+    an acknowledgment in the product documentation would be appreciated but is
+    not required.
+
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+
+3.  This notice may not be removed or altered from any source distribution.
+*/
+
+
+/*------------------------------------------------------------------*/
+/*                                                                  */
+/*                      (C) 2024 Marc Schöndorf                     */
+/*                            See license                           */
+/*                                                                  */
+/*  SHA224_Batch.cpp                                                */
+/*  Created: 16.10.2026                                             */
+/*------------------------------------------------------------------*/
+
+#include "HashMe.hpp"
+
+using namespace HashMe;
+
+void BatchHasher<SHA224>::Hash(const std::vector<std::span<const uint8_t>>& messages, uint8_t* const digests) const
+{
+    HashMessages(messages, digests, InitialMidstate(Hasher<SHA224, SOFTWARE>::INITIAL_HASH_VALUES), 28);
+}
+
+std::vector<std::vector<uint8_t>> BatchHasher<SHA224>::Hash(const std::vector<std::span<const uint8_t>>& messages) const
+{
+    std::vector<uint8_t> digests(messages.size() * 28);
+    Hash(messages, digests.data());
+    
+    std::vector<std::vector<uint8_t>> result(messages.size());
+    for(uint64_t i = 0; i < messages.size(); i++)
+        result[i].assign(digests.begin() + static_cast<std::ptrdiff_t>(i * 28), digests.begin() + static_cast<std::ptrdiff_t>((i + 1) * 28));
+    
+    return result;
+}
+
+void BatchHasher<SHA224>::Hash(const Midstate& midstate, const std::vector<std::span<const uint8_t>>& suffixes, uint8_t* const digests) const
+{
+    HashMessages(suffixes, digests, midstate, 28);
+}
+
+std::vector<std::vector<uint8_t>> BatchHasher<SHA224>::Hash(const Midstate& midstate, const std::vector<std::span<const uint8_t>>& suffixes) const
+{
+    std::vector<uint8_t> digests(suffixes.size() * 28);
+    Hash(midstate, suffixes, digests.data());
+    
+    std::vector<std::vector<uint8_t>> result(suffixes.size());
+    for(uint64_t i = 0; i < suffixes.size(); i++)
+        result[i].assign(digests.begin() + static_cast<std::ptrdiff_t>(i * 28), digests.begin() + static_cast<std::ptrdiff_t>((i + 1) * 28));
+    
+    return result;
+}
+
+void BatchHasher<SHA224>::Hash(const Midstate& midstate, const std::span<const uint8_t> suffix, uint8_t* const digest) const
+{
+    if(!digest)
+        throw std::invalid_argument("Digest cannot be nullptr.");
+    
+    if(!suffix.data() && suffix.size() > 0)
+        throw std::invalid_argument("Data cannot be nullptr.");
+    
+    if(midstate.bufferSize >= SHA256_BLOCK_LENGTH)
+        throw std::invalid_argument("Midstate buffer size must be smaller than the block length.");
+    
+    HashMessage(suffix, digest, midstate, 28);
+}
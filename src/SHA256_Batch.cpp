@@ -0,0 +1,1456 @@
+/*
+    The zlib License
+
+    Copyright (C) 2024 Marc Schöndorf
+ 
+This software is provided 'as-is', without any express or implied warranty. In
+no event will the authors be held liable for any damages arising from the use of
+this software.
+
+Permission is granted to anyone to use this software for any purpose, including
+commercial applications, and to alter it and redistribute it freely, subject to
+the following restrictions:
+
+1.  The origin of this software must not be misrepresented; you must not claim
+    that you wrote the original software. If you use this software in a product,
+    an acknowledgment in the product documentation would be appreciated but is
+    not required.
+
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+
+3.  This notice may not be removed or altered from any source distribution.
+*/
+
+
+/*------------------------------------------------------------------*/
+/*                                                                  */
+/*                      (C) 2024 Marc Schöndorf                     */
+/*                            See license                           */
+/*                                                                  */
+/*  SHA256_Batch.cpp                                                */
+/*  Created: 16.10.2026                                             */
+/*------------------------------------------------------------------*/
+
+#include "HashMe.hpp"
+
+using namespace HashMe;
+
+// SHA256 logic functions for the scalar padding block kernel and the precomputed schedule
+inline static constexpr uint32_t Sigma0(const uint32_t x)     { return std::rotr(x, 7) ^ std::rotr(x, 18) ^ (x >> 3); }
+inline static constexpr uint32_t Sigma1(const uint32_t x)     { return std::rotr(x, 17) ^ std::rotr(x, 19) ^ (x >> 10); }
+inline static constexpr uint32_t Epsilon0(const uint32_t x)   { return std::rotr(x, 2) ^ std::rotr(x, 13) ^ std::rotr(x, 22); }
+inline static constexpr uint32_t Epsilon1(const uint32_t x)   { return std::rotr(x, 6) ^ std::rotr(x, 11) ^ std::rotr(x, 25); }
+inline static constexpr uint32_t Majority(const uint32_t x, const uint32_t y, const uint32_t z)   { return (x & y) ^ (x & z) ^ (y & z); }
+inline static constexpr uint32_t Choose(const uint32_t x, const uint32_t y, const uint32_t z)     { return (x & y) ^ (~x & z); }
+
+const std::array<uint32_t, 64> BatchHasher<SHA256>::PAIR_PADDING_BLOCK_WK = []()
+{
+    std::array<uint32_t, 64> W = {};
+    W[0] = 0x80000000;
+    W[15] = 512; // Message length in bits
+    
+    for(uint32_t i = 16; i < 64; i++)
+        W[i] = Sigma1(W[i - 2]) + W[i - 7] + Sigma0(W[i - 15]) + W[i - 16];
+    
+    for(uint32_t i = 0; i < 64; i++)
+        W[i] += Hasher<SHA256, SOFTWARE>::K[i];
+    
+    return W;
+}();
+
+const std::array<uint32_t, 8> BatchHasher<SHA256>::DIGEST_BLOCK_WK = []()
+{
+    std::array<uint32_t, 8> W = { 0x80000000, 0, 0, 0, 0, 0, 0, 256 }; // Message length in bits
+    
+    for(uint32_t i = 0; i < 8; i++)
+        W[i] += Hasher<SHA256, SOFTWARE>::K[8 + i];
+    
+    return W;
+}();
+
+// Reads a digest as state words of one lane. Stride is the distance between two state words
+static void LoadDigest(const uint8_t* const digest, uint32_t* const state, const uint32_t stride)
+{
+    for(uint32_t i = 0; i < 8; i++)
+    {
+#ifdef HM_LITTLE_ENDIAN
+        state[i * stride] = Utils::U8toU32<Utils::REVERSE_ENDIANNESS>(&digest[i << 2]); // Convert to big endian
+#else
+        state[i * stride] = Utils::U8toU32<Utils::KEEP_ENDIANNESS>(&digest[i << 2]);
+#endif
+    }
+}
+
+void BatchHasher<SHA256>::TransformPaddingBlockSoftware(uint32_t* const state)
+{
+    uint32_t a = state[0];
+    uint32_t b = state[1];
+    uint32_t c = state[2];
+    uint32_t d = state[3];
+    uint32_t e = state[4];
+    uint32_t f = state[5];
+    uint32_t g = state[6];
+    uint32_t h = state[7];
+    
+    for(uint32_t i = 0; i < 64; i++)
+    {
+        const uint32_t t1 = h + Epsilon1(e) + Choose(e, f, g) + PAIR_PADDING_BLOCK_WK[i];
+        const uint32_t t2 = Epsilon0(a) + Majority(a, b, c);
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+    
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+}
+
+void BatchHasher<SHA256>::TransformDigestBlockSoftware(uint32_t* const state)
+{
+    const std::array<uint32_t, 64>& K = Hasher<SHA256, SOFTWARE>::K;
+    const std::array<uint32_t, 8>& IV = Hasher<SHA256, SOFTWARE>::INITIAL_HASH_VALUES;
+    
+    // The digest of the first pass are the first 8 message words
+    uint32_t W[64] = {0};
+    std::copy(state, state + 8, W);
+    W[8] = 0x80000000;
+    W[15] = 256;
+    
+    for(uint32_t i = 16; i < 64; i++)
+        W[i] = Sigma1(W[i - 2]) + W[i - 7] + Sigma0(W[i - 15]) + W[i - 16];
+    
+    uint32_t a = IV[0];
+    uint32_t b = IV[1];
+    uint32_t c = IV[2];
+    uint32_t d = IV[3];
+    uint32_t e = IV[4];
+    uint32_t f = IV[5];
+    uint32_t g = IV[6];
+    uint32_t h = IV[7];
+    
+    for(uint32_t i = 0; i < 64; i++)
+    {
+        const uint32_t wk = (i >= 8 && i < 16) ? DIGEST_BLOCK_WK[i - 8] : W[i] + K[i];
+        
+        const uint32_t t1 = h + Epsilon1(e) + Choose(e, f, g) + wk;
+        const uint32_t t2 = Epsilon0(a) + Majority(a, b, c);
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+    
+    state[0] = IV[0] + a;
+    state[1] = IV[1] + b;
+    state[2] = IV[2] + c;
+    state[3] = IV[3] + d;
+    state[4] = IV[4] + e;
+    state[5] = IV[5] + f;
+    state[6] = IV[6] + g;
+    state[7] = IV[7] + h;
+    
+    // Cleanup sensitive data for security
+#ifdef HM_CLEANUP_TMP_MEMORY_AFTER_HASHING_FOR_SECURITY
+    std::memset(W, 0, sizeof(W));
+#endif
+}
+
+#if defined(HM_SIMD_X86)
+// ***************************************************
+// AVX2 helpers, every vector holds the same word of 8 different messages
+template <int N>
+HM_TARGET("avx2") static inline __m256i Rotr32x8(const __m256i x)
+{
+    return _mm256_or_si256(_mm256_srli_epi32(x, N), _mm256_slli_epi32(x, 32 - N));
+}
+
+HM_TARGET("avx2") static inline __m256i Sigma0x8(const __m256i x)
+{
+    return _mm256_xor_si256(_mm256_xor_si256(Rotr32x8<7>(x), Rotr32x8<18>(x)), _mm256_srli_epi32(x, 3));
+}
+
+HM_TARGET("avx2") static inline __m256i Sigma1x8(const __m256i x)
+{
+    return _mm256_xor_si256(_mm256_xor_si256(Rotr32x8<17>(x), Rotr32x8<19>(x)), _mm256_srli_epi32(x, 10));
+}
+
+HM_TARGET("avx2") static inline __m256i Epsilon0x8(const __m256i x)
+{
+    return _mm256_xor_si256(_mm256_xor_si256(Rotr32x8<2>(x), Rotr32x8<13>(x)), Rotr32x8<22>(x));
+}
+
+HM_TARGET("avx2") static inline __m256i Epsilon1x8(const __m256i x)
+{
+    return _mm256_xor_si256(_mm256_xor_si256(Rotr32x8<6>(x), Rotr32x8<11>(x)), Rotr32x8<25>(x));
+}
+
+HM_TARGET("avx2") static inline __m256i Add3x8(const __m256i a, const __m256i b, const __m256i c)
+{
+    return _mm256_add_epi32(_mm256_add_epi32(a, b), c);
+}
+
+// One SHA256 round for 8 lanes. The caller rotates the variables instead of moving them
+HM_TARGET("avx2") static inline void Roundx8(const __m256i a, const __m256i b, const __m256i c, __m256i& d,
+                                             const __m256i e, const __m256i f, const __m256i g, __m256i& h, const __m256i wk)
+{
+    const __m256i choose = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+    const __m256i majority = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b)));
+    
+    const __m256i t1 = _mm256_add_epi32(Add3x8(h, Epsilon1x8(e), choose), wk);
+    const __m256i t2 = _mm256_add_epi32(Epsilon0x8(a), majority);
+    
+    d = _mm256_add_epi32(d, t1);
+    h = _mm256_add_epi32(t1, t2);
+}
+
+// Loads 32 bytes from each of the 8 lanes and transposes them, so that out[i] holds word i of all lanes
+HM_TARGET("avx2") static inline void LoadTransposed8x8(const uint8_t* const* const data, const uint64_t offset, __m256i out[8])
+{
+    const __m256i MASK = _mm256_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL, 0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    
+    __m256i rows[8];
+    for(uint32_t i = 0; i < 8; i++)
+        rows[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data[i] + offset));
+    
+    const __m256i t0 = _mm256_unpacklo_epi32(rows[0], rows[1]);
+    const __m256i t1 = _mm256_unpackhi_epi32(rows[0], rows[1]);
+    const __m256i t2 = _mm256_unpacklo_epi32(rows[2], rows[3]);
+    const __m256i t3 = _mm256_unpackhi_epi32(rows[2], rows[3]);
+    const __m256i t4 = _mm256_unpacklo_epi32(rows[4], rows[5]);
+    const __m256i t5 = _mm256_unpackhi_epi32(rows[4], rows[5]);
+    const __m256i t6 = _mm256_unpacklo_epi32(rows[6], rows[7]);
+    const __m256i t7 = _mm256_unpackhi_epi32(rows[6], rows[7]);
+    
+    const __m256i u0 = _mm256_unpacklo_epi64(t0, t2);
+    const __m256i u1 = _mm256_unpackhi_epi64(t0, t2);
+    const __m256i u2 = _mm256_unpacklo_epi64(t1, t3);
+    const __m256i u3 = _mm256_unpackhi_epi64(t1, t3);
+    const __m256i u4 = _mm256_unpacklo_epi64(t4, t6);
+    const __m256i u5 = _mm256_unpackhi_epi64(t4, t6);
+    const __m256i u6 = _mm256_unpacklo_epi64(t5, t7);
+    const __m256i u7 = _mm256_unpackhi_epi64(t5, t7);
+    
+    // Convert to big endian
+    out[0] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u0, u4, 0x20), MASK);
+    out[1] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u1, u5, 0x20), MASK);
+    out[2] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u2, u6, 0x20), MASK);
+    out[3] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u3, u7, 0x20), MASK);
+    out[4] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u0, u4, 0x31), MASK);
+    out[5] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u1, u5, 0x31), MASK);
+    out[6] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u2, u6, 0x31), MASK);
+    out[7] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u3, u7, 0x31), MASK);
+}
+
+// Compresses one block for all lanes. W holds the message words and is overwritten by the message schedule
+HM_TARGET("avx2") static inline void CompressBlockx8(__m256i& a, __m256i& b, __m256i& c, __m256i& d, __m256i& e, __m256i& f, __m256i& g, __m256i& h, __m256i (&W)[16], const uint32_t* const K)
+{
+    // Save current state
+    const __m256i aSave = a;
+    const __m256i bSave = b;
+    const __m256i cSave = c;
+    const __m256i dSave = d;
+    const __m256i eSave = e;
+    const __m256i fSave = f;
+    const __m256i gSave = g;
+    const __m256i hSave = h;
+    
+    for(uint32_t i = 0; i < 64; i += 8)
+    {
+        if(i >= 16)
+        {
+            // Message schedule for the next 8 rounds
+            for(uint32_t j = i; j < i + 8; j++)
+                W[j & 0x0F] = _mm256_add_epi32(Add3x8(W[j & 0x0F], W[(j + 9) & 0x0F], Sigma0x8(W[(j + 1) & 0x0F])), Sigma1x8(W[(j + 14) & 0x0F]));
+        }
+        
+        Roundx8(a, b, c, d, e, f, g, h, _mm256_add_epi32(W[(i + 0) & 0x0F], _mm256_set1_epi32(static_cast<int32_t>(K[i + 0]))));
+        Roundx8(h, a, b, c, d, e, f, g, _mm256_add_epi32(W[(i + 1) & 0x0F], _mm256_set1_epi32(static_cast<int32_t>(K[i + 1]))));
+        Roundx8(g, h, a, b, c, d, e, f, _mm256_add_epi32(W[(i + 2) & 0x0F], _mm256_set1_epi32(static_cast<int32_t>(K[i + 2]))));
+        Roundx8(f, g, h, a, b, c, d, e, _mm256_add_epi32(W[(i + 3) & 0x0F], _mm256_set1_epi32(static_cast<int32_t>(K[i + 3]))));
+        Roundx8(e, f, g, h, a, b, c, d, _mm256_add_epi32(W[(i + 4) & 0x0F], _mm256_set1_epi32(static_cast<int32_t>(K[i + 4]))));
+        Roundx8(d, e, f, g, h, a, b, c, _mm256_add_epi32(W[(i + 5) & 0x0F], _mm256_set1_epi32(static_cast<int32_t>(K[i + 5]))));
+        Roundx8(c, d, e, f, g, h, a, b, _mm256_add_epi32(W[(i + 6) & 0x0F], _mm256_set1_epi32(static_cast<int32_t>(K[i + 6]))));
+        Roundx8(b, c, d, e, f, g, h, a, _mm256_add_epi32(W[(i + 7) & 0x0F], _mm256_set1_epi32(static_cast<int32_t>(K[i + 7]))));
+    }
+    
+    // Combine states
+    a = _mm256_add_epi32(a, aSave);
+    b = _mm256_add_epi32(b, bSave);
+    c = _mm256_add_epi32(c, cSave);
+    d = _mm256_add_epi32(d, dSave);
+    e = _mm256_add_epi32(e, eSave);
+    f = _mm256_add_epi32(f, fSave);
+    g = _mm256_add_epi32(g, gSave);
+    h = _mm256_add_epi32(h, hSave);
+}
+
+HM_TARGET("avx2") void BatchHasher<SHA256>::TransformAVX2x8(uint32_t* const state, const uint8_t* const* const data, const uint64_t numOfBlocks)
+{
+    // Load state, it stays in registers for all blocks
+    __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&state[0 * 8]));
+    __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&state[1 * 8]));
+    __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&state[2 * 8]));
+    __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&state[3 * 8]));
+    __m256i e = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&state[4 * 8]));
+    __m256i f = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&state[5 * 8]));
+    __m256i g = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&state[6 * 8]));
+    __m256i h = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&state[7 * 8]));
+    
+    __m256i W[16];
+    
+    for(uint64_t n = 0; n < numOfBlocks; n++)
+    {
+        const uint64_t offset = n * SHA256_BLOCK_LENGTH;
+        
+        LoadTransposed8x8(data, offset, &W[0]);
+        LoadTransposed8x8(data, offset + 32, &W[8]);
+        
+        CompressBlockx8(a, b, c, d, e, f, g, h, W, Hasher<SHA256, SOFTWARE>::K.data());
+    }
+    
+    // Save the new state
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&state[0 * 8]), a);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&state[1 * 8]), b);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&state[2 * 8]), c);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&state[3 * 8]), d);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&state[4 * 8]), e);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&state[5 * 8]), f);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&state[6 * 8]), g);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&state[7 * 8]), h);
+    
+    // Cleanup sensitive data for security
+#ifdef HM_CLEANUP_TMP_MEMORY_AFTER_HASHING_FOR_SECURITY
+    for(uint32_t i = 0; i < 16; i++)
+        W[i] = _mm256_setzero_si256();
+#endif
+}
+
+// The schedule of the padding block is the same for all lanes, only the rounds remain
+HM_TARGET("avx2") void BatchHasher<SHA256>::TransformPaddingBlockAVX2x8(uint32_t* const state)
+{
+    __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&state[0 * 8]));
+    __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&state[1 * 8]));
+    __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&state[2 * 8]));
+    __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&state[3 * 8]));
+    __m256i e = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&state[4 * 8]));
+    __m256i f = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&state[5 * 8]));
+    __m256i g = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&state[6 * 8]));
+    __m256i h = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&state[7 * 8]));
+    
+    const __m256i aSave = a;
+    const __m256i bSave = b;
+    const __m256i cSave = c;
+    const __m256i dSave = d;
+    const __m256i eSave = e;
+    const __m256i fSave = f;
+    const __m256i gSave = g;
+    const __m256i hSave = h;
+    
+    for(uint32_t i = 0; i < 64; i += 8)
+    {
+        Roundx8(a, b, c, d, e, f, g, h, _mm256_set1_epi32(static_cast<int32_t>(PAIR_PADDING_BLOCK_WK[i + 0])));
+        Roundx8(h, a, b, c, d, e, f, g, _mm256_set1_epi32(static_cast<int32_t>(PAIR_PADDING_BLOCK_WK[i + 1])));
+        Roundx8(g, h, a, b, c, d, e, f, _mm256_set1_epi32(static_cast<int32_t>(PAIR_PADDING_BLOCK_WK[i + 2])));
+        Roundx8(f, g, h, a, b, c, d, e, _mm256_set1_epi32(static_cast<int32_t>(PAIR_PADDING_BLOCK_WK[i + 3])));
+        Roundx8(e, f, g, h, a, b, c, d, _mm256_set1_epi32(static_cast<int32_t>(PAIR_PADDING_BLOCK_WK[i + 4])));
+        Roundx8(d, e, f, g, h, a, b, c, _mm256_set1_epi32(static_cast<int32_t>(PAIR_PADDING_BLOCK_WK[i + 5])));
+        Roundx8(c, d, e, f, g, h, a, b, _mm256_set1_epi32(static_cast<int32_t>(PAIR_PADDING_BLOCK_WK[i + 6])));
+        Roundx8(b, c, d, e, f, g, h, a, _mm256_set1_epi32(static_cast<int32_t>(PAIR_PADDING_BLOCK_WK[i + 7])));
+    }
+    
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&state[0 * 8]), _mm256_add_epi32(a, aSave));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&state[1 * 8]), _mm256_add_epi32(b, bSave));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&state[2 * 8]), _mm256_add_epi32(c, cSave));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&state[3 * 8]), _mm256_add_epi32(d, dSave));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&state[4 * 8]), _mm256_add_epi32(e, eSave));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&state[5 * 8]), _mm256_add_epi32(f, fSave));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&state[6 * 8]), _mm256_add_epi32(g, gSave));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&state[7 * 8]), _mm256_add_epi32(h, hSave));
+}
+
+// The first pass leaves the digest words in the state, they are the first 8 message words of the second pass
+HM_TARGET("avx2") void BatchHasher<SHA256>::TransformDigestBlockAVX2x8(uint32_t* const state)
+{
+    const std::array<uint32_t, 8>& IV = Hasher<SHA256, SOFTWARE>::INITIAL_HASH_VALUES;
+    
+    __m256i W[16];
+    for(uint32_t i = 0; i < 8; i++)
+        W[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&state[i * 8]));
+    
+    W[8] = _mm256_set1_epi32(static_cast<int32_t>(0x80000000));
+    for(uint32_t i = 9; i < 15; i++)
+        W[i] = _mm256_setzero_si256();
+    W[15] = _mm256_set1_epi32(256); // Message length in bits
+    
+    __m256i a = _mm256_set1_epi32(static_cast<int32_t>(IV[0]));
+    __m256i b = _mm256_set1_epi32(static_cast<int32_t>(IV[1]));
+    __m256i c = _mm256_set1_epi32(static_cast<int32_t>(IV[2]));
+    __m256i d = _mm256_set1_epi32(static_cast<int32_t>(IV[3]));
+    __m256i e = _mm256_set1_epi32(static_cast<int32_t>(IV[4]));
+    __m256i f = _mm256_set1_epi32(static_cast<int32_t>(IV[5]));
+    __m256i g = _mm256_set1_epi32(static_cast<int32_t>(IV[6]));
+    __m256i h = _mm256_set1_epi32(static_cast<int32_t>(IV[7]));
+    
+    CompressBlockx8(a, b, c, d, e, f, g, h, W, Hasher<SHA256, SOFTWARE>::K.data());
+    
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&state[0 * 8]), a);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&state[1 * 8]), b);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&state[2 * 8]), c);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&state[3 * 8]), d);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&state[4 * 8]), e);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&state[5 * 8]), f);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&state[6 * 8]), g);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&state[7 * 8]), h);
+    
+    // Cleanup sensitive data for security
+#ifdef HM_CLEANUP_TMP_MEMORY_AFTER_HASHING_FOR_SECURITY
+    for(uint32_t i = 0; i < 16; i++)
+        W[i] = _mm256_setzero_si256();
+#endif
+}
+
+// GCC implements _mm512_undefined_epi32() as a self initialized variable, so every inlined vprord and vpternlogd
+// below triggers a false positive uninitialized warning
+#if defined(HASH_PREDEF_COMP_GNUC_AVAILABLE) && !defined(HASH_PREDEF_COMP_CLANG_AVAILABLE) // GCC
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+// ***************************************************
+// AVX-512 helpers, every vector holds the same word of 16 different messages. Uses vprord for the rotations
+// and vpternlogd for the three input logic functions
+HM_TARGET("avx512f") static inline __m512i Sigma0x16(const __m512i x)
+{
+    return _mm512_ternarylogic_epi32(_mm512_ror_epi32(x, 7), _mm512_ror_epi32(x, 18), _mm512_srli_epi32(x, 3), 0x96); // XOR
+}
+
+HM_TARGET("avx512f") static inline __m512i Sigma1x16(const __m512i x)
+{
+    return _mm512_ternarylogic_epi32(_mm512_ror_epi32(x, 17), _mm512_ror_epi32(x, 19), _mm512_srli_epi32(x, 10), 0x96); // XOR
+}
+
+HM_TARGET("avx512f") static inline __m512i Epsilon0x16(const __m512i x)
+{
+    return _mm512_ternarylogic_epi32(_mm512_ror_epi32(x, 2), _mm512_ror_epi32(x, 13), _mm512_ror_epi32(x, 22), 0x96); // XOR
+}
+
+HM_TARGET("avx512f") static inline __m512i Epsilon1x16(const __m512i x)
+{
+    return _mm512_ternarylogic_epi32(_mm512_ror_epi32(x, 6), _mm512_ror_epi32(x, 11), _mm512_ror_epi32(x, 25), 0x96); // XOR
+}
+
+// One SHA256 round for 16 lanes. The caller rotates the variables instead of moving them
+HM_TARGET("avx512f") static inline void Roundx16(const __m512i a, const __m512i b, const __m512i c, __m512i& d,
+                                                 const __m512i e, const __m512i f, const __m512i g, __m512i& h, const __m512i wk)
+{
+    const __m512i choose = _mm512_ternarylogic_epi32(e, f, g, 0xCA);
+    const __m512i majority = _mm512_ternarylogic_epi32(a, b, c, 0xE8);
+    
+    const __m512i t1 = _mm512_add_epi32(_mm512_add_epi32(h, Epsilon1x16(e)), _mm512_add_epi32(choose, wk));
+    const __m512i t2 = _mm512_add_epi32(Epsilon0x16(a), majority);
+    
+    d = _mm512_add_epi32(d, t1);
+    h = _mm512_add_epi32(t1, t2);
+}
+
+// Loads one block from each of the 16 lanes and transposes them, so that out[i] holds word i of all lanes
+HM_TARGET("avx512f,avx512bw") static inline void LoadTransposed16x16(const uint8_t* const* const data, const uint64_t offset, __m512i out[16])
+{
+    const __m512i MASK = _mm512_set_epi64(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL, 0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL,
+                                          0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL, 0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    
+    __m512i rows[16];
+    for(uint32_t i = 0; i < 16; i++)
+        rows[i] = _mm512_loadu_si512(data[i] + offset);
+    
+    // 4x4 transposes inside the 128 bit chunks of each group of 4 lanes
+    __m512i chunks[16];
+    for(uint32_t i = 0; i < 16; i += 4)
+    {
+        const __m512i t0 = _mm512_unpacklo_epi32(rows[i + 0], rows[i + 1]);
+        const __m512i t1 = _mm512_unpackhi_epi32(rows[i + 0], rows[i + 1]);
+        const __m512i t2 = _mm512_unpacklo_epi32(rows[i + 2], rows[i + 3]);
+        const __m512i t3 = _mm512_unpackhi_epi32(rows[i + 2], rows[i + 3]);
+        
+        chunks[i + 0] = _mm512_unpacklo_epi64(t0, t2);
+        chunks[i + 1] = _mm512_unpackhi_epi64(t0, t2);
+        chunks[i + 2] = _mm512_unpacklo_epi64(t1, t3);
+        chunks[i + 3] = _mm512_unpackhi_epi64(t1, t3);
+    }
+    
+    // Transpose the 128 bit chunks across the 4 groups
+    for(uint32_t j = 0; j < 4; j++)
+    {
+        const __m512i x0 = _mm512_shuffle_i32x4(chunks[j], chunks[4 + j], 0x44);
+        const __m512i x1 = _mm512_shuffle_i32x4(chunks[j], chunks[4 + j], 0xEE);
+        const __m512i x2 = _mm512_shuffle_i32x4(chunks[8 + j], chunks[12 + j], 0x44);
+        const __m512i x3 = _mm512_shuffle_i32x4(chunks[8 + j], chunks[12 + j], 0xEE);
+        
+        // Convert to big endian
+        out[0 + j] = _mm512_shuffle_epi8(_mm512_shuffle_i32x4(x0, x2, 0x88), MASK);
+        out[4 + j] = _mm512_shuffle_epi8(_mm512_shuffle_i32x4(x0, x2, 0xDD), MASK);
+        out[8 + j] = _mm512_shuffle_epi8(_mm512_shuffle_i32x4(x1, x3, 0x88), MASK);
+        out[12 + j] = _mm512_shuffle_epi8(_mm512_shuffle_i32x4(x1, x3, 0xDD), MASK);
+    }
+}
+
+// Compresses one block for all lanes. W holds the message words and is overwritten by the message schedule
+HM_TARGET("avx512f") static inline void CompressBlockx16(__m512i& a, __m512i& b, __m512i& c, __m512i& d, __m512i& e, __m512i& f, __m512i& g, __m512i& h, __m512i (&W)[16], const uint32_t* const K)
+{
+    // Save current state
+    const __m512i aSave = a;
+    const __m512i bSave = b;
+    const __m512i cSave = c;
+    const __m512i dSave = d;
+    const __m512i eSave = e;
+    const __m512i fSave = f;
+    const __m512i gSave = g;
+    const __m512i hSave = h;
+    
+    for(uint32_t i = 0; i < 64; i += 8)
+    {
+        if(i >= 16)
+        {
+            // Message schedule for the next 8 rounds
+            for(uint32_t j = i; j < i + 8; j++)
+                W[j & 0x0F] = _mm512_add_epi32(_mm512_add_epi32(W[j & 0x0F], W[(j + 9) & 0x0F]), _mm512_add_epi32(Sigma0x16(W[(j + 1) & 0x0F]), Sigma1x16(W[(j + 14) & 0x0F])));
+        }
+        
+        Roundx16(a, b, c, d, e, f, g, h, _mm512_add_epi32(W[(i + 0) & 0x0F], _mm512_set1_epi32(static_cast<int32_t>(K[i + 0]))));
+        Roundx16(h, a, b, c, d, e, f, g, _mm512_add_epi32(W[(i + 1) & 0x0F], _mm512_set1_epi32(static_cast<int32_t>(K[i + 1]))));
+        Roundx16(g, h, a, b, c, d, e, f, _mm512_add_epi32(W[(i + 2) & 0x0F], _mm512_set1_epi32(static_cast<int32_t>(K[i + 2]))));
+        Roundx16(f, g, h, a, b, c, d, e, _mm512_add_epi32(W[(i + 3) & 0x0F], _mm512_set1_epi32(static_cast<int32_t>(K[i + 3]))));
+        Roundx16(e, f, g, h, a, b, c, d, _mm512_add_epi32(W[(i + 4) & 0x0F], _mm512_set1_epi32(static_cast<int32_t>(K[i + 4]))));
+        Roundx16(d, e, f, g, h, a, b, c, _mm512_add_epi32(W[(i + 5) & 0x0F], _mm512_set1_epi32(static_cast<int32_t>(K[i + 5]))));
+        Roundx16(c, d, e, f, g, h, a, b, _mm512_add_epi32(W[(i + 6) & 0x0F], _mm512_set1_epi32(static_cast<int32_t>(K[i + 6]))));
+        Roundx16(b, c, d, e, f, g, h, a, _mm512_add_epi32(W[(i + 7) & 0x0F], _mm512_set1_epi32(static_cast<int32_t>(K[i + 7]))));
+    }
+    
+    // Combine states
+    a = _mm512_add_epi32(a, aSave);
+    b = _mm512_add_epi32(b, bSave);
+    c = _mm512_add_epi32(c, cSave);
+    d = _mm512_add_epi32(d, dSave);
+    e = _mm512_add_epi32(e, eSave);
+    f = _mm512_add_epi32(f, fSave);
+    g = _mm512_add_epi32(g, gSave);
+    h = _mm512_add_epi32(h, hSave);
+}
+
+HM_TARGET("avx512f,avx512bw") void BatchHasher<SHA256>::TransformAVX512x16(uint32_t* const state, const uint8_t* const* const data, const uint64_t numOfBlocks)
+{
+    // Load state, it stays in registers for all blocks
+    __m512i a = _mm512_loadu_si512(&state[0 * 16]);
+    __m512i b = _mm512_loadu_si512(&state[1 * 16]);
+    __m512i c = _mm512_loadu_si512(&state[2 * 16]);
+    __m512i d = _mm512_loadu_si512(&state[3 * 16]);
+    __m512i e = _mm512_loadu_si512(&state[4 * 16]);
+    __m512i f = _mm512_loadu_si512(&state[5 * 16]);
+    __m512i g = _mm512_loadu_si512(&state[6 * 16]);
+    __m512i h = _mm512_loadu_si512(&state[7 * 16]);
+    
+    __m512i W[16];
+    
+    for(uint64_t n = 0; n < numOfBlocks; n++)
+    {
+        LoadTransposed16x16(data, n * SHA256_BLOCK_LENGTH, W);
+        
+        CompressBlockx16(a, b, c, d, e, f, g, h, W, Hasher<SHA256, SOFTWARE>::K.data());
+    }
+    
+    // Save the new state
+    _mm512_storeu_si512(&state[0 * 16], a);
+    _mm512_storeu_si512(&state[1 * 16], b);
+    _mm512_storeu_si512(&state[2 * 16], c);
+    _mm512_storeu_si512(&state[3 * 16], d);
+    _mm512_storeu_si512(&state[4 * 16], e);
+    _mm512_storeu_si512(&state[5 * 16], f);
+    _mm512_storeu_si512(&state[6 * 16], g);
+    _mm512_storeu_si512(&state[7 * 16], h);
+    
+    // Cleanup sensitive data for security
+#ifdef HM_CLEANUP_TMP_MEMORY_AFTER_HASHING_FOR_SECURITY
+    for(uint32_t i = 0; i < 16; i++)
+        W[i] = _mm512_setzero_si512();
+#endif
+}
+
+// The schedule of the padding block is the same for all lanes, only the rounds remain
+HM_TARGET("avx512f") void BatchHasher<SHA256>::TransformPaddingBlockAVX512x16(uint32_t* const state)
+{
+    __m512i a = _mm512_loadu_si512(&state[0 * 16]);
+    __m512i b = _mm512_loadu_si512(&state[1 * 16]);
+    __m512i c = _mm512_loadu_si512(&state[2 * 16]);
+    __m512i d = _mm512_loadu_si512(&state[3 * 16]);
+    __m512i e = _mm512_loadu_si512(&state[4 * 16]);
+    __m512i f = _mm512_loadu_si512(&state[5 * 16]);
+    __m512i g = _mm512_loadu_si512(&state[6 * 16]);
+    __m512i h = _mm512_loadu_si512(&state[7 * 16]);
+    
+    const __m512i aSave = a;
+    const __m512i bSave = b;
+    const __m512i cSave = c;
+    const __m512i dSave = d;
+    const __m512i eSave = e;
+    const __m512i fSave = f;
+    const __m512i gSave = g;
+    const __m512i hSave = h;
+    
+    for(uint32_t i = 0; i < 64; i += 8)
+    {
+        Roundx16(a, b, c, d, e, f, g, h, _mm512_set1_epi32(static_cast<int32_t>(PAIR_PADDING_BLOCK_WK[i + 0])));
+        Roundx16(h, a, b, c, d, e, f, g, _mm512_set1_epi32(static_cast<int32_t>(PAIR_PADDING_BLOCK_WK[i + 1])));
+        Roundx16(g, h, a, b, c, d, e, f, _mm512_set1_epi32(static_cast<int32_t>(PAIR_PADDING_BLOCK_WK[i + 2])));
+        Roundx16(f, g, h, a, b, c, d, e, _mm512_set1_epi32(static_cast<int32_t>(PAIR_PADDING_BLOCK_WK[i + 3])));
+        Roundx16(e, f, g, h, a, b, c, d, _mm512_set1_epi32(static_cast<int32_t>(PAIR_PADDING_BLOCK_WK[i + 4])));
+        Roundx16(d, e, f, g, h, a, b, c, _mm512_set1_epi32(static_cast<int32_t>(PAIR_PADDING_BLOCK_WK[i + 5])));
+        Roundx16(c, d, e, f, g, h, a, b, _mm512_set1_epi32(static_cast<int32_t>(PAIR_PADDING_BLOCK_WK[i + 6])));
+        Roundx16(b, c, d, e, f, g, h, a, _mm512_set1_epi32(static_cast<int32_t>(PAIR_PADDING_BLOCK_WK[i + 7])));
+    }
+    
+    _mm512_storeu_si512(&state[0 * 16], _mm512_add_epi32(a, aSave));
+    _mm512_storeu_si512(&state[1 * 16], _mm512_add_epi32(b, bSave));
+    _mm512_storeu_si512(&state[2 * 16], _mm512_add_epi32(c, cSave));
+    _mm512_storeu_si512(&state[3 * 16], _mm512_add_epi32(d, dSave));
+    _mm512_storeu_si512(&state[4 * 16], _mm512_add_epi32(e, eSave));
+    _mm512_storeu_si512(&state[5 * 16], _mm512_add_epi32(f, fSave));
+    _mm512_storeu_si512(&state[6 * 16], _mm512_add_epi32(g, gSave));
+    _mm512_storeu_si512(&state[7 * 16], _mm512_add_epi32(h, hSave));
+}
+
+// The first pass leaves the digest words in the state, they are the first 8 message words of the second pass
+HM_TARGET("avx512f") void BatchHasher<SHA256>::TransformDigestBlockAVX512x16(uint32_t* const state)
+{
+    const std::array<uint32_t, 8>& IV = Hasher<SHA256, SOFTWARE>::INITIAL_HASH_VALUES;
+    
+    __m512i W[16];
+    for(uint32_t i = 0; i < 8; i++)
+        W[i] = _mm512_loadu_si512(&state[i * 16]);
+    
+    W[8] = _mm512_set1_epi32(static_cast<int32_t>(0x80000000));
+    for(uint32_t i = 9; i < 15; i++)
+        W[i] = _mm512_setzero_si512();
+    W[15] = _mm512_set1_epi32(256); // Message length in bits
+    
+    __m512i a = _mm512_set1_epi32(static_cast<int32_t>(IV[0]));
+    __m512i b = _mm512_set1_epi32(static_cast<int32_t>(IV[1]));
+    __m512i c = _mm512_set1_epi32(static_cast<int32_t>(IV[2]));
+    __m512i d = _mm512_set1_epi32(static_cast<int32_t>(IV[3]));
+    __m512i e = _mm512_set1_epi32(static_cast<int32_t>(IV[4]));
+    __m512i f = _mm512_set1_epi32(static_cast<int32_t>(IV[5]));
+    __m512i g = _mm512_set1_epi32(static_cast<int32_t>(IV[6]));
+    __m512i h = _mm512_set1_epi32(static_cast<int32_t>(IV[7]));
+    
+    CompressBlockx16(a, b, c, d, e, f, g, h, W, Hasher<SHA256, SOFTWARE>::K.data());
+    
+    _mm512_storeu_si512(&state[0 * 16], a);
+    _mm512_storeu_si512(&state[1 * 16], b);
+    _mm512_storeu_si512(&state[2 * 16], c);
+    _mm512_storeu_si512(&state[3 * 16], d);
+    _mm512_storeu_si512(&state[4 * 16], e);
+    _mm512_storeu_si512(&state[5 * 16], f);
+    _mm512_storeu_si512(&state[6 * 16], g);
+    _mm512_storeu_si512(&state[7 * 16], h);
+    
+    // Cleanup sensitive data for security
+#ifdef HM_CLEANUP_TMP_MEMORY_AFTER_HASHING_FOR_SECURITY
+    for(uint32_t i = 0; i < 16; i++)
+        W[i] = _mm512_setzero_si512();
+#endif
+}
+
+#if defined(HASH_PREDEF_COMP_GNUC_AVAILABLE) && !defined(HASH_PREDEF_COMP_CLANG_AVAILABLE) // GCC
+#pragma GCC diagnostic pop
+#endif
+
+// ***************************************************
+// SHA-NI helpers for interleaving several independent messages. Every stage is issued for all lanes before
+// the next one, so the latency of the sha256rnds2 dependency chain of one message is hidden by the others
+template <uint32_t QUAD_ROUND, uint32_t NUM_OF_LANES>
+HM_TARGET("sse4.1,sha") static inline void QuadRoundSHA(__m128i (&state0)[NUM_OF_LANES], __m128i (&state1)[NUM_OF_LANES], __m128i (&msg)[4][NUM_OF_LANES], const uint32_t* const K)
+{
+    constexpr uint32_t CURRENT = QUAD_ROUND % 4;
+    constexpr uint32_t NEXT = (QUAD_ROUND + 1) % 4;
+    constexpr uint32_t PREVIOUS = (QUAD_ROUND + 3) % 4;
+    
+    const __m128i k = _mm_loadu_si128(reinterpret_cast<const __m128i*>(K + 4 * QUAD_ROUND));
+    __m128i wk[NUM_OF_LANES];
+    
+    for(uint32_t i = 0; i < NUM_OF_LANES; i++)
+    {
+        wk[i] = _mm_add_epi32(msg[CURRENT][i], k);
+        state1[i] = _mm_sha256rnds2_epu32(state1[i], state0[i], wk[i]);
+    }
+    
+    // Message schedule
+    if constexpr (QUAD_ROUND >= 3 && QUAD_ROUND < 15)
+    {
+        for(uint32_t i = 0; i < NUM_OF_LANES; i++)
+        {
+            const __m128i tmp = _mm_alignr_epi8(msg[CURRENT][i], msg[PREVIOUS][i], 4);
+            msg[NEXT][i] = _mm_sha256msg2_epu32(_mm_add_epi32(msg[NEXT][i], tmp), msg[CURRENT][i]);
+        }
+    }
+    
+    for(uint32_t i = 0; i < NUM_OF_LANES; i++)
+        state0[i] = _mm_sha256rnds2_epu32(state0[i], state1[i], _mm_shuffle_epi32(wk[i], 0x0E));
+    
+    if constexpr (QUAD_ROUND >= 1 && QUAD_ROUND < 13)
+    {
+        for(uint32_t i = 0; i < NUM_OF_LANES; i++)
+            msg[PREVIOUS][i] = _mm_sha256msg1_epu32(msg[PREVIOUS][i], msg[CURRENT][i]);
+    }
+}
+
+// Loads the state of each lane as ABEF/CDGH
+template <uint32_t NUM_OF_LANES>
+HM_TARGET("sse4.1,sha") static inline void LoadStateSHA(const uint32_t* const state, __m128i (&state0)[NUM_OF_LANES], __m128i (&state1)[NUM_OF_LANES])
+{
+    for(uint32_t i = 0; i < NUM_OF_LANES; i++)
+    {
+        const __m128i abcd = _mm_set_epi32(static_cast<int32_t>(state[3 * NUM_OF_LANES + i]), static_cast<int32_t>(state[2 * NUM_OF_LANES + i]),
+                                           static_cast<int32_t>(state[1 * NUM_OF_LANES + i]), static_cast<int32_t>(state[0 * NUM_OF_LANES + i]));
+        const __m128i efgh = _mm_set_epi32(static_cast<int32_t>(state[7 * NUM_OF_LANES + i]), static_cast<int32_t>(state[6 * NUM_OF_LANES + i]),
+                                           static_cast<int32_t>(state[5 * NUM_OF_LANES + i]), static_cast<int32_t>(state[4 * NUM_OF_LANES + i]));
+        
+        const __m128i cdab = _mm_shuffle_epi32(abcd, 0xB1);
+        const __m128i hgfe = _mm_shuffle_epi32(efgh, 0x1B);
+        state0[i] = _mm_alignr_epi8(cdab, hgfe, 8);     // ABEF
+        state1[i] = _mm_blend_epi16(hgfe, cdab, 0xF0);  // CDGH
+    }
+}
+
+template <uint32_t NUM_OF_LANES>
+HM_TARGET("sse4.1,sha") static inline void StoreStateSHA(uint32_t* const state, const __m128i (&state0)[NUM_OF_LANES], const __m128i (&state1)[NUM_OF_LANES])
+{
+    for(uint32_t i = 0; i < NUM_OF_LANES; i++)
+    {
+        const __m128i feba = _mm_shuffle_epi32(state0[i], 0x1B);
+        const __m128i dchg = _mm_shuffle_epi32(state1[i], 0xB1);
+        
+        alignas(16) uint32_t words[8];
+        _mm_store_si128(reinterpret_cast<__m128i*>(&words[0]), _mm_blend_epi16(feba, dchg, 0xF0)); // ABCD
+        _mm_store_si128(reinterpret_cast<__m128i*>(&words[4]), _mm_alignr_epi8(dchg, feba, 8));    // EFGH
+        
+        for(uint32_t j = 0; j < 8; j++)
+            state[j * NUM_OF_LANES + i] = words[j];
+    }
+}
+
+// Compresses one block for all lanes. msg holds the message words and is overwritten by the message schedule
+template <uint32_t NUM_OF_LANES>
+HM_TARGET("sse4.1,sha") static inline void CompressBlockSHA(__m128i (&state0)[NUM_OF_LANES], __m128i (&state1)[NUM_OF_LANES], __m128i (&msg)[4][NUM_OF_LANES], const uint32_t* const K)
+{
+    __m128i abefSave[NUM_OF_LANES];
+    __m128i cdghSave[NUM_OF_LANES];
+    
+    // Save current state
+    for(uint32_t i = 0; i < NUM_OF_LANES; i++)
+    {
+        abefSave[i] = state0[i];
+        cdghSave[i] = state1[i];
+    }
+    
+    QuadRoundSHA<0>(state0, state1, msg, K);
+    QuadRoundSHA<1>(state0, state1, msg, K);
+    QuadRoundSHA<2>(state0, state1, msg, K);
+    QuadRoundSHA<3>(state0, state1, msg, K);
+    QuadRoundSHA<4>(state0, state1, msg, K);
+    QuadRoundSHA<5>(state0, state1, msg, K);
+    QuadRoundSHA<6>(state0, state1, msg, K);
+    QuadRoundSHA<7>(state0, state1, msg, K);
+    QuadRoundSHA<8>(state0, state1, msg, K);
+    QuadRoundSHA<9>(state0, state1, msg, K);
+    QuadRoundSHA<10>(state0, state1, msg, K);
+    QuadRoundSHA<11>(state0, state1, msg, K);
+    QuadRoundSHA<12>(state0, state1, msg, K);
+    QuadRoundSHA<13>(state0, state1, msg, K);
+    QuadRoundSHA<14>(state0, state1, msg, K);
+    QuadRoundSHA<15>(state0, state1, msg, K);
+    
+    // Combine states
+    for(uint32_t i = 0; i < NUM_OF_LANES; i++)
+    {
+        state0[i] = _mm_add_epi32(state0[i], abefSave[i]);
+        state1[i] = _mm_add_epi32(state1[i], cdghSave[i]);
+    }
+}
+
+template <uint32_t NUM_OF_LANES>
+HM_TARGET("sse4.1,sha") static void TransformSHAInterleaved(uint32_t* const state, const uint8_t* const* const data, const uint64_t numOfBlocks, const uint32_t* const K)
+{
+    const __m128i MASK = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    
+    __m128i state0[NUM_OF_LANES];
+    __m128i state1[NUM_OF_LANES];
+    __m128i msg[4][NUM_OF_LANES];
+    
+    // The state stays in registers for all blocks
+    LoadStateSHA<NUM_OF_LANES>(state, state0, state1);
+    
+    for(uint64_t n = 0; n < numOfBlocks; n++)
+    {
+        const uint64_t offset = n * 64;
+        
+        // Load data
+        for(uint32_t i = 0; i < NUM_OF_LANES; i++)
+        {
+            for(uint32_t j = 0; j < 4; j++)
+                msg[j][i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data[i] + offset + 16 * j)), MASK);
+        }
+        
+        CompressBlockSHA<NUM_OF_LANES>(state0, state1, msg, K);
+    }
+    
+    // Save the new state
+    StoreStateSHA<NUM_OF_LANES>(state, state0, state1);
+}
+
+// Rounds only with a precomputed W+K, for the padding block of 64 byte messages
+template <uint32_t NUM_OF_LANES>
+HM_TARGET("sse4.1,sha") static void TransformPaddingBlockSHAInterleaved(uint32_t* const state, const uint32_t* const wk)
+{
+    __m128i state0[NUM_OF_LANES];
+    __m128i state1[NUM_OF_LANES];
+    __m128i abefSave[NUM_OF_LANES];
+    __m128i cdghSave[NUM_OF_LANES];
+    
+    LoadStateSHA<NUM_OF_LANES>(state, state0, state1);
+    
+    for(uint32_t i = 0; i < NUM_OF_LANES; i++)
+    {
+        abefSave[i] = state0[i];
+        cdghSave[i] = state1[i];
+    }
+    
+    for(uint32_t quadRound = 0; quadRound < 16; quadRound++)
+    {
+        const __m128i msg = _mm_loadu_si128(reinterpret_cast<const __m128i*>(wk + 4 * quadRound));
+        const __m128i msgHigh = _mm_shuffle_epi32(msg, 0x0E);
+        
+        for(uint32_t i = 0; i < NUM_OF_LANES; i++)
+            state1[i] = _mm_sha256rnds2_epu32(state1[i], state0[i], msg);
+        
+        for(uint32_t i = 0; i < NUM_OF_LANES; i++)
+            state0[i] = _mm_sha256rnds2_epu32(state0[i], state1[i], msgHigh);
+    }
+    
+    for(uint32_t i = 0; i < NUM_OF_LANES; i++)
+    {
+        state0[i] = _mm_add_epi32(state0[i], abefSave[i]);
+        state1[i] = _mm_add_epi32(state1[i], cdghSave[i]);
+    }
+    
+    StoreStateSHA<NUM_OF_LANES>(state, state0, state1);
+}
+
+// Two streams are the sweet spot, 4 lanes need 24 live XMM registers and spill (SHA instructions can't use XMM16-31)
+// Second pass of SHA256d, the message words are the digest words of the first pass and the constant padding
+template <uint32_t NUM_OF_LANES>
+HM_TARGET("sse4.1,sha") static void TransformDigestBlockSHAInterleaved(uint32_t* const state, const uint32_t* const initialHashValues, const uint32_t* const K)
+{
+    __m128i state0[NUM_OF_LANES];
+    __m128i state1[NUM_OF_LANES];
+    __m128i msg[4][NUM_OF_LANES];
+    
+    auto Word = [state](const uint32_t word, const uint32_t lane) { return static_cast<int32_t>(state[word * NUM_OF_LANES + lane]); };
+    
+    for(uint32_t i = 0; i < NUM_OF_LANES; i++)
+    {
+        msg[0][i] = _mm_set_epi32(Word(3, i), Word(2, i), Word(1, i), Word(0, i));
+        msg[1][i] = _mm_set_epi32(Word(7, i), Word(6, i), Word(5, i), Word(4, i));
+        msg[2][i] = _mm_set_epi32(0, 0, 0, static_cast<int32_t>(0x80000000));
+        msg[3][i] = _mm_set_epi32(256, 0, 0, 0); // Message length in bits
+    }
+    
+    __m128i initialState0[1];
+    __m128i initialState1[1];
+    LoadStateSHA<1>(initialHashValues, initialState0, initialState1);
+    
+    for(uint32_t i = 0; i < NUM_OF_LANES; i++)
+    {
+        state0[i] = initialState0[0];
+        state1[i] = initialState1[0];
+    }
+    
+    CompressBlockSHA<NUM_OF_LANES>(state0, state1, msg, K);
+    
+    StoreStateSHA<NUM_OF_LANES>(state, state0, state1);
+}
+
+HM_TARGET("sse4.1,sha") void BatchHasher<SHA256>::TransformSHAx2(uint32_t* const state, const uint8_t* const* const data, const uint64_t numOfBlocks)
+{
+    TransformSHAInterleaved<2>(state, data, numOfBlocks, Hasher<SHA256, SOFTWARE>::K.data());
+}
+
+HM_TARGET("sse4.1,sha") void BatchHasher<SHA256>::TransformPaddingBlockSHAx2(uint32_t* const state)
+{
+    TransformPaddingBlockSHAInterleaved<2>(state, PAIR_PADDING_BLOCK_WK.data());
+}
+
+HM_TARGET("sse4.1,sha") void BatchHasher<SHA256>::TransformPaddingBlockSHA(uint32_t* const state)
+{
+    TransformPaddingBlockSHAInterleaved<1>(state, PAIR_PADDING_BLOCK_WK.data());
+}
+
+HM_TARGET("sse4.1,sha") void BatchHasher<SHA256>::TransformDigestBlockSHAx2(uint32_t* const state)
+{
+    TransformDigestBlockSHAInterleaved<2>(state, Hasher<SHA256, SOFTWARE>::INITIAL_HASH_VALUES.data(), Hasher<SHA256, SOFTWARE>::K.data());
+}
+
+HM_TARGET("sse4.1,sha") void BatchHasher<SHA256>::TransformDigestBlockSHA(uint32_t* const state)
+{
+    TransformDigestBlockSHAInterleaved<1>(state, Hasher<SHA256, SOFTWARE>::INITIAL_HASH_VALUES.data(), Hasher<SHA256, SOFTWARE>::K.data());
+}
+#endif
+
+BatchHasher<SHA256>::BatchHasher()
+{
+    // Single messages use the same kernel as the hardware hasher
+#if defined(HM_SIMD_ARM) || defined(HM_SIMD_X86)
+    m_TransformFunction = Hasher<SHA256, HARDWARE>::SelectTransformFunction();
+#else
+    m_TransformFunction = Hasher<SHA256, SOFTWARE>::TransformSoftware;
+#endif
+    m_PaddingBlockFunction = TransformPaddingBlockSoftware;
+    m_DigestBlockFunction = TransformDigestBlockSoftware;
+    
+#if defined(HM_SIMD_X86)
+    const CPU::Features& features = CPU::GetFeatures();
+    
+    if(features.hasSHA && features.hasSSE41)
+    {
+        m_PaddingBlockFunction = TransformPaddingBlockSHA;
+        m_DigestBlockFunction = TransformDigestBlockSHA;
+    }
+    
+    // Sorted by number of lanes. On a Xeon with all extensions the 16 AVX-512 lanes reach 2.3 GB/s, two interleaved
+    // SHA-NI streams 1.5 GB/s and a single SHA-NI stream 1.3 GB/s
+    if(features.hasAVX512F && features.hasAVX512BW)
+        m_MultiBufferKernels[m_NumOfMultiBufferKernels++] = { TransformAVX512x16, TransformPaddingBlockAVX512x16, TransformDigestBlockAVX512x16, 16 };
+    
+    if(features.hasAVX2 && !features.hasSHA) // A single SHA-NI stream is faster than 8 AVX2 lanes
+        m_MultiBufferKernels[m_NumOfMultiBufferKernels++] = { TransformAVX2x8, TransformPaddingBlockAVX2x8, TransformDigestBlockAVX2x8, 8 };
+    
+    if(features.hasSHA && features.hasSSE41)
+        m_MultiBufferKernels[m_NumOfMultiBufferKernels++] = { TransformSHAx2, TransformPaddingBlockSHAx2, TransformDigestBlockSHAx2, 2 };
+#endif
+}
+
+BatchHasher<SHA256>::Midstate BatchHasher<SHA256>::InitialMidstate(const std::array<uint32_t, 8>& initialHashValues)
+{
+    Midstate midstate;
+    std::copy(initialHashValues.begin(), initialHashValues.end(), midstate.state);
+    
+    return midstate;
+}
+
+BatchHasher<SHA256>::Midstate BatchHasher<SHA256>::PrefixMidstate(const uint8_t prefix)
+{
+    Hasher<SHA256, SOFTWARE> hasher;
+    hasher.Update(&prefix, 1);
+    
+    return hasher.GetMidstate();
+}
+
+void BatchHasher<SHA256>::SplitMessage(const std::span<const uint8_t>& message, const Midstate& midstate, MessageBlocks& blocks)
+{
+    const uint8_t* data = message.data();
+    uint64_t size = message.size();
+    
+    const uint8_t* tail = nullptr;
+    uint32_t tailSize = 0;
+    
+    blocks.numOfBlocks[0] = 0;
+    
+    if(midstate.bufferSize > 0)
+    {
+        const uint64_t remainingBufferSpace = SHA256_BLOCK_LENGTH - midstate.bufferSize;
+        const uint64_t bytesToCopy = std::min(size, remainingBufferSpace);
+        
+        std::copy(midstate.buffer, midstate.buffer + midstate.bufferSize, blocks.headBlock);
+        if(bytesToCopy > 0)
+            std::copy(data, data + bytesToCopy, blocks.headBlock + midstate.bufferSize);
+        
+        data += bytesToCopy;
+        size -= bytesToCopy;
+        
+        if(bytesToCopy == remainingBufferSpace)
+        {
+            // Buffered block is completed by the message
+            blocks.data[0] = blocks.headBlock;
+            blocks.numOfBlocks[0] = 1;
+        }
+        else
+        {
+            // Whole message fits into the buffered block
+            tail = blocks.headBlock;
+            tailSize = midstate.bufferSize + static_cast<uint32_t>(bytesToCopy);
+        }
+    }
+    
+    blocks.data[1] = data;
+    blocks.numOfBlocks[1] = size / SHA256_BLOCK_LENGTH;
+    
+    if(!tail)
+    {
+        tail = data + blocks.numOfBlocks[1] * SHA256_BLOCK_LENGTH;
+        tailSize = static_cast<uint32_t>(size % SHA256_BLOCK_LENGTH);
+    }
+    
+    blocks.data[2] = blocks.finalBlocks;
+    blocks.numOfBlocks[2] = Hasher<SHA256, SOFTWARE>::PadFinalBlocks(blocks.finalBlocks, tail, tailSize, midstate.numOfBits + (message.size() << 3));
+}
+
+void BatchHasher<SHA256>::HashMessage(const std::span<const uint8_t>& message, uint8_t* const digest, const Midstate& midstate, const uint32_t digestLength) const
+{
+    uint32_t state[8];
+    MessageBlocks blocks;
+    
+    std::copy(midstate.state, midstate.state + 8, state);
+    SplitMessage(message, midstate, blocks);
+    
+    for(uint32_t i = 0; i < 3; i++)
+    {
+        if(blocks.numOfBlocks[i] > 0)
+            m_TransformFunction(state, blocks.data[i], blocks.numOfBlocks[i]);
+    }
+    
+    Hasher<SHA256, SOFTWARE>::StoreDigest(state, 1, digest, digestLength);
+    
+    // Cleanup sensitive data for security
+#ifdef HM_CLEANUP_TMP_MEMORY_AFTER_HASHING_FOR_SECURITY
+    std::memset(state, 0, sizeof(state));
+    std::memset(blocks.headBlock, 0, sizeof(blocks.headBlock));
+    std::memset(blocks.finalBlocks, 0, sizeof(blocks.finalBlocks));
+#endif
+}
+
+void BatchHasher<SHA256>::HashSingleStream(const std::vector<std::span<const uint8_t>>& messages, uint8_t* const digests, const Midstate& midstate, const uint32_t digestLength) const
+{
+    for(uint64_t i = 0; i < messages.size(); i++)
+        HashMessage(messages[i], digests + i * digestLength, midstate, digestLength);
+}
+
+void BatchHasher<SHA256>::HashMultiBuffer(const MultiBufferKernel& kernel, const std::vector<std::span<const uint8_t>>& messages, uint8_t* const digests, const Midstate& midstate, const uint32_t digestLength) const
+{
+    // Message currently processed by a lane. The whole blocks are read directly from the message,
+    // the other parts from a copy
+    struct Lane
+    {
+        bool            isActive = false;
+        uint64_t        messageIndex = 0;
+        uint32_t        nextPart = 0;
+        const uint8_t*  data = nullptr;
+        uint64_t        remainingBlocks = 0;
+        MessageBlocks   blocks;
+    };
+    
+    const uint32_t numOfLanes = kernel.numOfLanes;
+    
+    alignas(64) uint32_t state[8 * MAX_NUM_OF_LANES];
+    Lane lanes[MAX_NUM_OF_LANES];
+    const uint8_t* dataPointers[MAX_NUM_OF_LANES];
+    
+    uint64_t nextMessage = 0;
+    uint32_t numOfActiveLanes = 0;
+    
+    // Continues a lane with the next part of its message which has blocks. Returns false if the message is done
+    auto StartNextPart = [](Lane& lane) -> bool
+    {
+        while(lane.nextPart < 3)
+        {
+            const uint32_t part = lane.nextPart++;
+            
+            if(lane.blocks.numOfBlocks[part] > 0)
+            {
+                lane.data = lane.blocks.data[part];
+                lane.remainingBlocks = lane.blocks.numOfBlocks[part];
+                return true;
+            }
+        }
+        
+        return false;
+    };
+    
+    // Assigns the next message to a lane. Returns false if all messages are already assigned
+    auto StartNextMessage = [&](const uint32_t laneIndex) -> bool
+    {
+        Lane& lane = lanes[laneIndex];
+        
+        lane.isActive = (nextMessage < messages.size());
+        if(!lane.isActive)
+            return false;
+        
+        lane.messageIndex = nextMessage++;
+        
+        for(uint32_t i = 0; i < 8; i++)
+            state[i * numOfLanes + laneIndex] = midstate.state[i];
+        
+        SplitMessage(messages[lane.messageIndex], midstate, lane.blocks);
+        
+        // There is always at least one final block
+        lane.nextPart = 0;
+        StartNextPart(lane);
+        
+        return true;
+    };
+    
+    for(uint32_t i = 0; i < numOfLanes; i++)
+    {
+        if(StartNextMessage(i))
+            numOfActiveLanes++;
+    }
+    
+    while(numOfActiveLanes > 0)
+    {
+        // Run all lanes for the smallest number of remaining blocks, so that at least one lane finishes its current part
+        uint64_t numOfBlocks = UINT64_MAX;
+        const uint8_t* activeData = nullptr;
+        
+        for(uint32_t i = 0; i < numOfLanes; i++)
+        {
+            if(lanes[i].isActive && lanes[i].remainingBlocks < numOfBlocks)
+            {
+                numOfBlocks = lanes[i].remainingBlocks;
+                activeData = lanes[i].data;
+            }
+        }
+        
+        // Idle lanes hash the data of an active lane, their result is discarded
+        for(uint32_t i = 0; i < numOfLanes; i++)
+            dataPointers[i] = lanes[i].isActive ? lanes[i].data : activeData;
+        
+        kernel.function(state, dataPointers, numOfBlocks);
+        
+        for(uint32_t i = 0; i < numOfLanes; i++)
+        {
+            Lane& lane = lanes[i];
+            if(!lane.isActive)
+                continue;
+            
+            lane.data += numOfBlocks * SHA256_BLOCK_LENGTH;
+            lane.remainingBlocks -= numOfBlocks;
+            
+            if(lane.remainingBlocks > 0 || StartNextPart(lane))
+                continue;
+            
+            // Message is done, retire it and refill the lane
+            Hasher<SHA256, SOFTWARE>::StoreDigest(&state[i], numOfLanes, digests + lane.messageIndex * digestLength, digestLength);
+            
+            if(!StartNextMessage(i))
+                numOfActiveLanes--;
+        }
+    }
+    
+    // Cleanup sensitive data for security
+#ifdef HM_CLEANUP_TMP_MEMORY_AFTER_HASHING_FOR_SECURITY
+    std::memset(state, 0, sizeof(state));
+    for(uint32_t i = 0; i < numOfLanes; i++)
+    {
+        std::memset(lanes[i].blocks.headBlock, 0, sizeof(lanes[i].blocks.headBlock));
+        std::memset(lanes[i].blocks.finalBlocks, 0, sizeof(lanes[i].blocks.finalBlocks));
+    }
+#endif
+}
+
+void BatchHasher<SHA256>::HashMessages(const std::vector<std::span<const uint8_t>>& messages, uint8_t* const digests, const Midstate& midstate, const uint32_t digestLength) const
+{
+    // The midstate is checked even for an empty batch, like in Hash() with a single suffix
+    if(midstate.bufferSize >= SHA256_BLOCK_LENGTH)
+        throw std::invalid_argument("Midstate buffer size must be smaller than the block length.");
+    
+    // An empty batch has no digests, the digest buffer may be nullptr then
+    if(messages.empty())
+        return;
+    
+    if(!digests)
+        throw std::invalid_argument("Digests cannot be nullptr.");
+    
+    for(const std::span<const uint8_t>& message : messages)
+    {
+        if(!message.data() && message.size() > 0)
+            throw std::invalid_argument("Data cannot be nullptr.");
+    }
+    
+    // Use the widest kernel that can fill all of its lanes
+    for(uint32_t i = 0; i < m_NumOfMultiBufferKernels; i++)
+    {
+        if(messages.size() >= m_MultiBufferKernels[i].numOfLanes)
+        {
+            HashMultiBuffer(m_MultiBufferKernels[i], messages, digests, midstate, digestLength);
+            return;
+        }
+    }
+    
+    HashSingleStream(messages, digests, midstate, digestLength);
+}
+
+void BatchHasher<SHA256>::HashPairsMultiBuffer(const MultiBufferKernel& kernel, const uint8_t* const nodes, const uint64_t numOfPairs, uint8_t* const digests) const
+{
+    const uint32_t numOfLanes = kernel.numOfLanes;
+    
+    alignas(64) uint32_t state[8 * MAX_NUM_OF_LANES];
+    const uint8_t* dataPointers[MAX_NUM_OF_LANES];
+    
+    // All messages have the same length, so there is no lane scheduling. The digests of a group are stored
+    // after all of its nodes are read, this allows to reduce a level in place
+    for(uint64_t pair = 0; pair + numOfLanes <= numOfPairs; pair += numOfLanes)
+    {
+        for(uint32_t i = 0; i < numOfLanes; i++)
+        {
+            for(uint32_t j = 0; j < 8; j++)
+                state[j * numOfLanes + i] = Hasher<SHA256, SOFTWARE>::INITIAL_HASH_VALUES[j];
+            
+            dataPointers[i] = nodes + (pair + i) * SHA256_BLOCK_LENGTH;
+        }
+        
+        kernel.function(state, dataPointers, 1);
+        kernel.paddingBlockFunction(state);
+        
+        for(uint32_t i = 0; i < numOfLanes; i++)
+            Hasher<SHA256, SOFTWARE>::StoreDigest(&state[i], numOfLanes, digests + (pair + i) * 32, 32);
+    }
+    
+    // Cleanup sensitive data for security
+#ifdef HM_CLEANUP_TMP_MEMORY_AFTER_HASHING_FOR_SECURITY
+    std::memset(state, 0, sizeof(state));
+#endif
+}
+
+void BatchHasher<SHA256>::HashPairs32(const uint8_t* const nodes, const uint64_t numOfPairs, uint8_t* const digests) const
+{
+    if(numOfPairs == 0)
+        return;
+    
+    if(!nodes)
+        throw std::invalid_argument("Nodes cannot be nullptr.");
+    
+    if(!digests)
+        throw std::invalid_argument("Digests cannot be nullptr.");
+    
+    // Full groups with the widest kernel, the rest with narrower ones
+    uint64_t pair = 0;
+    for(uint32_t i = 0; i < m_NumOfMultiBufferKernels; i++)
+    {
+        const MultiBufferKernel& kernel = m_MultiBufferKernels[i];
+        const uint64_t numOfGroupedPairs = (numOfPairs - pair) / kernel.numOfLanes * kernel.numOfLanes;
+        
+        if(numOfGroupedPairs > 0)
+        {
+            HashPairsMultiBuffer(kernel, nodes + pair * SHA256_BLOCK_LENGTH, numOfGroupedPairs, digests + pair * 32);
+            pair += numOfGroupedPairs;
+        }
+    }
+    
+    uint32_t state[8];
+    for(; pair < numOfPairs; pair++)
+    {
+        std::copy(Hasher<SHA256, SOFTWARE>::INITIAL_HASH_VALUES.begin(), Hasher<SHA256, SOFTWARE>::INITIAL_HASH_VALUES.end(), state);
+        
+        m_TransformFunction(state, nodes + pair * SHA256_BLOCK_LENGTH, 1);
+        m_PaddingBlockFunction(state);
+        
+        Hasher<SHA256, SOFTWARE>::StoreDigest(state, 1, digests + pair * 32, 32);
+    }
+    
+    // Cleanup sensitive data for security
+#ifdef HM_CLEANUP_TMP_MEMORY_AFTER_HASHING_FOR_SECURITY
+    std::memset(state, 0, sizeof(state));
+#endif
+}
+
+std::vector<uint8_t> BatchHasher<SHA256>::HashPairs32(const std::vector<uint8_t>& nodes) const
+{
+    if(nodes.size() % SHA256_BLOCK_LENGTH != 0)
+        throw std::invalid_argument("Nodes must contain an even number of 32 byte digests.");
+    
+    std::vector<uint8_t> digests(nodes.size() / 2);
+    HashPairs32(nodes.data(), nodes.size() / SHA256_BLOCK_LENGTH, digests.data());
+    
+    return digests;
+}
+
+void BatchHasher<SHA256>::HashPair32(const uint8_t* const left, const uint8_t* const right, uint8_t* const digest) const
+{
+    if(!left || !right)
+        throw std::invalid_argument("Child digests cannot be nullptr.");
+    
+    if(!digest)
+        throw std::invalid_argument("Digest cannot be nullptr.");
+    
+    uint8_t block[SHA256_BLOCK_LENGTH];
+    std::copy(left, left + 32, block);
+    std::copy(right, right + 32, block + 32);
+    
+    uint32_t state[8];
+    std::copy(Hasher<SHA256, SOFTWARE>::INITIAL_HASH_VALUES.begin(), Hasher<SHA256, SOFTWARE>::INITIAL_HASH_VALUES.end(), state);
+    
+    m_TransformFunction(state, block, 1);
+    m_PaddingBlockFunction(state);
+    
+    Hasher<SHA256, SOFTWARE>::StoreDigest(state, 1, digest, 32);
+    
+    // Cleanup sensitive data for security
+#ifdef HM_CLEANUP_TMP_MEMORY_AFTER_HASHING_FOR_SECURITY
+    std::memset(block, 0, sizeof(block));
+    std::memset(state, 0, sizeof(state));
+#endif
+}
+
+void BatchHasher<SHA256>::RehashDigestsMultiBuffer(const MultiBufferKernel& kernel, uint8_t* const digests, const uint64_t numOfDigests) const
+{
+    const uint32_t numOfLanes = kernel.numOfLanes;
+    
+    alignas(64) uint32_t state[8 * MAX_NUM_OF_LANES];
+    
+    for(uint64_t digest = 0; digest + numOfLanes <= numOfDigests; digest += numOfLanes)
+    {
+        for(uint32_t i = 0; i < numOfLanes; i++)
+            LoadDigest(digests + (digest + i) * 32, &state[i], numOfLanes);
+        
+        kernel.digestBlockFunction(state);
+        
+        for(uint32_t i = 0; i < numOfLanes; i++)
+            Hasher<SHA256, SOFTWARE>::StoreDigest(&state[i], numOfLanes, digests + (digest + i) * 32, 32);
+    }
+    
+    // Cleanup sensitive data for security
+#ifdef HM_CLEANUP_TMP_MEMORY_AFTER_HASHING_FOR_SECURITY
+    std::memset(state, 0, sizeof(state));
+#endif
+}
+
+// Replaces every 32 byte digest by its SHA256
+void BatchHasher<SHA256>::RehashDigests(uint8_t* const digests, const uint64_t numOfDigests) const
+{
+    // Full groups with the widest kernel, the rest with narrower ones
+    uint64_t digest = 0;
+    for(uint32_t i = 0; i < m_NumOfMultiBufferKernels; i++)
+    {
+        const MultiBufferKernel& kernel = m_MultiBufferKernels[i];
+        const uint64_t numOfGroupedDigests = (numOfDigests - digest) / kernel.numOfLanes * kernel.numOfLanes;
+        
+        if(numOfGroupedDigests > 0)
+        {
+            RehashDigestsMultiBuffer(kernel, digests + digest * 32, numOfGroupedDigests);
+            digest += numOfGroupedDigests;
+        }
+    }
+    
+    uint32_t state[8];
+    for(; digest < numOfDigests; digest++)
+    {
+        LoadDigest(digests + digest * 32, state, 1);
+        m_DigestBlockFunction(state);
+        Hasher<SHA256, SOFTWARE>::StoreDigest(state, 1, digests + digest * 32, 32);
+    }
+    
+    // Cleanup sensitive data for security
+#ifdef HM_CLEANUP_TMP_MEMORY_AFTER_HASHING_FOR_SECURITY
+    std::memset(state, 0, sizeof(state));
+#endif
+}
+
+void BatchHasher<SHA256>::HashDouble(const std::span<const uint8_t> message, uint8_t* const digest) const
+{
+    if(!digest)
+        throw std::invalid_argument("Digest cannot be nullptr.");
+    
+    if(!message.data() && message.size() > 0)
+        throw std::invalid_argument("Data cannot be nullptr.");
+    
+    HashMessage(message, digest, InitialMidstate(Hasher<SHA256, SOFTWARE>::INITIAL_HASH_VALUES), 32);
+    RehashDigests(digest, 1);
+}
+
+void BatchHasher<SHA256>::HashDouble(const std::vector<std::span<const uint8_t>>& messages, uint8_t* const digests) const
+{
+    if(messages.empty())
+        return;
+    
+    HashMessages(messages, digests, InitialMidstate(Hasher<SHA256, SOFTWARE>::INITIAL_HASH_VALUES), 32);
+    RehashDigests(digests, messages.size());
+}
+
+std::vector<std::vector<uint8_t>> BatchHasher<SHA256>::HashDouble(const std::vector<std::span<const uint8_t>>& messages) const
+{
+    std::vector<uint8_t> digests(messages.size() * 32);
+    HashDouble(messages, digests.data());
+    
+    std::vector<std::vector<uint8_t>> result(messages.size());
+    for(uint64_t i = 0; i < messages.size(); i++)
+        result[i].assign(digests.begin() + static_cast<std::ptrdiff_t>(i * 32), digests.begin() + static_cast<std::ptrdiff_t>((i + 1) * 32));
+    
+    return result;
+}
+
+uint32_t BatchHasher<SHA256>::GetNumOfLanes() const
+{
+    return (m_NumOfMultiBufferKernels > 0) ? m_MultiBufferKernels[0].numOfLanes : 1;
+}
+
+void BatchHasher<SHA256>::Hash(const std::vector<std::span<const uint8_t>>& messages, uint8_t* const digests) const
+{
+    HashMessages(messages, digests, InitialMidstate(Hasher<SHA256, SOFTWARE>::INITIAL_HASH_VALUES), 32);
+}
+
+std::vector<std::vector<uint8_t>> BatchHasher<SHA256>::Hash(const std::vector<std::span<const uint8_t>>& messages) const
+{
+    std::vector<uint8_t> digests(messages.size() * 32);
+    Hash(messages, digests.data());
+    
+    std::vector<std::vector<uint8_t>> result(messages.size());
+    for(uint64_t i = 0; i < messages.size(); i++)
+        result[i].assign(digests.begin() + static_cast<std::ptrdiff_t>(i * 32), digests.begin() + static_cast<std::ptrdiff_t>((i + 1) * 32));
+    
+    return result;
+}
+
+void BatchHasher<SHA256>::Hash(const Midstate& midstate, const std::vector<std::span<const uint8_t>>& suffixes, uint8_t* const digests) const
+{
+    HashMessages(suffixes, digests, midstate, 32);
+}
+
+std::vector<std::vector<uint8_t>> BatchHasher<SHA256>::Hash(const Midstate& midstate, const std::vector<std::span<const uint8_t>>& suffixes) const
+{
+    std::vector<uint8_t> digests(suffixes.size() * 32);
+    Hash(midstate, suffixes, digests.data());
+    
+    std::vector<std::vector<uint8_t>> result(suffixes.size());
+    for(uint64_t i = 0; i < suffixes.size(); i++)
+        result[i].assign(digests.begin() + static_cast<std::ptrdiff_t>(i * 32), digests.begin() + static_cast<std::ptrdiff_t>((i + 1) * 32));
+    
+    return result;
+}
+
+void BatchHasher<SHA256>::Hash(const Midstate& midstate, const std::span<const uint8_t> suffix, uint8_t* const digest) const
+{
+    if(!digest)
+        throw std::invalid_argument("Digest cannot be nullptr.");
+    
+    if(!suffix.data() && suffix.size() > 0)
+        throw std::invalid_argument("Data cannot be nullptr.");
+    
+    if(midstate.bufferSize >= SHA256_BLOCK_LENGTH)
+        throw std::invalid_argument("Midstate buffer size must be smaller than the block length.");
+    
+    HashMessage(suffix, digest, midstate, 32);
+}
@@ -37,168 +37,199 @@ the following restrictions:
 
 using namespace HashMe;
 
-Hasher<SHA256, HARDWARE>::Hasher(const Hasher& other) : Hasher<SHA256, SOFTWARE>(other)
+Hasher<SHA256, HARDWARE>::Hasher()
+    : m_TransformFunction(SelectTransformFunction())
 {
 }
 
+Hasher<SHA256, HARDWARE>::Hasher(const Hasher& other)
+    : Hasher<SHA256, SOFTWARE>(other)
+    , m_TransformFunction(other.m_TransformFunction)
+{
+}
+
+Hasher<SHA256, HARDWARE>::TransformFunction Hasher<SHA256, HARDWARE>::SelectTransformFunction()
+{
+    const CPU::Features& features = CPU::GetFeatures();
+    
+#if defined(HM_SIMD_ARM)
+    if(features.hasARMSHA2)
+        return TransformARM;
+#elif defined(HM_SIMD_X86)
+    if(features.hasSHA && features.hasSSE41)
+        return TransformX86;
+    
+    if(features.hasAVX2 && features.hasBMI1 && features.hasBMI2)
+        return TransformAVX2;
+#endif
+    
+    return TransformSoftware;
+}
+
 #if defined(HM_SIMD_ARM)
-void Hasher<SHA256, HARDWARE>::TransformARM(const uint8_t* const data)
+void Hasher<SHA256, HARDWARE>::TransformARM(uint32_t* const state, const uint8_t* data, uint64_t numOfBlocks)
 {
-    // Load initial state
-    uint32x4_t STATE0 = vld1q_u32(&m_Context->state[0]);
-    uint32x4_t STATE1 = vld1q_u32(&m_Context->state[4]);
+    // Load initial state, it stays in registers for all blocks
+    uint32x4_t STATE0 = vld1q_u32(&state[0]);
+    uint32x4_t STATE1 = vld1q_u32(&state[4]);
     
-    // Save current state
-    const uint32x4_t ABCD_SAVE = STATE0;
-    const uint32x4_t EFGH_SAVE = STATE1;
+    while(numOfBlocks > 0)
+    {
+        // Save current state
+        const uint32x4_t ABCD_SAVE = STATE0;
+        const uint32x4_t EFGH_SAVE = STATE1;
 
-    // Load data
-    const uint32_t* const data32 = reinterpret_cast<const uint32_t*>(data);
-    uint32x4_t MSG0 = vld1q_u32(data32 +  0);
-    uint32x4_t MSG1 = vld1q_u32(data32 + 16);
-    uint32x4_t MSG2 = vld1q_u32(data32 + 32);
-    uint32x4_t MSG3 = vld1q_u32(data32 + 48);
+        // Load data
+        const uint32_t* const data32 = reinterpret_cast<const uint32_t*>(data);
+        uint32x4_t MSG0 = vld1q_u32(data32 +  0);
+        uint32x4_t MSG1 = vld1q_u32(data32 +  4);
+        uint32x4_t MSG2 = vld1q_u32(data32 +  8);
+        uint32x4_t MSG3 = vld1q_u32(data32 + 12);
 
 #ifdef HM_LITTLE_ENDIAN // Reverse byte order if host is little endian to match SHA256 big endian requirement
-    MSG0 = vreinterpretq_u32_u8(vrev32q_u8(vreinterpretq_u8_u32(MSG0)));
-    MSG1 = vreinterpretq_u32_u8(vrev32q_u8(vreinterpretq_u8_u32(MSG1)));
-    MSG2 = vreinterpretq_u32_u8(vrev32q_u8(vreinterpretq_u8_u32(MSG2)));
-    MSG3 = vreinterpretq_u32_u8(vrev32q_u8(vreinterpretq_u8_u32(MSG3)));
+        MSG0 = vreinterpretq_u32_u8(vrev32q_u8(vreinterpretq_u8_u32(MSG0)));
+        MSG1 = vreinterpretq_u32_u8(vrev32q_u8(vreinterpretq_u8_u32(MSG1)));
+        MSG2 = vreinterpretq_u32_u8(vrev32q_u8(vreinterpretq_u8_u32(MSG2)));
+        MSG3 = vreinterpretq_u32_u8(vrev32q_u8(vreinterpretq_u8_u32(MSG3)));
 #endif
     
-    uint32x4_t TMP0, TMP1, TMP2;
+        uint32x4_t TMP0, TMP1, TMP2;
     
-    TMP0 = vaddq_u32(MSG0, vld1q_u32(&K[0x00]));
-
-    // Rounds 0-3
-    MSG0 = vsha256su0q_u32(MSG0, MSG1);
-    TMP2 = STATE0;
-    TMP1 = vaddq_u32(MSG1, vld1q_u32(&K[0x04]));
-    STATE0 = vsha256hq_u32(STATE0, STATE1, TMP0);
-    STATE1 = vsha256h2q_u32(STATE1, TMP2, TMP0);
-    MSG0 = vsha256su1q_u32(MSG0, MSG2, MSG3);
-
-    // Rounds 4-7
-    MSG1 = vsha256su0q_u32(MSG1, MSG2);
-    TMP2 = STATE0;
-    TMP0 = vaddq_u32(MSG2, vld1q_u32(&K[0x08]));
-    STATE0 = vsha256hq_u32(STATE0, STATE1, TMP1);
-    STATE1 = vsha256h2q_u32(STATE1, TMP2, TMP1);
-    MSG1 = vsha256su1q_u32(MSG1, MSG3, MSG0);
-
-    // Rounds 8-11
-    MSG2 = vsha256su0q_u32(MSG2, MSG3);
-    TMP2 = STATE0;
-    TMP1 = vaddq_u32(MSG3, vld1q_u32(&K[0x0c]));
-    STATE0 = vsha256hq_u32(STATE0, STATE1, TMP0);
-    STATE1 = vsha256h2q_u32(STATE1, TMP2, TMP0);
-    MSG2 = vsha256su1q_u32(MSG2, MSG0, MSG1);
-
-    // Rounds 12-15
-    MSG3 = vsha256su0q_u32(MSG3, MSG0);
-    TMP2 = STATE0;
-    TMP0 = vaddq_u32(MSG0, vld1q_u32(&K[0x10]));
-    STATE0 = vsha256hq_u32(STATE0, STATE1, TMP1);
-    STATE1 = vsha256h2q_u32(STATE1, TMP2, TMP1);
-    MSG3 = vsha256su1q_u32(MSG3, MSG1, MSG2);
-
-    // Rounds 16-19
-    MSG0 = vsha256su0q_u32(MSG0, MSG1);
-    TMP2 = STATE0;
-    TMP1 = vaddq_u32(MSG1, vld1q_u32(&K[0x14]));
-    STATE0 = vsha256hq_u32(STATE0, STATE1, TMP0);
-    STATE1 = vsha256h2q_u32(STATE1, TMP2, TMP0);
-    MSG0 = vsha256su1q_u32(MSG0, MSG2, MSG3);
-
-    // Rounds 20-23
-    MSG1 = vsha256su0q_u32(MSG1, MSG2);
-    TMP2 = STATE0;
-    TMP0 = vaddq_u32(MSG2, vld1q_u32(&K[0x18]));
-    STATE0 = vsha256hq_u32(STATE0, STATE1, TMP1);
-    STATE1 = vsha256h2q_u32(STATE1, TMP2, TMP1);
-    MSG1 = vsha256su1q_u32(MSG1, MSG3, MSG0);
-
-    // Rounds 24-27
-    MSG2 = vsha256su0q_u32(MSG2, MSG3);
-    TMP2 = STATE0;
-    TMP1 = vaddq_u32(MSG3, vld1q_u32(&K[0x1c]));
-    STATE0 = vsha256hq_u32(STATE0, STATE1, TMP0);
-    STATE1 = vsha256h2q_u32(STATE1, TMP2, TMP0);
-    MSG2 = vsha256su1q_u32(MSG2, MSG0, MSG1);
-
-    // Rounds 28-31
-    MSG3 = vsha256su0q_u32(MSG3, MSG0);
-    TMP2 = STATE0;
-    TMP0 = vaddq_u32(MSG0, vld1q_u32(&K[0x20]));
-    STATE0 = vsha256hq_u32(STATE0, STATE1, TMP1);
-    STATE1 = vsha256h2q_u32(STATE1, TMP2, TMP1);
-    MSG3 = vsha256su1q_u32(MSG3, MSG1, MSG2);
-
-    // Rounds 32-35
-    MSG0 = vsha256su0q_u32(MSG0, MSG1);
-    TMP2 = STATE0;
-    TMP1 = vaddq_u32(MSG1, vld1q_u32(&K[0x24]));
-    STATE0 = vsha256hq_u32(STATE0, STATE1, TMP0);
-    STATE1 = vsha256h2q_u32(STATE1, TMP2, TMP0);
-    MSG0 = vsha256su1q_u32(MSG0, MSG2, MSG3);
-
-    // Rounds 36-39
-    MSG1 = vsha256su0q_u32(MSG1, MSG2);
-    TMP2 = STATE0;
-    TMP0 = vaddq_u32(MSG2, vld1q_u32(&K[0x28]));
-    STATE0 = vsha256hq_u32(STATE0, STATE1, TMP1);
-    STATE1 = vsha256h2q_u32(STATE1, TMP2, TMP1);
-    MSG1 = vsha256su1q_u32(MSG1, MSG3, MSG0);
-
-    // Rounds 40-43
-    MSG2 = vsha256su0q_u32(MSG2, MSG3);
-    TMP2 = STATE0;
-    TMP1 = vaddq_u32(MSG3, vld1q_u32(&K[0x2c]));
-    STATE0 = vsha256hq_u32(STATE0, STATE1, TMP0);
-    STATE1 = vsha256h2q_u32(STATE1, TMP2, TMP0);
-    MSG2 = vsha256su1q_u32(MSG2, MSG0, MSG1);
-
-    // Rounds 44-47
-    MSG3 = vsha256su0q_u32(MSG3, MSG0);
-    TMP2 = STATE0;
-    TMP0 = vaddq_u32(MSG0, vld1q_u32(&K[0x30]));
-    STATE0 = vsha256hq_u32(STATE0, STATE1, TMP1);
-    STATE1 = vsha256h2q_u32(STATE1, TMP2, TMP1);
-    MSG3 = vsha256su1q_u32(MSG3, MSG1, MSG2);
-
-    // Rounds 48-51
-    TMP2 = STATE0;
-    TMP1 = vaddq_u32(MSG1, vld1q_u32(&K[0x34]));
-    STATE0 = vsha256hq_u32(STATE0, STATE1, TMP0);
-    STATE1 = vsha256h2q_u32(STATE1, TMP2, TMP0);
-
-    // Rounds 52-55
-    TMP2 = STATE0;
-    TMP0 = vaddq_u32(MSG2, vld1q_u32(&K[0x38]));
-    STATE0 = vsha256hq_u32(STATE0, STATE1, TMP1);
-    STATE1 = vsha256h2q_u32(STATE1, TMP2, TMP1);
-
-    // Rounds 56-59
-    TMP2 = STATE0;
-    TMP1 = vaddq_u32(MSG3, vld1q_u32(&K[0x3c]));
-    STATE0 = vsha256hq_u32(STATE0, STATE1, TMP0);
-    STATE1 = vsha256h2q_u32(STATE1, TMP2, TMP0);
-
-    // Rounds 60-63
-    TMP2 = STATE0;
-    STATE0 = vsha256hq_u32(STATE0, STATE1, TMP1);
-    STATE1 = vsha256h2q_u32(STATE1, TMP2, TMP1);
-
-    // Combine states
-    STATE0 = vaddq_u32(STATE0, ABCD_SAVE);
-    STATE1 = vaddq_u32(STATE1, EFGH_SAVE);
+        TMP0 = vaddq_u32(MSG0, vld1q_u32(&K[0x00]));
+
+        // Rounds 0-3
+        MSG0 = vsha256su0q_u32(MSG0, MSG1);
+        TMP2 = STATE0;
+        TMP1 = vaddq_u32(MSG1, vld1q_u32(&K[0x04]));
+        STATE0 = vsha256hq_u32(STATE0, STATE1, TMP0);
+        STATE1 = vsha256h2q_u32(STATE1, TMP2, TMP0);
+        MSG0 = vsha256su1q_u32(MSG0, MSG2, MSG3);
+
+        // Rounds 4-7
+        MSG1 = vsha256su0q_u32(MSG1, MSG2);
+        TMP2 = STATE0;
+        TMP0 = vaddq_u32(MSG2, vld1q_u32(&K[0x08]));
+        STATE0 = vsha256hq_u32(STATE0, STATE1, TMP1);
+        STATE1 = vsha256h2q_u32(STATE1, TMP2, TMP1);
+        MSG1 = vsha256su1q_u32(MSG1, MSG3, MSG0);
+
+        // Rounds 8-11
+        MSG2 = vsha256su0q_u32(MSG2, MSG3);
+        TMP2 = STATE0;
+        TMP1 = vaddq_u32(MSG3, vld1q_u32(&K[0x0c]));
+        STATE0 = vsha256hq_u32(STATE0, STATE1, TMP0);
+        STATE1 = vsha256h2q_u32(STATE1, TMP2, TMP0);
+        MSG2 = vsha256su1q_u32(MSG2, MSG0, MSG1);
+
+        // Rounds 12-15
+        MSG3 = vsha256su0q_u32(MSG3, MSG0);
+        TMP2 = STATE0;
+        TMP0 = vaddq_u32(MSG0, vld1q_u32(&K[0x10]));
+        STATE0 = vsha256hq_u32(STATE0, STATE1, TMP1);
+        STATE1 = vsha256h2q_u32(STATE1, TMP2, TMP1);
+        MSG3 = vsha256su1q_u32(MSG3, MSG1, MSG2);
+
+        // Rounds 16-19
+        MSG0 = vsha256su0q_u32(MSG0, MSG1);
+        TMP2 = STATE0;
+        TMP1 = vaddq_u32(MSG1, vld1q_u32(&K[0x14]));
+        STATE0 = vsha256hq_u32(STATE0, STATE1, TMP0);
+        STATE1 = vsha256h2q_u32(STATE1, TMP2, TMP0);
+        MSG0 = vsha256su1q_u32(MSG0, MSG2, MSG3);
+
+        // Rounds 20-23
+        MSG1 = vsha256su0q_u32(MSG1, MSG2);
+        TMP2 = STATE0;
+        TMP0 = vaddq_u32(MSG2, vld1q_u32(&K[0x18]));
+        STATE0 = vsha256hq_u32(STATE0, STATE1, TMP1);
+        STATE1 = vsha256h2q_u32(STATE1, TMP2, TMP1);
+        MSG1 = vsha256su1q_u32(MSG1, MSG3, MSG0);
+
+        // Rounds 24-27
+        MSG2 = vsha256su0q_u32(MSG2, MSG3);
+        TMP2 = STATE0;
+        TMP1 = vaddq_u32(MSG3, vld1q_u32(&K[0x1c]));
+        STATE0 = vsha256hq_u32(STATE0, STATE1, TMP0);
+        STATE1 = vsha256h2q_u32(STATE1, TMP2, TMP0);
+        MSG2 = vsha256su1q_u32(MSG2, MSG0, MSG1);
+
+        // Rounds 28-31
+        MSG3 = vsha256su0q_u32(MSG3, MSG0);
+        TMP2 = STATE0;
+        TMP0 = vaddq_u32(MSG0, vld1q_u32(&K[0x20]));
+        STATE0 = vsha256hq_u32(STATE0, STATE1, TMP1);
+        STATE1 = vsha256h2q_u32(STATE1, TMP2, TMP1);
+        MSG3 = vsha256su1q_u32(MSG3, MSG1, MSG2);
+
+        // Rounds 32-35
+        MSG0 = vsha256su0q_u32(MSG0, MSG1);
+        TMP2 = STATE0;
+        TMP1 = vaddq_u32(MSG1, vld1q_u32(&K[0x24]));
+        STATE0 = vsha256hq_u32(STATE0, STATE1, TMP0);
+        STATE1 = vsha256h2q_u32(STATE1, TMP2, TMP0);
+        MSG0 = vsha256su1q_u32(MSG0, MSG2, MSG3);
+
+        // Rounds 36-39
+        MSG1 = vsha256su0q_u32(MSG1, MSG2);
+        TMP2 = STATE0;
+        TMP0 = vaddq_u32(MSG2, vld1q_u32(&K[0x28]));
+        STATE0 = vsha256hq_u32(STATE0, STATE1, TMP1);
+        STATE1 = vsha256h2q_u32(STATE1, TMP2, TMP1);
+        MSG1 = vsha256su1q_u32(MSG1, MSG3, MSG0);
+
+        // Rounds 40-43
+        MSG2 = vsha256su0q_u32(MSG2, MSG3);
+        TMP2 = STATE0;
+        TMP1 = vaddq_u32(MSG3, vld1q_u32(&K[0x2c]));
+        STATE0 = vsha256hq_u32(STATE0, STATE1, TMP0);
+        STATE1 = vsha256h2q_u32(STATE1, TMP2, TMP0);
+        MSG2 = vsha256su1q_u32(MSG2, MSG0, MSG1);
+
+        // Rounds 44-47
+        MSG3 = vsha256su0q_u32(MSG3, MSG0);
+        TMP2 = STATE0;
+        TMP0 = vaddq_u32(MSG0, vld1q_u32(&K[0x30]));
+        STATE0 = vsha256hq_u32(STATE0, STATE1, TMP1);
+        STATE1 = vsha256h2q_u32(STATE1, TMP2, TMP1);
+        MSG3 = vsha256su1q_u32(MSG3, MSG1, MSG2);
+
+        // Rounds 48-51
+        TMP2 = STATE0;
+        TMP1 = vaddq_u32(MSG1, vld1q_u32(&K[0x34]));
+        STATE0 = vsha256hq_u32(STATE0, STATE1, TMP0);
+        STATE1 = vsha256h2q_u32(STATE1, TMP2, TMP0);
+
+        // Rounds 52-55
+        TMP2 = STATE0;
+        TMP0 = vaddq_u32(MSG2, vld1q_u32(&K[0x38]));
+        STATE0 = vsha256hq_u32(STATE0, STATE1, TMP1);
+        STATE1 = vsha256h2q_u32(STATE1, TMP2, TMP1);
+
+        // Rounds 56-59
+        TMP2 = STATE0;
+        TMP1 = vaddq_u32(MSG3, vld1q_u32(&K[0x3c]));
+        STATE0 = vsha256hq_u32(STATE0, STATE1, TMP0);
+        STATE1 = vsha256h2q_u32(STATE1, TMP2, TMP0);
+
+        // Rounds 60-63
+        TMP2 = STATE0;
+        STATE0 = vsha256hq_u32(STATE0, STATE1, TMP1);
+        STATE1 = vsha256h2q_u32(STATE1, TMP2, TMP1);
+
+        // Combine states
+        STATE0 = vaddq_u32(STATE0, ABCD_SAVE);
+        STATE1 = vaddq_u32(STATE1, EFGH_SAVE);
+        
+        data += SHA256_BLOCK_LENGTH;
+        numOfBlocks--;
+    }
 
     // Save the new state
-    vst1q_u32(&m_Context->state[0], STATE0);
-    vst1q_u32(&m_Context->state[4], STATE1);
+    vst1q_u32(&state[0], STATE0);
+    vst1q_u32(&state[4], STATE1);
 }
 #elif defined(HM_SIMD_X86)
-void Hasher<SHA256, HARDWARE>::TransformX86(const uint8_t* const data)
+HM_TARGET("sse4.1,sha") void Hasher<SHA256, HARDWARE>::TransformX86(uint32_t* const state, const uint8_t* data, uint64_t numOfBlocks)
 {
     __m128i STATE0, STATE1;
     __m128i MSG, TMP;
@@ -206,180 +237,186 @@ void Hasher<SHA256, HARDWARE>::TransformX86(const uint8_t* const data)
     __m128i ABEF_SAVE, CDGH_SAVE;
     const __m128i MASK = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
 
-    // Load initial values from state
-    TMP = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&m_Context->state[0]));
-    STATE1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&m_Context->state[4]));
+    // Load initial values from state, they stay in registers as ABEF/CDGH for all blocks
+    TMP = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[0]));
+    STATE1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[4]));
 
     TMP = _mm_shuffle_epi32(TMP, 0xB1);          // CDAB
     STATE1 = _mm_shuffle_epi32(STATE1, 0x1B);    // EFGH
     STATE0 = _mm_alignr_epi8(TMP, STATE1, 8);    // ABEF
     STATE1 = _mm_blend_epi16(STATE1, TMP, 0xF0); // CDGH
 
-    // Save current state
-    ABEF_SAVE = STATE0;
-    CDGH_SAVE = STATE1;
-
-    // Load data
-    MSG = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0));
-    MSG1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16));
-    MSG2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 32));
-    MSG3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 48));
+    while(numOfBlocks > 0)
+    {
+        // Save current state
+        ABEF_SAVE = STATE0;
+        CDGH_SAVE = STATE1;
+
+        // Load data
+        MSG = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0));
+        MSG1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16));
+        MSG2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 32));
+        MSG3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 48));
     
-    // Rounds 0-3
-    //MSG = _mm_loadu_si128((const __m128i*) (data+0));
-    MSG0 = _mm_shuffle_epi8(MSG, MASK);
-    MSG = _mm_add_epi32(MSG0, _mm_set_epi64x(0xE9B5DBA5B5C0FBCFULL, 0x71374491428A2F98ULL));
-    STATE1 = _mm_sha256rnds2_epu32(STATE1, STATE0, MSG);
-    MSG = _mm_shuffle_epi32(MSG, 0x0E);
-    STATE0 = _mm_sha256rnds2_epu32(STATE0, STATE1, MSG);
-
-    // Rounds 4-7
-    //MSG1 = _mm_loadu_si128((const __m128i*) (data+16));
-    MSG1 = _mm_shuffle_epi8(MSG1, MASK);
-    MSG = _mm_add_epi32(MSG1, _mm_set_epi64x(0xAB1C5ED5923F82A4ULL, 0x59F111F13956C25BULL));
-    STATE1 = _mm_sha256rnds2_epu32(STATE1, STATE0, MSG);
-    MSG = _mm_shuffle_epi32(MSG, 0x0E);
-    STATE0 = _mm_sha256rnds2_epu32(STATE0, STATE1, MSG);
-    MSG0 = _mm_sha256msg1_epu32(MSG0, MSG1);
-
-    // Rounds 8-11
-    //MSG2 = _mm_loadu_si128((const __m128i*) (data+32));
-    MSG2 = _mm_shuffle_epi8(MSG2, MASK);
-    MSG = _mm_add_epi32(MSG2, _mm_set_epi64x(0x550C7DC3243185BEULL, 0x12835B01D807AA98ULL));
-    STATE1 = _mm_sha256rnds2_epu32(STATE1, STATE0, MSG);
-    MSG = _mm_shuffle_epi32(MSG, 0x0E);
-    STATE0 = _mm_sha256rnds2_epu32(STATE0, STATE1, MSG);
-    MSG1 = _mm_sha256msg1_epu32(MSG1, MSG2);
-
-    // Rounds 12-15
-    //MSG3 = _mm_loadu_si128((const __m128i*) (data+48));
-    MSG3 = _mm_shuffle_epi8(MSG3, MASK);
-    MSG = _mm_add_epi32(MSG3, _mm_set_epi64x(0xC19BF1749BDC06A7ULL, 0x80DEB1FE72BE5D74ULL));
-    STATE1 = _mm_sha256rnds2_epu32(STATE1, STATE0, MSG);
-    TMP = _mm_alignr_epi8(MSG3, MSG2, 4);
-    MSG0 = _mm_add_epi32(MSG0, TMP);
-    MSG0 = _mm_sha256msg2_epu32(MSG0, MSG3);
-    MSG = _mm_shuffle_epi32(MSG, 0x0E);
-    STATE0 = _mm_sha256rnds2_epu32(STATE0, STATE1, MSG);
-    MSG2 = _mm_sha256msg1_epu32(MSG2, MSG3);
-
-    // Rounds 16-19
-    MSG = _mm_add_epi32(MSG0, _mm_set_epi64x(0x240CA1CC0FC19DC6ULL, 0xEFBE4786E49B69C1ULL));
-    STATE1 = _mm_sha256rnds2_epu32(STATE1, STATE0, MSG);
-    TMP = _mm_alignr_epi8(MSG0, MSG3, 4);
-    MSG1 = _mm_add_epi32(MSG1, TMP);
-    MSG1 = _mm_sha256msg2_epu32(MSG1, MSG0);
-    MSG = _mm_shuffle_epi32(MSG, 0x0E);
-    STATE0 = _mm_sha256rnds2_epu32(STATE0, STATE1, MSG);
-    MSG3 = _mm_sha256msg1_epu32(MSG3, MSG0);
-
-    // Rounds 20-23
-    MSG = _mm_add_epi32(MSG1, _mm_set_epi64x(0x76F988DA5CB0A9DCULL, 0x4A7484AA2DE92C6FULL));
-    STATE1 = _mm_sha256rnds2_epu32(STATE1, STATE0, MSG);
-    TMP = _mm_alignr_epi8(MSG1, MSG0, 4);
-    MSG2 = _mm_add_epi32(MSG2, TMP);
-    MSG2 = _mm_sha256msg2_epu32(MSG2, MSG1);
-    MSG = _mm_shuffle_epi32(MSG, 0x0E);
-    STATE0 = _mm_sha256rnds2_epu32(STATE0, STATE1, MSG);
-    MSG0 = _mm_sha256msg1_epu32(MSG0, MSG1);
-
-    // Rounds 24-27
-    MSG = _mm_add_epi32(MSG2, _mm_set_epi64x(0xBF597FC7B00327C8ULL, 0xA831C66D983E5152ULL));
-    STATE1 = _mm_sha256rnds2_epu32(STATE1, STATE0, MSG);
-    TMP = _mm_alignr_epi8(MSG2, MSG1, 4);
-    MSG3 = _mm_add_epi32(MSG3, TMP);
-    MSG3 = _mm_sha256msg2_epu32(MSG3, MSG2);
-    MSG = _mm_shuffle_epi32(MSG, 0x0E);
-    STATE0 = _mm_sha256rnds2_epu32(STATE0, STATE1, MSG);
-    MSG1 = _mm_sha256msg1_epu32(MSG1, MSG2);
-
-    // Rounds 28-31
-    MSG = _mm_add_epi32(MSG3, _mm_set_epi64x(0x1429296706CA6351ULL,  0xD5A79147C6E00BF3ULL));
-    STATE1 = _mm_sha256rnds2_epu32(STATE1, STATE0, MSG);
-    TMP = _mm_alignr_epi8(MSG3, MSG2, 4);
-    MSG0 = _mm_add_epi32(MSG0, TMP);
-    MSG0 = _mm_sha256msg2_epu32(MSG0, MSG3);
-    MSG = _mm_shuffle_epi32(MSG, 0x0E);
-    STATE0 = _mm_sha256rnds2_epu32(STATE0, STATE1, MSG);
-    MSG2 = _mm_sha256msg1_epu32(MSG2, MSG3);
-
-    // Rounds 32-35
-    MSG = _mm_add_epi32(MSG0, _mm_set_epi64x(0x53380D134D2C6DFCULL, 0x2E1B213827B70A85ULL));
-    STATE1 = _mm_sha256rnds2_epu32(STATE1, STATE0, MSG);
-    TMP = _mm_alignr_epi8(MSG0, MSG3, 4);
-    MSG1 = _mm_add_epi32(MSG1, TMP);
-    MSG1 = _mm_sha256msg2_epu32(MSG1, MSG0);
-    MSG = _mm_shuffle_epi32(MSG, 0x0E);
-    STATE0 = _mm_sha256rnds2_epu32(STATE0, STATE1, MSG);
-    MSG3 = _mm_sha256msg1_epu32(MSG3, MSG0);
-
-    // Rounds 36-39
-    MSG = _mm_add_epi32(MSG1, _mm_set_epi64x(0x92722C8581C2C92EULL, 0x766A0ABB650A7354ULL));
-    STATE1 = _mm_sha256rnds2_epu32(STATE1, STATE0, MSG);
-    TMP = _mm_alignr_epi8(MSG1, MSG0, 4);
-    MSG2 = _mm_add_epi32(MSG2, TMP);
-    MSG2 = _mm_sha256msg2_epu32(MSG2, MSG1);
-    MSG = _mm_shuffle_epi32(MSG, 0x0E);
-    STATE0 = _mm_sha256rnds2_epu32(STATE0, STATE1, MSG);
-    MSG0 = _mm_sha256msg1_epu32(MSG0, MSG1);
-
-    // Rounds 40-43
-    MSG = _mm_add_epi32(MSG2, _mm_set_epi64x(0xC76C51A3C24B8B70ULL, 0xA81A664BA2BFE8A1ULL));
-    STATE1 = _mm_sha256rnds2_epu32(STATE1, STATE0, MSG);
-    TMP = _mm_alignr_epi8(MSG2, MSG1, 4);
-    MSG3 = _mm_add_epi32(MSG3, TMP);
-    MSG3 = _mm_sha256msg2_epu32(MSG3, MSG2);
-    MSG = _mm_shuffle_epi32(MSG, 0x0E);
-    STATE0 = _mm_sha256rnds2_epu32(STATE0, STATE1, MSG);
-    MSG1 = _mm_sha256msg1_epu32(MSG1, MSG2);
-
-    // Rounds 44-47
-    MSG = _mm_add_epi32(MSG3, _mm_set_epi64x(0x106AA070F40E3585ULL, 0xD6990624D192E819ULL));
-    STATE1 = _mm_sha256rnds2_epu32(STATE1, STATE0, MSG);
-    TMP = _mm_alignr_epi8(MSG3, MSG2, 4);
-    MSG0 = _mm_add_epi32(MSG0, TMP);
-    MSG0 = _mm_sha256msg2_epu32(MSG0, MSG3);
-    MSG = _mm_shuffle_epi32(MSG, 0x0E);
-    STATE0 = _mm_sha256rnds2_epu32(STATE0, STATE1, MSG);
-    MSG2 = _mm_sha256msg1_epu32(MSG2, MSG3);
-
-    // Rounds 48-51
-    MSG = _mm_add_epi32(MSG0, _mm_set_epi64x(0x34B0BCB52748774CULL, 0x1E376C0819A4C116ULL));
-    STATE1 = _mm_sha256rnds2_epu32(STATE1, STATE0, MSG);
-    TMP = _mm_alignr_epi8(MSG0, MSG3, 4);
-    MSG1 = _mm_add_epi32(MSG1, TMP);
-    MSG1 = _mm_sha256msg2_epu32(MSG1, MSG0);
-    MSG = _mm_shuffle_epi32(MSG, 0x0E);
-    STATE0 = _mm_sha256rnds2_epu32(STATE0, STATE1, MSG);
-    MSG3 = _mm_sha256msg1_epu32(MSG3, MSG0);
-
-    // Rounds 52-55
-    MSG = _mm_add_epi32(MSG1, _mm_set_epi64x(0x682E6FF35B9CCA4FULL, 0x4ED8AA4A391C0CB3ULL));
-    STATE1 = _mm_sha256rnds2_epu32(STATE1, STATE0, MSG);
-    TMP = _mm_alignr_epi8(MSG1, MSG0, 4);
-    MSG2 = _mm_add_epi32(MSG2, TMP);
-    MSG2 = _mm_sha256msg2_epu32(MSG2, MSG1);
-    MSG = _mm_shuffle_epi32(MSG, 0x0E);
-    STATE0 = _mm_sha256rnds2_epu32(STATE0, STATE1, MSG);
-
-    // Rounds 56-59
-    MSG = _mm_add_epi32(MSG2, _mm_set_epi64x(0x8CC7020884C87814ULL, 0x78A5636F748F82EEULL));
-    STATE1 = _mm_sha256rnds2_epu32(STATE1, STATE0, MSG);
-    TMP = _mm_alignr_epi8(MSG2, MSG1, 4);
-    MSG3 = _mm_add_epi32(MSG3, TMP);
-    MSG3 = _mm_sha256msg2_epu32(MSG3, MSG2);
-    MSG = _mm_shuffle_epi32(MSG, 0x0E);
-    STATE0 = _mm_sha256rnds2_epu32(STATE0, STATE1, MSG);
-
-    // Rounds 60-63
-    MSG = _mm_add_epi32(MSG3, _mm_set_epi64x(0xC67178F2BEF9A3F7ULL, 0xA4506CEB90BEFFFAULL));
-    STATE1 = _mm_sha256rnds2_epu32(STATE1, STATE0, MSG);
-    MSG = _mm_shuffle_epi32(MSG, 0x0E);
-    STATE0 = _mm_sha256rnds2_epu32(STATE0, STATE1, MSG);
-
-    // Combine states
-    STATE0 = _mm_add_epi32(STATE0, ABEF_SAVE);
-    STATE1 = _mm_add_epi32(STATE1, CDGH_SAVE);
+        // Rounds 0-3
+        //MSG = _mm_loadu_si128((const __m128i*) (data+0));
+        MSG0 = _mm_shuffle_epi8(MSG, MASK);
+        MSG = _mm_add_epi32(MSG0, _mm_set_epi64x(0xE9B5DBA5B5C0FBCFULL, 0x71374491428A2F98ULL));
+        STATE1 = _mm_sha256rnds2_epu32(STATE1, STATE0, MSG);
+        MSG = _mm_shuffle_epi32(MSG, 0x0E);
+        STATE0 = _mm_sha256rnds2_epu32(STATE0, STATE1, MSG);
+
+        // Rounds 4-7
+        //MSG1 = _mm_loadu_si128((const __m128i*) (data+16));
+        MSG1 = _mm_shuffle_epi8(MSG1, MASK);
+        MSG = _mm_add_epi32(MSG1, _mm_set_epi64x(0xAB1C5ED5923F82A4ULL, 0x59F111F13956C25BULL));
+        STATE1 = _mm_sha256rnds2_epu32(STATE1, STATE0, MSG);
+        MSG = _mm_shuffle_epi32(MSG, 0x0E);
+        STATE0 = _mm_sha256rnds2_epu32(STATE0, STATE1, MSG);
+        MSG0 = _mm_sha256msg1_epu32(MSG0, MSG1);
+
+        // Rounds 8-11
+        //MSG2 = _mm_loadu_si128((const __m128i*) (data+32));
+        MSG2 = _mm_shuffle_epi8(MSG2, MASK);
+        MSG = _mm_add_epi32(MSG2, _mm_set_epi64x(0x550C7DC3243185BEULL, 0x12835B01D807AA98ULL));
+        STATE1 = _mm_sha256rnds2_epu32(STATE1, STATE0, MSG);
+        MSG = _mm_shuffle_epi32(MSG, 0x0E);
+        STATE0 = _mm_sha256rnds2_epu32(STATE0, STATE1, MSG);
+        MSG1 = _mm_sha256msg1_epu32(MSG1, MSG2);
+
+        // Rounds 12-15
+        //MSG3 = _mm_loadu_si128((const __m128i*) (data+48));
+        MSG3 = _mm_shuffle_epi8(MSG3, MASK);
+        MSG = _mm_add_epi32(MSG3, _mm_set_epi64x(0xC19BF1749BDC06A7ULL, 0x80DEB1FE72BE5D74ULL));
+        STATE1 = _mm_sha256rnds2_epu32(STATE1, STATE0, MSG);
+        TMP = _mm_alignr_epi8(MSG3, MSG2, 4);
+        MSG0 = _mm_add_epi32(MSG0, TMP);
+        MSG0 = _mm_sha256msg2_epu32(MSG0, MSG3);
+        MSG = _mm_shuffle_epi32(MSG, 0x0E);
+        STATE0 = _mm_sha256rnds2_epu32(STATE0, STATE1, MSG);
+        MSG2 = _mm_sha256msg1_epu32(MSG2, MSG3);
+
+        // Rounds 16-19
+        MSG = _mm_add_epi32(MSG0, _mm_set_epi64x(0x240CA1CC0FC19DC6ULL, 0xEFBE4786E49B69C1ULL));
+        STATE1 = _mm_sha256rnds2_epu32(STATE1, STATE0, MSG);
+        TMP = _mm_alignr_epi8(MSG0, MSG3, 4);
+        MSG1 = _mm_add_epi32(MSG1, TMP);
+        MSG1 = _mm_sha256msg2_epu32(MSG1, MSG0);
+        MSG = _mm_shuffle_epi32(MSG, 0x0E);
+        STATE0 = _mm_sha256rnds2_epu32(STATE0, STATE1, MSG);
+        MSG3 = _mm_sha256msg1_epu32(MSG3, MSG0);
+
+        // Rounds 20-23
+        MSG = _mm_add_epi32(MSG1, _mm_set_epi64x(0x76F988DA5CB0A9DCULL, 0x4A7484AA2DE92C6FULL));
+        STATE1 = _mm_sha256rnds2_epu32(STATE1, STATE0, MSG);
+        TMP = _mm_alignr_epi8(MSG1, MSG0, 4);
+        MSG2 = _mm_add_epi32(MSG2, TMP);
+        MSG2 = _mm_sha256msg2_epu32(MSG2, MSG1);
+        MSG = _mm_shuffle_epi32(MSG, 0x0E);
+        STATE0 = _mm_sha256rnds2_epu32(STATE0, STATE1, MSG);
+        MSG0 = _mm_sha256msg1_epu32(MSG0, MSG1);
+
+        // Rounds 24-27
+        MSG = _mm_add_epi32(MSG2, _mm_set_epi64x(0xBF597FC7B00327C8ULL, 0xA831C66D983E5152ULL));
+        STATE1 = _mm_sha256rnds2_epu32(STATE1, STATE0, MSG);
+        TMP = _mm_alignr_epi8(MSG2, MSG1, 4);
+        MSG3 = _mm_add_epi32(MSG3, TMP);
+        MSG3 = _mm_sha256msg2_epu32(MSG3, MSG2);
+        MSG = _mm_shuffle_epi32(MSG, 0x0E);
+        STATE0 = _mm_sha256rnds2_epu32(STATE0, STATE1, MSG);
+        MSG1 = _mm_sha256msg1_epu32(MSG1, MSG2);
+
+        // Rounds 28-31
+        MSG = _mm_add_epi32(MSG3, _mm_set_epi64x(0x1429296706CA6351ULL,  0xD5A79147C6E00BF3ULL));
+        STATE1 = _mm_sha256rnds2_epu32(STATE1, STATE0, MSG);
+        TMP = _mm_alignr_epi8(MSG3, MSG2, 4);
+        MSG0 = _mm_add_epi32(MSG0, TMP);
+        MSG0 = _mm_sha256msg2_epu32(MSG0, MSG3);
+        MSG = _mm_shuffle_epi32(MSG, 0x0E);
+        STATE0 = _mm_sha256rnds2_epu32(STATE0, STATE1, MSG);
+        MSG2 = _mm_sha256msg1_epu32(MSG2, MSG3);
+
+        // Rounds 32-35
+        MSG = _mm_add_epi32(MSG0, _mm_set_epi64x(0x53380D134D2C6DFCULL, 0x2E1B213827B70A85ULL));
+        STATE1 = _mm_sha256rnds2_epu32(STATE1, STATE0, MSG);
+        TMP = _mm_alignr_epi8(MSG0, MSG3, 4);
+        MSG1 = _mm_add_epi32(MSG1, TMP);
+        MSG1 = _mm_sha256msg2_epu32(MSG1, MSG0);
+        MSG = _mm_shuffle_epi32(MSG, 0x0E);
+        STATE0 = _mm_sha256rnds2_epu32(STATE0, STATE1, MSG);
+        MSG3 = _mm_sha256msg1_epu32(MSG3, MSG0);
+
+        // Rounds 36-39
+        MSG = _mm_add_epi32(MSG1, _mm_set_epi64x(0x92722C8581C2C92EULL, 0x766A0ABB650A7354ULL));
+        STATE1 = _mm_sha256rnds2_epu32(STATE1, STATE0, MSG);
+        TMP = _mm_alignr_epi8(MSG1, MSG0, 4);
+        MSG2 = _mm_add_epi32(MSG2, TMP);
+        MSG2 = _mm_sha256msg2_epu32(MSG2, MSG1);
+        MSG = _mm_shuffle_epi32(MSG, 0x0E);
+        STATE0 = _mm_sha256rnds2_epu32(STATE0, STATE1, MSG);
+        MSG0 = _mm_sha256msg1_epu32(MSG0, MSG1);
+
+        // Rounds 40-43
+        MSG = _mm_add_epi32(MSG2, _mm_set_epi64x(0xC76C51A3C24B8B70ULL, 0xA81A664BA2BFE8A1ULL));
+        STATE1 = _mm_sha256rnds2_epu32(STATE1, STATE0, MSG);
+        TMP = _mm_alignr_epi8(MSG2, MSG1, 4);
+        MSG3 = _mm_add_epi32(MSG3, TMP);
+        MSG3 = _mm_sha256msg2_epu32(MSG3, MSG2);
+        MSG = _mm_shuffle_epi32(MSG, 0x0E);
+        STATE0 = _mm_sha256rnds2_epu32(STATE0, STATE1, MSG);
+        MSG1 = _mm_sha256msg1_epu32(MSG1, MSG2);
+
+        // Rounds 44-47
+        MSG = _mm_add_epi32(MSG3, _mm_set_epi64x(0x106AA070F40E3585ULL, 0xD6990624D192E819ULL));
+        STATE1 = _mm_sha256rnds2_epu32(STATE1, STATE0, MSG);
+        TMP = _mm_alignr_epi8(MSG3, MSG2, 4);
+        MSG0 = _mm_add_epi32(MSG0, TMP);
+        MSG0 = _mm_sha256msg2_epu32(MSG0, MSG3);
+        MSG = _mm_shuffle_epi32(MSG, 0x0E);
+        STATE0 = _mm_sha256rnds2_epu32(STATE0, STATE1, MSG);
+        MSG2 = _mm_sha256msg1_epu32(MSG2, MSG3);
+
+        // Rounds 48-51
+        MSG = _mm_add_epi32(MSG0, _mm_set_epi64x(0x34B0BCB52748774CULL, 0x1E376C0819A4C116ULL));
+        STATE1 = _mm_sha256rnds2_epu32(STATE1, STATE0, MSG);
+        TMP = _mm_alignr_epi8(MSG0, MSG3, 4);
+        MSG1 = _mm_add_epi32(MSG1, TMP);
+        MSG1 = _mm_sha256msg2_epu32(MSG1, MSG0);
+        MSG = _mm_shuffle_epi32(MSG, 0x0E);
+        STATE0 = _mm_sha256rnds2_epu32(STATE0, STATE1, MSG);
+        MSG3 = _mm_sha256msg1_epu32(MSG3, MSG0);
+
+        // Rounds 52-55
+        MSG = _mm_add_epi32(MSG1, _mm_set_epi64x(0x682E6FF35B9CCA4FULL, 0x4ED8AA4A391C0CB3ULL));
+        STATE1 = _mm_sha256rnds2_epu32(STATE1, STATE0, MSG);
+        TMP = _mm_alignr_epi8(MSG1, MSG0, 4);
+        MSG2 = _mm_add_epi32(MSG2, TMP);
+        MSG2 = _mm_sha256msg2_epu32(MSG2, MSG1);
+        MSG = _mm_shuffle_epi32(MSG, 0x0E);
+        STATE0 = _mm_sha256rnds2_epu32(STATE0, STATE1, MSG);
+
+        // Rounds 56-59
+        MSG = _mm_add_epi32(MSG2, _mm_set_epi64x(0x8CC7020884C87814ULL, 0x78A5636F748F82EEULL));
+        STATE1 = _mm_sha256rnds2_epu32(STATE1, STATE0, MSG);
+        TMP = _mm_alignr_epi8(MSG2, MSG1, 4);
+        MSG3 = _mm_add_epi32(MSG3, TMP);
+        MSG3 = _mm_sha256msg2_epu32(MSG3, MSG2);
+        MSG = _mm_shuffle_epi32(MSG, 0x0E);
+        STATE0 = _mm_sha256rnds2_epu32(STATE0, STATE1, MSG);
+
+        // Rounds 60-63
+        MSG = _mm_add_epi32(MSG3, _mm_set_epi64x(0xC67178F2BEF9A3F7ULL, 0xA4506CEB90BEFFFAULL));
+        STATE1 = _mm_sha256rnds2_epu32(STATE1, STATE0, MSG);
+        MSG = _mm_shuffle_epi32(MSG, 0x0E);
+        STATE0 = _mm_sha256rnds2_epu32(STATE0, STATE1, MSG);
+
+        // Combine states
+        STATE0 = _mm_add_epi32(STATE0, ABEF_SAVE);
+        STATE1 = _mm_add_epi32(STATE1, CDGH_SAVE);
+        
+        data += SHA256_BLOCK_LENGTH;
+        numOfBlocks--;
+    }
 
     TMP = _mm_shuffle_epi32(STATE0, 0x1B);       // FEBA
     STATE1 = _mm_shuffle_epi32(STATE1, 0xB1);    // DCHG
@@ -387,79 +424,164 @@ void Hasher<SHA256, HARDWARE>::TransformX86(const uint8_t* const data)
     STATE1 = _mm_alignr_epi8(STATE1, TMP, 8);    // ABEF
 
     // Save the new state
-    _mm_storeu_si128(reinterpret_cast<__m128i*>(&m_Context->state[0]), STATE0);
-    _mm_storeu_si128(reinterpret_cast<__m128i*>(&m_Context->state[4]), STATE1);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[0]), STATE0);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[4]), STATE1);
 }
 #endif
 
-void Hasher<SHA256, HARDWARE>::Transform(const uint8_t* const data)
+#if defined(HM_SIMD_X86)
+// SHA256 logic functions for the scalar rounds. rorx is used for the rotations when inlined into a BMI2 kernel
+inline static constexpr uint32_t Epsilon0(const uint32_t x)   { return std::rotr(x, 2) ^ std::rotr(x, 13) ^ std::rotr(x, 22); }
+inline static constexpr uint32_t Epsilon1(const uint32_t x)   { return std::rotr(x, 6) ^ std::rotr(x, 11) ^ std::rotr(x, 25); }
+inline static constexpr uint32_t Majority(const uint32_t x, const uint32_t y, const uint32_t z)   { return (x & y) ^ (x & z) ^ (y & z); }
+inline static constexpr uint32_t Choose(const uint32_t x, const uint32_t y, const uint32_t z)     { return (x & y) ^ (~x & z); }
+
+// One SHA256 round with precomputed W+K. The caller rotates the variables instead of moving them
+inline static constexpr void Round(const uint32_t a, const uint32_t b, const uint32_t c, uint32_t& d,
+                                   const uint32_t e, const uint32_t f, const uint32_t g, uint32_t& h, const uint32_t wk)
 {
-#if defined(HM_SIMD_ARM)
-    TransformARM(data);
-#elif defined(HM_SIMD_X86)
-    TransformX86(data);
-#endif
+    // The terms depending on e are added last, this keeps the dependency chain from round to round short
+    const uint32_t t1 = h + wk + Choose(e, f, g) + Epsilon1(e);
+    
+    d += t1;
+    h = t1 + Epsilon0(a) + Majority(a, b, c);
 }
 
-void Hasher<SHA256, HARDWARE>::Update(const uint8_t* const data, const uint64_t size)
+// Vectorized message schedule helpers. Every 128 bit lane holds 4 words of a different block
+template <int N>
+HM_TARGET("avx2") static inline __m256i Rotr32x8(const __m256i x)
+{
+    return _mm256_or_si256(_mm256_srli_epi32(x, N), _mm256_slli_epi32(x, 32 - N));
+}
+
+HM_TARGET("avx2") static inline __m256i Sigma0x8(const __m256i x)
+{
+    return _mm256_xor_si256(_mm256_xor_si256(Rotr32x8<7>(x), Rotr32x8<18>(x)), _mm256_srli_epi32(x, 3));
+}
+
+HM_TARGET("avx2") static inline __m256i Sigma1x8(const __m256i x)
+{
+    return _mm256_xor_si256(_mm256_xor_si256(Rotr32x8<17>(x), Rotr32x8<19>(x)), _mm256_srli_epi32(x, 10));
+}
+
+// Computes W[t..t+3] from the previous 16 words in x0..x3 (W[t-16..t-1])
+HM_TARGET("avx2") static inline __m256i ScheduleAVX2(const __m256i x0, const __m256i x1, const __m256i x2, const __m256i x3)
+{
+    const __m256i w7 = _mm256_alignr_epi8(x3, x2, 4);    // W[t-7..t-4]
+    const __m256i w15 = _mm256_alignr_epi8(x1, x0, 4);   // W[t-15..t-12]
+    
+    __m256i w = _mm256_add_epi32(_mm256_add_epi32(x0, w7), Sigma0x8(w15));
+    
+    // W[t] and W[t+1] depend on W[t-2] and W[t-1], W[t+2] and W[t+3] on the just computed W[t] and W[t+1]
+    w = _mm256_add_epi32(w, Sigma1x8(_mm256_srli_si256(x3, 8)));
+    w = _mm256_add_epi32(w, Sigma1x8(_mm256_slli_si256(w, 8)));
+    
+    return w;
+}
+
+// Kernel for CPUs without SHA extensions. Computes the message schedule of two blocks at once with AVX2,
+// the rounds are scalar with rorx
+HM_TARGET("avx2,bmi,bmi2") void Hasher<SHA256, HARDWARE>::TransformAVX2(uint32_t* const state, const uint8_t* data, uint64_t numOfBlocks)
 {
-    if(!data)
-        throw std::invalid_argument("Data cannot be nullptr.");
+    const __m256i MASK = _mm256_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL, 0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
     
-    if(size == 0)
-        throw std::invalid_argument("Data size cannot be zero.");
+    // W+K of two blocks. Groups of 4 words of the first block alternate with the ones of the second block
+    alignas(32) uint32_t wk[2 * 64];
     
-    uint64_t dataIndex = 0;
-    uint64_t remainingBytes = size;
+    uint32_t a = state[0];
+    uint32_t b = state[1];
+    uint32_t c = state[2];
+    uint32_t d = state[3];
+    uint32_t e = state[4];
+    uint32_t f = state[5];
+    uint32_t g = state[6];
+    uint32_t h = state[7];
     
-    while(remainingBytes > 0)
+    while(numOfBlocks > 0)
     {
-        if(m_Context->bufferSize > 0)
+        // For a single remaining block the schedule of the second lane is computed but not used
+        const uint64_t numOfBlocksInRun = std::min<uint64_t>(numOfBlocks, 2);
+        const uint8_t* const secondBlock = data + (numOfBlocksInRun - 1) * SHA256_BLOCK_LENGTH;
+        
+        __m256i x[4];
+        for(uint32_t i = 0; i < 4; i++)
         {
-            // Buffer is already partially filled and untransformed
-            const uint64_t remainingBufferSpace = SHA256_BLOCK_LENGTH - m_Context->bufferSize;
-            const uint64_t bytesToCopy = std::min(remainingBytes, remainingBufferSpace);
+            const __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16 * i));
+            const __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(secondBlock + 16 * i));
             
-            // Copy
-            std::copy(data + dataIndex, data + dataIndex + bytesToCopy, m_Context->buffer + m_Context->bufferSize);
-            m_Context->bufferSize += bytesToCopy;
-            m_Context->numOfBits += (bytesToCopy << 3);
-            dataIndex += bytesToCopy;
-            remainingBytes -= bytesToCopy;
+            x[i] = _mm256_shuffle_epi8(_mm256_inserti128_si256(_mm256_castsi128_si256(first), second, 1), MASK); // Convert to big endian
+            _mm256_store_si256(reinterpret_cast<__m256i*>(&wk[8 * i]), _mm256_add_epi32(x[i], _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&K[4 * i])))));
+        }
+        
+        for(uint32_t i = 4; i < 16; i++)
+        {
+            const __m256i w = ScheduleAVX2(x[0], x[1], x[2], x[3]);
+            x[0] = x[1];
+            x[1] = x[2];
+            x[2] = x[3];
+            x[3] = w;
             
-            // Check if buffer is completely filled now
-            if(m_Context->bufferSize == SHA256_BLOCK_LENGTH)
-            {
-                // Buffer is full, transform it now
-                Transform(m_Context->buffer);
-                m_Context->bufferSize = 0;
-            }
+            _mm256_store_si256(reinterpret_cast<__m256i*>(&wk[8 * i]), _mm256_add_epi32(w, _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&K[4 * i])))));
         }
-        else
+        
+        for(uint64_t n = 0; n < numOfBlocksInRun; n++)
         {
-            // Buffer is empty
-            if(remainingBytes >= SHA256_BLOCK_LENGTH)
-            {
-                // Copy one whole block in empty buffer and transform it
-                std::copy(data + dataIndex, data + dataIndex + SHA256_BLOCK_LENGTH, m_Context->buffer);
-                m_Context->numOfBits += 512;
-                dataIndex += SHA256_BLOCK_LENGTH;
-                remainingBytes -= SHA256_BLOCK_LENGTH;
-                
-                // Transform
-                Transform(m_Context->buffer);
-            }
-            else
+            const uint32_t* const blockWK = &wk[4 * n];
+            
+            const uint32_t aSave = a;
+            const uint32_t bSave = b;
+            const uint32_t cSave = c;
+            const uint32_t dSave = d;
+            const uint32_t eSave = e;
+            const uint32_t fSave = f;
+            const uint32_t gSave = g;
+            const uint32_t hSave = h;
+            
+            for(uint32_t i = 0; i < 64; i += 8)
             {
-                // Copy partial (last) block to buffer, transform it inside the End() method
-                std::copy(data + dataIndex, data + dataIndex + remainingBytes, m_Context->buffer);
-                m_Context->bufferSize += remainingBytes;
-                m_Context->numOfBits += (m_Context->bufferSize << 3);
-                //dataIndex += remainingBytes;
-                remainingBytes = 0; // Terminate loop
+                Round(a, b, c, d, e, f, g, h, blockWK[2 * i + 0]);
+                Round(h, a, b, c, d, e, f, g, blockWK[2 * i + 1]);
+                Round(g, h, a, b, c, d, e, f, blockWK[2 * i + 2]);
+                Round(f, g, h, a, b, c, d, e, blockWK[2 * i + 3]);
+                Round(e, f, g, h, a, b, c, d, blockWK[2 * i + 8]);
+                Round(d, e, f, g, h, a, b, c, blockWK[2 * i + 9]);
+                Round(c, d, e, f, g, h, a, b, blockWK[2 * i + 10]);
+                Round(b, c, d, e, f, g, h, a, blockWK[2 * i + 11]);
             }
+            
+            a += aSave;
+            b += bSave;
+            c += cSave;
+            d += dSave;
+            e += eSave;
+            f += fSave;
+            g += gSave;
+            h += hSave;
         }
+        
+        data += numOfBlocksInRun * SHA256_BLOCK_LENGTH;
+        numOfBlocks -= numOfBlocksInRun;
     }
+    
+    state[0] = a;
+    state[1] = b;
+    state[2] = c;
+    state[3] = d;
+    state[4] = e;
+    state[5] = f;
+    state[6] = g;
+    state[7] = h;
+    
+    // Cleanup sensitive data for security
+#ifdef HM_CLEANUP_TMP_MEMORY_AFTER_HASHING_FOR_SECURITY
+    std::memset(wk, 0, sizeof(wk));
+#endif
+}
+#endif
+
+void Hasher<SHA256, HARDWARE>::Update(const uint8_t* const data, const uint64_t size)
+{
+    Absorb(*m_Context, m_TransformFunction, data, size);
 }
 
 void Hasher<SHA256, HARDWARE>::Update(const std::vector<uint8_t>& data)
@@ -474,52 +596,18 @@ void Hasher<SHA256, HARDWARE>::Update(const std::string& str)
 
 std::vector<uint8_t> Hasher<SHA256, HARDWARE>::End()
 {
-#ifndef NDEBUG
-    if(m_Context->bufferSize == SHA256_BLOCK_LENGTH) // Check for bug
-        throw std::runtime_error("Buffer should never be completely filled and untransformed when entering the End() function.");
-#endif
-    
-    // Pad last block
-    if(m_Context->bufferSize < SHA256_BLOCK_LENGTH - 8)
-    {
-        std::memset(m_Context->buffer + m_Context->bufferSize, 0x00, SHA256_BLOCK_LENGTH - 8 - m_Context->bufferSize);
-        m_Context->buffer[m_Context->bufferSize] = 0x80;
-    }
-    else
-    {
-        std::memset(m_Context->buffer + m_Context->bufferSize, 0x00, SHA256_BLOCK_LENGTH - m_Context->bufferSize);
-        m_Context->buffer[m_Context->bufferSize] = 0x80;
-        
-        Transform(m_Context->buffer);
-        
-        std::memset(m_Context->buffer, 0x00, SHA256_BLOCK_LENGTH - 8);
-    }
-    
-    // Append full message length to padding block
-    m_Context->buffer[SHA256_BLOCK_LENGTH - 1] = static_cast<uint8_t>(m_Context->numOfBits);
-    m_Context->buffer[SHA256_BLOCK_LENGTH - 2] = static_cast<uint8_t>(m_Context->numOfBits >> 8);
-    m_Context->buffer[SHA256_BLOCK_LENGTH - 3] = static_cast<uint8_t>(m_Context->numOfBits >> 16);
-    m_Context->buffer[SHA256_BLOCK_LENGTH - 4] = static_cast<uint8_t>(m_Context->numOfBits >> 24);
-    m_Context->buffer[SHA256_BLOCK_LENGTH - 5] = static_cast<uint8_t>(m_Context->numOfBits >> 32);
-    m_Context->buffer[SHA256_BLOCK_LENGTH - 6] = static_cast<uint8_t>(m_Context->numOfBits >> 40);
-    m_Context->buffer[SHA256_BLOCK_LENGTH - 7] = static_cast<uint8_t>(m_Context->numOfBits >> 48);
-    m_Context->buffer[SHA256_BLOCK_LENGTH - 8] = static_cast<uint8_t>(m_Context->numOfBits >> 56);
-    
-    // Transform
-    Transform(m_Context->buffer);
-    
-    // Assemble hash
     std::vector<uint8_t> hash(32); // 256 bit hash
-    for(uint32_t i = 0; i < 8; i++)
-    {
-#ifdef HM_LITTLE_ENDIAN
-        Utils::U32toU8<Utils::REVERSE_ENDIANNESS>(m_Context->state[i], &hash[i << 2]); // Transform SHA big endian to host little endian
-#else
-        Utils::U32toU8<Utils::KEEP_ENDIANNESS>(m_Context->state[i], &hash[i << 2]);
-#endif
-    }
+    Finalize(*m_Context, m_TransformFunction, hash.data(), 32);
     
     return hash;
 }
 
+void Hasher<SHA256, HARDWARE>::HashShort(const uint8_t* const data, const uint64_t size, uint8_t* const digest)
+{
+    // There is no hasher object to store the kernel in, select it once
+    static const TransformFunction transform = SelectTransformFunction();
+    
+    HashSingleBlock(transform, INITIAL_HASH_VALUES, data, size, digest, 32);
+}
+
 #endif /* HM_SIMD_ARM || HM_SIMD_X86 */
@@ -0,0 +1,55 @@
+/*
+    The zlib License
+
+    Copyright (C) 2024 Marc Schöndorf
+ 
+This software is provided 'as-is', without any express or implied warranty. In
+no event will the authors be held liable for any damages arising from the use of
+this software.
+
+Permission is granted to anyone to use this software for any purpose, including
+commercial applications, and to alter it and redistribute it freely, subject to
+the following restrictions:
+
+1.  The origin of this software must not be misrepresented; you must not claim
+    that you wrote the original software. If you use this software in a product,
+    an acknowledgment in the product documentation would be appreciated but is
+    not required.
+
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+
+3.  This notice may not be removed or altered from any source distribution.
+*/
+
+
+/*------------------------------------------------------------------*/
+/*                                                                  */
+/*                      (C) 2024 Marc Schöndorf                     */
+/*                            See license                           */
+/*                                                                  */
+/*  SHA384_Batch.cpp                                                */
+/*  Created: 16.10.2026                                             */
+/*------------------------------------------------------------------*/
+
+
+#include "HashMe.hpp"
+
+using namespace HashMe;
+
+void BatchHasher<SHA384>::Hash(const std::vector<std::span<const uint8_t>>& messages, uint8_t* const digests) const
+{
+    HashMessages(messages, digests, Hasher<SHA384, SOFTWARE>::INITIAL_HASH_VALUES, 48);
+}
+
+std::vector<std::vector<uint8_t>> BatchHasher<SHA384>::Hash(const std::vector<std::span<const uint8_t>>& messages) const
+{
+    std::vector<uint8_t> digests(messages.size() * 48);
+    Hash(messages, digests.data());
+    
+    std::vector<std::vector<uint8_t>> result(messages.size());
+    for(uint64_t i = 0; i < messages.size(); i++)
+        result[i].assign(digests.begin() + static_cast<std::ptrdiff_t>(i * 48), digests.begin() + static_cast<std::ptrdiff_t>((i + 1) * 48));
+    
+    return result;
+}
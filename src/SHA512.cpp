@@ -63,11 +63,7 @@ Hasher<SHA512, SOFTWARE>::Hasher(const Hasher& other)
 
 void Hasher<SHA512, SOFTWARE>::Initialize()
 {
-    // Set state to initial hash values
-    std::copy(INITIAL_HASH_VALUES.begin(), INITIAL_HASH_VALUES.end(), m_Context->state);
-    
-    m_Context->bufferSize = 0;
-    m_Context->numOfBits = 0;
+    InitializeContext(*m_Context, INITIAL_HASH_VALUES);
 }
 
 void Hasher<SHA512, SOFTWARE>::Reset()
@@ -78,138 +74,93 @@ void Hasher<SHA512, SOFTWARE>::Reset()
     std::memset(m_Context->buffer, 0, SHA512_BLOCK_LENGTH);
 }
 
-// Optimized transform function
-void Hasher<SHA512, SOFTWARE>::Transform(const uint8_t* const data)
+// Optimized transform function for multiple consecutive blocks. The state is kept in local variables for the whole run
+void Hasher<SHA512, SOFTWARE>::TransformSoftware(uint64_t* const stateOut, const uint8_t* data, uint64_t numOfBlocks)
 {
-    uint64_t block[SHA512_BLOCK_LENGTH];
+    uint64_t block[16];
     
-    // Initial values
-    uint64_t a = m_Context->state[0];
-    uint64_t b = m_Context->state[1];
-    uint64_t c = m_Context->state[2];
-    uint64_t d = m_Context->state[3];
-    uint64_t e = m_Context->state[4];
-    uint64_t f = m_Context->state[5];
-    uint64_t g = m_Context->state[6];
-    uint64_t h = m_Context->state[7];
-    uint64_t t1;
-    uint64_t t2;
+    uint64_t state[8];
+    std::copy(stateOut, stateOut + 8, state);
     
-    uint8_t x = 0;
-    uint8_t i = 0;
-    for(; i < 16; i++)
+    for(uint64_t n = 0; n < numOfBlocks; n++)
     {
-        // Copy 1-byte data to 8-byte array
+        const uint8_t* const blockData = data + n * SHA512_BLOCK_LENGTH;
+        
+        // Initial values
+        uint64_t a = state[0];
+        uint64_t b = state[1];
+        uint64_t c = state[2];
+        uint64_t d = state[3];
+        uint64_t e = state[4];
+        uint64_t f = state[5];
+        uint64_t g = state[6];
+        uint64_t h = state[7];
+        uint64_t t1;
+        uint64_t t2;
+        
+        uint8_t x = 0;
+        uint8_t i = 0;
+        for(; i < 16; i++)
+        {
+            // Copy 1-byte data to 8-byte array
 #ifdef HM_LITTLE_ENDIAN
-        block[i] = Utils::U8toU64<Utils::REVERSE_ENDIANNESS>(&data[x]); // Convert to big endian
+            block[i] = Utils::U8toU64<Utils::REVERSE_ENDIANNESS>(&blockData[x]); // Convert to big endian
 #else
-        block[i] = Utils::U8toU64<Utils::KEEP_ENDIANNESS>(&data[x]);
+            block[i] = Utils::U8toU64<Utils::KEEP_ENDIANNESS>(&blockData[x]);
 #endif
-        x += 8;
+            x += 8;
+            
+            t1 = h + Epsilon1(e) + Choose(e, f, g) + K[i] + block[i];
+            t2 = Epsilon0(a) + Majority(a, b, c);
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
         
-        t1 = h + Epsilon1(e) + Choose(e, f, g) + K[i] + block[i];
-        t2 = Epsilon0(a) + Majority(a, b, c);
-        h = g;
-        g = f;
-        f = e;
-        e = d + t1;
-        d = c;
-        c = b;
-        b = a;
-        a = t1 + t2;
-    }
-    
-    for(; i < 80; i++)
-    {
-        block[i & 0xF] += block[(i + 9) & 0xF] + Sigma0(block[(i + 1) & 0x0F]) + Sigma1(block[(i + 14) & 0x0F]);
+        for(; i < 80; i++)
+        {
+            block[i & 0x0F] += block[(i + 9) & 0x0F] + Sigma0(block[(i + 1) & 0x0F]) + Sigma1(block[(i + 14) & 0x0F]);
+            
+            t1 = h + Epsilon1(e) + Choose(e, f, g) + K[i] + block[i & 0x0F];
+            t2 = Epsilon0(a) + Majority(a, b, c);
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
         
-        t1 = h + Epsilon1(e) + Choose(e, f, g) + K[i] + block[i & 0xF];
-        t2 = Epsilon0(a) + Majority(a, b, c);
-        h = g;
-        g = f;
-        f = e;
-        e = d + t1;
-        d = c;
-        c = b;
-        b = a;
-        a = t1 + t2;
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
     }
     
-    m_Context->state[0] += a;
-    m_Context->state[1] += b;
-    m_Context->state[2] += c;
-    m_Context->state[3] += d;
-    m_Context->state[4] += e;
-    m_Context->state[5] += f;
-    m_Context->state[6] += g;
-    m_Context->state[7] += h;
+    // Write back the state once at the end of the run
+    std::copy(state, state + 8, stateOut);
     
     // Cleanup sensitive data for security
 #ifdef HM_CLEANUP_TMP_MEMORY_AFTER_HASHING_FOR_SECURITY
-    a = b = c = d = e = f = g = h = t1 = t2 = 0;
+    std::memset(block, 0, sizeof(block));
+    std::memset(state, 0, sizeof(state));
 #endif
 }
 
-// Optimized update function
 void Hasher<SHA512, SOFTWARE>::Update(const uint8_t* const data, const uint64_t size)
 {
-    if(!data)
-        throw std::invalid_argument("Data cannot be nullptr.");
-    
-    if(size == 0)
-        throw std::invalid_argument("Data size cannot be zero.");
-    
-    uint64_t dataIndex = 0;
-    uint64_t remainingBytes = size;
-    
-    while(remainingBytes > 0)
-    {
-        if(m_Context->bufferSize > 0)
-        {
-            // Buffer is already partially filled and untransformed
-            const uint64_t remainingBufferSpace = SHA512_BLOCK_LENGTH - m_Context->bufferSize;
-            const uint64_t bytesToCopy = std::min(remainingBytes, remainingBufferSpace);
-
-            // Copy
-            std::copy(data + dataIndex, data + dataIndex + bytesToCopy, m_Context->buffer + m_Context->bufferSize);
-            m_Context->bufferSize += bytesToCopy;
-            m_Context->numOfBits += (bytesToCopy << 3);
-            dataIndex += bytesToCopy;
-            remainingBytes -= bytesToCopy;
-            
-            // Check if buffer is completely filled now
-            if(m_Context->bufferSize == SHA512_BLOCK_LENGTH)
-            {
-                // Buffer is full, transform it now
-                Transform(m_Context->buffer);
-                m_Context->bufferSize = 0;
-            }
-        }
-        else
-        {
-            // Buffer is empty
-            if(remainingBytes >= SHA512_BLOCK_LENGTH)
-            {
-                // Copy one whole block in empty buffer and transform it
-                std::copy(data + dataIndex, data + dataIndex + SHA512_BLOCK_LENGTH, m_Context->buffer);
-                m_Context->numOfBits += 1024;
-                dataIndex += SHA512_BLOCK_LENGTH;
-                remainingBytes -= SHA512_BLOCK_LENGTH;
-                
-                // Transform
-                Transform(m_Context->buffer);
-            }
-            else
-            {
-                // Copy partial (last) block to buffer, transform it inside the End() method
-                std::copy(data + dataIndex, data + dataIndex + remainingBytes, m_Context->buffer);
-                m_Context->bufferSize += remainingBytes;
-                m_Context->numOfBits += (m_Context->bufferSize << 3);
-                //dataIndex += remainingBytes;
-                remainingBytes = 0; // Terminate loop
-            }
-        }
-    }
+    Absorb(*m_Context, TransformSoftware, data, size);
 }
 
 void Hasher<SHA512, SOFTWARE>::Update(const std::vector<uint8_t>& data)
@@ -224,50 +175,13 @@ void Hasher<SHA512, SOFTWARE>::Update(const std::string& str)
 
 std::vector<uint8_t> Hasher<SHA512, SOFTWARE>::End()
 {
-#ifndef NDEBUG
-    if(m_Context->bufferSize == SHA512_BLOCK_LENGTH) // Check for bug
-        throw std::runtime_error("Buffer should never be completely filled and untransformed when entering the End() function.");
-#endif
-    
-    // Pad last block
-    if(m_Context->bufferSize < SHA512_BLOCK_LENGTH - 8)
-    {
-        std::memset(m_Context->buffer + m_Context->bufferSize, 0x00, SHA512_BLOCK_LENGTH - 8 - m_Context->bufferSize);
-        m_Context->buffer[m_Context->bufferSize] = 0x80;
-    }
-    else
-    {
-        std::memset(m_Context->buffer + m_Context->bufferSize, 0x00, SHA512_BLOCK_LENGTH - m_Context->bufferSize);
-        m_Context->buffer[m_Context->bufferSize] = 0x80;
-        
-        Transform(m_Context->buffer);
-        
-        std::memset(m_Context->buffer, 0x00, SHA512_BLOCK_LENGTH - 8);
-    }
-    
-    // Append full message length to padding block
-    m_Context->buffer[SHA512_BLOCK_LENGTH - 1] = static_cast<uint8_t>(m_Context->numOfBits);
-    m_Context->buffer[SHA512_BLOCK_LENGTH - 2] = static_cast<uint8_t>(m_Context->numOfBits >> 8);
-    m_Context->buffer[SHA512_BLOCK_LENGTH - 3] = static_cast<uint8_t>(m_Context->numOfBits >> 16);
-    m_Context->buffer[SHA512_BLOCK_LENGTH - 4] = static_cast<uint8_t>(m_Context->numOfBits >> 24);
-    m_Context->buffer[SHA512_BLOCK_LENGTH - 5] = static_cast<uint8_t>(m_Context->numOfBits >> 32);
-    m_Context->buffer[SHA512_BLOCK_LENGTH - 6] = static_cast<uint8_t>(m_Context->numOfBits >> 40);
-    m_Context->buffer[SHA512_BLOCK_LENGTH - 7] = static_cast<uint8_t>(m_Context->numOfBits >> 48);
-    m_Context->buffer[SHA512_BLOCK_LENGTH - 8] = static_cast<uint8_t>(m_Context->numOfBits >> 56);
-    
-    // Transform
-    Transform(m_Context->buffer);
-    
-    // Assemble hash
     std::vector<uint8_t> hash(64); // 512 bit hash
-    for(uint32_t i = 0; i < 8; i++)
-    {
-#ifdef HM_LITTLE_ENDIAN
-        Utils::U64toU8<Utils::REVERSE_ENDIANNESS>(m_Context->state[i], &hash[i << 3]); // Transform SHA big endian to host little endian
-#else
-        Utils::U64toU8<Utils::KEEP_ENDIANNESS>(m_Context->state[i], &hash[i << 3]);
-#endif
-    }
+    Finalize(*m_Context, TransformSoftware, hash.data(), 64);
     
     return hash;
 }
+
+void Hasher<SHA512, SOFTWARE>::HashShort(const uint8_t* const data, const uint64_t size, uint8_t* const digest)
+{
+    HashSingleBlock(TransformSoftware, INITIAL_HASH_VALUES, data, size, digest, 64);
+}
@@ -0,0 +1,71 @@
+/*
+    The zlib License
+
+    Copyright (C) 2024 Marc Schöndorf
+ 
+This software is provided 'as-is', without any express or implied warranty. In
+no event will the authors be held liable for any damages arising from the use of
+this software.
+
+Permission is granted to anyone to use this software for any purpose, including
+commercial applications, and to alter it and redistribute it freely, subject to
+the following restrictions:
+
+1.  The origin of this software must not be misrepresented; you must not claim
+    that you wrote the original software. If you use this software in a product,
+    an acknowledgment in the product documentation would be appreciated but is
+    not required.
+
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+
+3.  This notice may not be removed or altered from any source distribution.
+*/
+
+/*------------------------------------------------------------------*/
+/*                                                                  */
+/*                      (C) 2024 Marc Schöndorf                     */
+/*                            See license                           */
+/*                                                                  */
+/*  SHA512_256.cpp                                                  */
+/*  Created: 16.10.2026                                             */
+/*------------------------------------------------------------------*/
+
+#include "HashMe.hpp"
+
+using namespace HashMe;
+
+Hasher<SHA512_256, SOFTWARE>::Hasher()
+{
+    Initialize();
+}
+
+Hasher<SHA512_256, SOFTWARE>::Hasher(const Hasher& other) : Hasher<SHA512, SOFTWARE>(other)
+{
+}
+
+void Hasher<SHA512_256, SOFTWARE>::Initialize()
+{
+    InitializeContext(*m_Context, INITIAL_HASH_VALUES);
+}
+
+void Hasher<SHA512_256, SOFTWARE>::Reset()
+{
+    Initialize();
+    
+    // Zero out buffer
+    std::memset(m_Context->buffer, 0, SHA512_BLOCK_LENGTH);
+}
+
+std::vector<uint8_t> Hasher<SHA512_256, SOFTWARE>::End()
+{
+    std::vector<uint8_t> hash(32); // 256 bit hash
+    Finalize(*m_Context, TransformSoftware, hash.data(), 32);
+    
+    return hash;
+}
+
+void Hasher<SHA512_256, SOFTWARE>::HashShort(const uint8_t* const data, const uint64_t size, uint8_t* const digest)
+{
+    HashSingleBlock(TransformSoftware, INITIAL_HASH_VALUES, data, size, digest, 32);
+}
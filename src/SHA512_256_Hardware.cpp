@@ -0,0 +1,78 @@
+/*
+    The zlib License
+
+    Copyright (C) 2024 Marc Schöndorf
+ 
+This software is provided 'as-is', without any express or implied warranty. In
+no event will the authors be held liable for any damages arising from the use of
+this software.
+
+Permission is granted to anyone to use this software for any purpose, including
+commercial applications, and to alter it and redistribute it freely, subject to
+the following restrictions:
+
+1.  The origin of this software must not be misrepresented; you must not claim
+    that you wrote the original software. If you use this software in a product,
+    an acknowledgment in the product documentation would be appreciated but is
+    not required.
+
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+
+3.  This notice may not be removed or altered from any source distribution.
+*/
+
+/*------------------------------------------------------------------*/
+/*                                                                  */
+/*                      (C) 2024 Marc Schöndorf                     */
+/*                            See license                           */
+/*                                                                  */
+/*  SHA512_256_Hardware.cpp                                         */
+/*  Created: 16.10.2026                                             */
+/*------------------------------------------------------------------*/
+
+#include "HashMe.hpp"
+
+#if defined(HM_SIMD_ARM) || defined(HM_SIMD_X86)
+
+using namespace HashMe;
+
+Hasher<SHA512_256, HARDWARE>::Hasher()
+{
+    Initialize();
+}
+
+Hasher<SHA512_256, HARDWARE>::Hasher(const Hasher& other) : Hasher<SHA512, HARDWARE>(other)
+{
+}
+
+void Hasher<SHA512_256, HARDWARE>::Initialize()
+{
+    InitializeContext(*m_Context, INITIAL_HASH_VALUES);
+}
+
+void Hasher<SHA512_256, HARDWARE>::Reset()
+{
+    Initialize();
+    
+    // Zero out buffer
+    std::memset(m_Context->buffer, 0, SHA512_BLOCK_LENGTH);
+}
+
+std::vector<uint8_t> Hasher<SHA512_256, HARDWARE>::End()
+{
+    std::vector<uint8_t> hash(32); // 256 bit hash
+    Finalize(*m_Context, m_TransformFunction, hash.data(), 32);
+    
+    return hash;
+}
+
+void Hasher<SHA512_256, HARDWARE>::HashShort(const uint8_t* const data, const uint64_t size, uint8_t* const digest)
+{
+    // There is no hasher object to store the kernel in, select it once
+    static const TransformFunction transform = SelectTransformFunction();
+    
+    HashSingleBlock(transform, INITIAL_HASH_VALUES, data, size, digest, 32);
+}
+
+#endif /* HM_SIMD_ARM || HM_SIMD_X86 */
@@ -0,0 +1,442 @@
+/*
+    The zlib License
+
+    Copyright (C) 2024 Marc Schöndorf
+ 
+This software is provided 'as-is', without any express or implied warranty. In
+no event will the authors be held liable for any damages arising from the use of
+this software.
+
+Permission is granted to anyone to use this software for any purpose, including
+commercial applications, and to alter it and redistribute it freely, subject to
+the following restrictions:
+
+1.  The origin of this software must not be misrepresented; you must not claim
+    that you wrote the original software. If you use this software in a product,
+    an acknowledgment in the product documentation would be appreciated but is
+    not required.
+
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+
+3.  This notice may not be removed or altered from any source distribution.
+*/
+
+
+/*------------------------------------------------------------------*/
+/*                                                                  */
+/*                      (C) 2024 Marc Schöndorf                     */
+/*                            See license                           */
+/*                                                                  */
+/*  SHA512_Batch.cpp                                                */
+/*  Created: 16.10.2026                                             */
+/*------------------------------------------------------------------*/
+
+
+#include "HashMe.hpp"
+
+using namespace HashMe;
+
+#if defined(HM_SIMD_X86)
+// The rotations and logic functions inline _mm512_undefined_epi32(), which GCC declares self initialized.
+// This gives false positive uninitialized warnings for the whole kernel
+#if defined(HASH_PREDEF_COMP_GNUC_AVAILABLE) && !defined(HASH_PREDEF_COMP_CLANG_AVAILABLE) // GCC
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+// ***************************************************
+// AVX-512 helpers, every vector holds the same word of 8 different messages. Uses vprorq for the rotations
+// and vpternlogq for the three input logic functions
+HM_TARGET("avx512f") static inline __m512i Sigma0x8(const __m512i x)
+{
+    return _mm512_ternarylogic_epi64(_mm512_ror_epi64(x, 1), _mm512_ror_epi64(x, 8), _mm512_srli_epi64(x, 7), 0x96); // XOR
+}
+
+HM_TARGET("avx512f") static inline __m512i Sigma1x8(const __m512i x)
+{
+    return _mm512_ternarylogic_epi64(_mm512_ror_epi64(x, 19), _mm512_ror_epi64(x, 61), _mm512_srli_epi64(x, 6), 0x96); // XOR
+}
+
+HM_TARGET("avx512f") static inline __m512i Epsilon0x8(const __m512i x)
+{
+    return _mm512_ternarylogic_epi64(_mm512_ror_epi64(x, 28), _mm512_ror_epi64(x, 34), _mm512_ror_epi64(x, 39), 0x96); // XOR
+}
+
+HM_TARGET("avx512f") static inline __m512i Epsilon1x8(const __m512i x)
+{
+    return _mm512_ternarylogic_epi64(_mm512_ror_epi64(x, 14), _mm512_ror_epi64(x, 18), _mm512_ror_epi64(x, 41), 0x96); // XOR
+}
+
+// One SHA512 round for 8 lanes. The caller rotates the variables instead of moving them
+HM_TARGET("avx512f") static inline void Roundx8(const __m512i a, const __m512i b, const __m512i c, __m512i& d,
+                                                const __m512i e, const __m512i f, const __m512i g, __m512i& h, const __m512i wk)
+{
+    const __m512i choose = _mm512_ternarylogic_epi64(e, f, g, 0xCA);
+    const __m512i majority = _mm512_ternarylogic_epi64(a, b, c, 0xE8);
+    
+    const __m512i t1 = _mm512_add_epi64(_mm512_add_epi64(h, Epsilon1x8(e)), _mm512_add_epi64(choose, wk));
+    const __m512i t2 = _mm512_add_epi64(Epsilon0x8(a), majority);
+    
+    d = _mm512_add_epi64(d, t1);
+    h = _mm512_add_epi64(t1, t2);
+}
+
+// Transposes 8 rows of 8 words, so that out[i] holds word i of all rows
+HM_TARGET("avx512f,avx512bw") static inline void Transpose8x8(const __m512i (&rows)[8], __m512i* const out)
+{
+    const __m512i MASK = _mm512_set_epi64(0x08090a0b0c0d0e0fULL, 0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL, 0x0001020304050607ULL,
+                                          0x08090a0b0c0d0e0fULL, 0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL, 0x0001020304050607ULL);
+    
+    // Pairs of rows, t[2i] holds the even words, t[2i + 1] the odd words of rows 2i and 2i + 1
+    __m512i t[8];
+    for(uint32_t i = 0; i < 4; i++)
+    {
+        t[2 * i + 0] = _mm512_unpacklo_epi64(rows[2 * i], rows[2 * i + 1]);
+        t[2 * i + 1] = _mm512_unpackhi_epi64(rows[2 * i], rows[2 * i + 1]);
+    }
+    
+    // Groups of 4 rows. u[0] holds the words 0 and 4, u[1] 2 and 6, u[2] 1 and 5, u[3] 3 and 7 of rows 0 to 3
+    __m512i u[8];
+    for(uint32_t i = 0; i < 8; i += 4)
+    {
+        u[i + 0] = _mm512_shuffle_i64x2(t[i + 0], t[i + 2], 0x88);
+        u[i + 1] = _mm512_shuffle_i64x2(t[i + 0], t[i + 2], 0xDD);
+        u[i + 2] = _mm512_shuffle_i64x2(t[i + 1], t[i + 3], 0x88);
+        u[i + 3] = _mm512_shuffle_i64x2(t[i + 1], t[i + 3], 0xDD);
+    }
+    
+    // Convert to big endian
+    out[0] = _mm512_shuffle_epi8(_mm512_shuffle_i64x2(u[0], u[4], 0x88), MASK);
+    out[4] = _mm512_shuffle_epi8(_mm512_shuffle_i64x2(u[0], u[4], 0xDD), MASK);
+    out[2] = _mm512_shuffle_epi8(_mm512_shuffle_i64x2(u[1], u[5], 0x88), MASK);
+    out[6] = _mm512_shuffle_epi8(_mm512_shuffle_i64x2(u[1], u[5], 0xDD), MASK);
+    out[1] = _mm512_shuffle_epi8(_mm512_shuffle_i64x2(u[2], u[6], 0x88), MASK);
+    out[5] = _mm512_shuffle_epi8(_mm512_shuffle_i64x2(u[2], u[6], 0xDD), MASK);
+    out[3] = _mm512_shuffle_epi8(_mm512_shuffle_i64x2(u[3], u[7], 0x88), MASK);
+    out[7] = _mm512_shuffle_epi8(_mm512_shuffle_i64x2(u[3], u[7], 0xDD), MASK);
+}
+
+// Loads one block from each of the 8 lanes and transposes them, so that out[i] holds word i of all lanes
+HM_TARGET("avx512f,avx512bw") static inline void LoadTransposed8x16(const uint8_t* const* const data, const uint64_t offset, __m512i out[16])
+{
+    for(uint32_t half = 0; half < 2; half++)
+    {
+        __m512i rows[8];
+        for(uint32_t i = 0; i < 8; i++)
+            rows[i] = _mm512_loadu_si512(data[i] + offset + 64 * half);
+        
+        Transpose8x8(rows, out + 8 * half);
+    }
+}
+
+// Compresses one block for all lanes. W holds the message words and is overwritten by the message schedule
+HM_TARGET("avx512f") static inline void CompressBlockx8(__m512i& a, __m512i& b, __m512i& c, __m512i& d, __m512i& e, __m512i& f, __m512i& g, __m512i& h, __m512i (&W)[16], const uint64_t* const K)
+{
+    // Save current state
+    const __m512i aSave = a;
+    const __m512i bSave = b;
+    const __m512i cSave = c;
+    const __m512i dSave = d;
+    const __m512i eSave = e;
+    const __m512i fSave = f;
+    const __m512i gSave = g;
+    const __m512i hSave = h;
+    
+    for(uint32_t i = 0; i < 80; i += 8)
+    {
+        if(i >= 16)
+        {
+            // Message schedule for the next 8 rounds
+            for(uint32_t j = i; j < i + 8; j++)
+                W[j & 0x0F] = _mm512_add_epi64(_mm512_add_epi64(W[j & 0x0F], W[(j + 9) & 0x0F]), _mm512_add_epi64(Sigma0x8(W[(j + 1) & 0x0F]), Sigma1x8(W[(j + 14) & 0x0F])));
+        }
+        
+        Roundx8(a, b, c, d, e, f, g, h, _mm512_add_epi64(W[(i + 0) & 0x0F], _mm512_set1_epi64(static_cast<int64_t>(K[i + 0]))));
+        Roundx8(h, a, b, c, d, e, f, g, _mm512_add_epi64(W[(i + 1) & 0x0F], _mm512_set1_epi64(static_cast<int64_t>(K[i + 1]))));
+        Roundx8(g, h, a, b, c, d, e, f, _mm512_add_epi64(W[(i + 2) & 0x0F], _mm512_set1_epi64(static_cast<int64_t>(K[i + 2]))));
+        Roundx8(f, g, h, a, b, c, d, e, _mm512_add_epi64(W[(i + 3) & 0x0F], _mm512_set1_epi64(static_cast<int64_t>(K[i + 3]))));
+        Roundx8(e, f, g, h, a, b, c, d, _mm512_add_epi64(W[(i + 4) & 0x0F], _mm512_set1_epi64(static_cast<int64_t>(K[i + 4]))));
+        Roundx8(d, e, f, g, h, a, b, c, _mm512_add_epi64(W[(i + 5) & 0x0F], _mm512_set1_epi64(static_cast<int64_t>(K[i + 5]))));
+        Roundx8(c, d, e, f, g, h, a, b, _mm512_add_epi64(W[(i + 6) & 0x0F], _mm512_set1_epi64(static_cast<int64_t>(K[i + 6]))));
+        Roundx8(b, c, d, e, f, g, h, a, _mm512_add_epi64(W[(i + 7) & 0x0F], _mm512_set1_epi64(static_cast<int64_t>(K[i + 7]))));
+    }
+    
+    // Combine states
+    a = _mm512_add_epi64(a, aSave);
+    b = _mm512_add_epi64(b, bSave);
+    c = _mm512_add_epi64(c, cSave);
+    d = _mm512_add_epi64(d, dSave);
+    e = _mm512_add_epi64(e, eSave);
+    f = _mm512_add_epi64(f, fSave);
+    g = _mm512_add_epi64(g, gSave);
+    h = _mm512_add_epi64(h, hSave);
+}
+
+HM_TARGET("avx512f,avx512bw") void BatchHasher<SHA512>::TransformAVX512x8(uint64_t* const state, const uint8_t* const* const data, const uint64_t numOfBlocks)
+{
+    // Load state, it stays in registers for all blocks
+    __m512i a = _mm512_loadu_si512(&state[0 * 8]);
+    __m512i b = _mm512_loadu_si512(&state[1 * 8]);
+    __m512i c = _mm512_loadu_si512(&state[2 * 8]);
+    __m512i d = _mm512_loadu_si512(&state[3 * 8]);
+    __m512i e = _mm512_loadu_si512(&state[4 * 8]);
+    __m512i f = _mm512_loadu_si512(&state[5 * 8]);
+    __m512i g = _mm512_loadu_si512(&state[6 * 8]);
+    __m512i h = _mm512_loadu_si512(&state[7 * 8]);
+    
+    __m512i W[16];
+    
+    for(uint64_t n = 0; n < numOfBlocks; n++)
+    {
+        LoadTransposed8x16(data, n * SHA512_BLOCK_LENGTH, W);
+        
+        CompressBlockx8(a, b, c, d, e, f, g, h, W, Hasher<SHA512, SOFTWARE>::K.data());
+    }
+    
+    // Save the new state
+    _mm512_storeu_si512(&state[0 * 8], a);
+    _mm512_storeu_si512(&state[1 * 8], b);
+    _mm512_storeu_si512(&state[2 * 8], c);
+    _mm512_storeu_si512(&state[3 * 8], d);
+    _mm512_storeu_si512(&state[4 * 8], e);
+    _mm512_storeu_si512(&state[5 * 8], f);
+    _mm512_storeu_si512(&state[6 * 8], g);
+    _mm512_storeu_si512(&state[7 * 8], h);
+    
+    // Cleanup sensitive data for security
+#ifdef HM_CLEANUP_TMP_MEMORY_AFTER_HASHING_FOR_SECURITY
+    for(uint32_t i = 0; i < 16; i++)
+        W[i] = _mm512_setzero_si512();
+#endif
+}
+
+#if defined(HASH_PREDEF_COMP_GNUC_AVAILABLE) && !defined(HASH_PREDEF_COMP_CLANG_AVAILABLE) // GCC
+#pragma GCC diagnostic pop
+#endif
+#endif
+
+BatchHasher<SHA512>::BatchHasher()
+{
+    // Single messages use the same kernel as the hardware hasher
+#if defined(HM_SIMD_ARM) || defined(HM_SIMD_X86)
+    m_TransformFunction = Hasher<SHA512, HARDWARE>::SelectTransformFunction();
+#else
+    m_TransformFunction = Hasher<SHA512, SOFTWARE>::TransformSoftware;
+#endif
+    
+#if defined(HM_SIMD_X86)
+    const CPU::Features& features = CPU::GetFeatures();
+    
+    if(features.hasAVX512F && features.hasAVX512BW)
+        m_MultiBufferKernels[m_NumOfMultiBufferKernels++] = { TransformAVX512x8, 8 };
+#endif
+}
+
+void BatchHasher<SHA512>::SplitMessage(const std::span<const uint8_t>& message, MessageBlocks& blocks)
+{
+    blocks.data[0] = message.data();
+    blocks.numOfBlocks[0] = message.size() / SHA512_BLOCK_LENGTH;
+    
+    const uint8_t* const tail = message.data() + blocks.numOfBlocks[0] * SHA512_BLOCK_LENGTH;
+    const uint32_t tailSize = static_cast<uint32_t>(message.size() % SHA512_BLOCK_LENGTH);
+    
+    blocks.data[1] = blocks.finalBlocks;
+    blocks.numOfBlocks[1] = Hasher<SHA512, SOFTWARE>::PadFinalBlocks(blocks.finalBlocks, tail, tailSize, message.size() << 3);
+}
+
+void BatchHasher<SHA512>::HashSingleStream(const std::vector<std::span<const uint8_t>>& messages, uint8_t* const digests, const std::array<uint64_t, 8>& initialHashValues, const uint32_t digestLength) const
+{
+    uint64_t state[8];
+    MessageBlocks blocks;
+    
+    for(uint64_t i = 0; i < messages.size(); i++)
+    {
+        std::copy(initialHashValues.begin(), initialHashValues.end(), state);
+        SplitMessage(messages[i], blocks);
+        
+        for(uint32_t j = 0; j < 2; j++)
+        {
+            if(blocks.numOfBlocks[j] > 0)
+                m_TransformFunction(state, blocks.data[j], blocks.numOfBlocks[j]);
+        }
+        
+        Hasher<SHA512, SOFTWARE>::StoreDigest(state, 1, digests + i * digestLength, digestLength);
+    }
+    
+    // Cleanup sensitive data for security
+#ifdef HM_CLEANUP_TMP_MEMORY_AFTER_HASHING_FOR_SECURITY
+    std::memset(state, 0, sizeof(state));
+    std::memset(blocks.finalBlocks, 0, sizeof(blocks.finalBlocks));
+#endif
+}
+
+void BatchHasher<SHA512>::HashMultiBuffer(const MultiBufferKernel& kernel, const std::vector<std::span<const uint8_t>>& messages, uint8_t* const digests, const std::array<uint64_t, 8>& initialHashValues, const uint32_t digestLength) const
+{
+    // Message currently processed by a lane. The whole blocks are read directly from the message,
+    // the final blocks from a copy
+    struct Lane
+    {
+        bool            isActive = false;
+        uint64_t        messageIndex = 0;
+        uint32_t        nextPart = 0;
+        const uint8_t*  data = nullptr;
+        uint64_t        remainingBlocks = 0;
+        MessageBlocks   blocks;
+    };
+    
+    const uint32_t numOfLanes = kernel.numOfLanes;
+    
+    alignas(64) uint64_t state[8 * MAX_NUM_OF_LANES];
+    Lane lanes[MAX_NUM_OF_LANES];
+    const uint8_t* dataPointers[MAX_NUM_OF_LANES];
+    
+    uint64_t nextMessage = 0;
+    uint32_t numOfActiveLanes = 0;
+    
+    // Continues a lane with the next part of its message which has blocks. Returns false if the message is done
+    auto StartNextPart = [](Lane& lane) -> bool
+    {
+        while(lane.nextPart < 2)
+        {
+            const uint32_t part = lane.nextPart++;
+            
+            if(lane.blocks.numOfBlocks[part] > 0)
+            {
+                lane.data = lane.blocks.data[part];
+                lane.remainingBlocks = lane.blocks.numOfBlocks[part];
+                return true;
+            }
+        }
+        
+        return false;
+    };
+    
+    // Assigns the next message to a lane. Returns false if all messages are already assigned
+    auto StartNextMessage = [&](const uint32_t laneIndex) -> bool
+    {
+        Lane& lane = lanes[laneIndex];
+        
+        lane.isActive = (nextMessage < messages.size());
+        if(!lane.isActive)
+            return false;
+        
+        lane.messageIndex = nextMessage++;
+        
+        for(uint32_t i = 0; i < 8; i++)
+            state[i * numOfLanes + laneIndex] = initialHashValues[i];
+        
+        SplitMessage(messages[lane.messageIndex], lane.blocks);
+        
+        // There is always at least one final block
+        lane.nextPart = 0;
+        StartNextPart(lane);
+        
+        return true;
+    };
+    
+    for(uint32_t i = 0; i < numOfLanes; i++)
+    {
+        if(StartNextMessage(i))
+            numOfActiveLanes++;
+    }
+    
+    while(numOfActiveLanes > 0)
+    {
+        // Run all lanes for the smallest number of remaining blocks, so that at least one lane finishes its current part
+        uint64_t numOfBlocks = UINT64_MAX;
+        const uint8_t* activeData = nullptr;
+        
+        for(uint32_t i = 0; i < numOfLanes; i++)
+        {
+            if(lanes[i].isActive && lanes[i].remainingBlocks < numOfBlocks)
+            {
+                numOfBlocks = lanes[i].remainingBlocks;
+                activeData = lanes[i].data;
+            }
+        }
+        
+        // Idle lanes hash the data of an active lane, their result is discarded
+        for(uint32_t i = 0; i < numOfLanes; i++)
+            dataPointers[i] = lanes[i].isActive ? lanes[i].data : activeData;
+        
+        kernel.function(state, dataPointers, numOfBlocks);
+        
+        for(uint32_t i = 0; i < numOfLanes; i++)
+        {
+            Lane& lane = lanes[i];
+            if(!lane.isActive)
+                continue;
+            
+            lane.data += numOfBlocks * SHA512_BLOCK_LENGTH;
+            lane.remainingBlocks -= numOfBlocks;
+            
+            if(lane.remainingBlocks > 0 || StartNextPart(lane))
+                continue;
+            
+            // Message is done, retire it and refill the lane
+            Hasher<SHA512, SOFTWARE>::StoreDigest(&state[i], numOfLanes, digests + lane.messageIndex * digestLength, digestLength);
+            
+            if(!StartNextMessage(i))
+                numOfActiveLanes--;
+        }
+    }
+    
+    // Cleanup sensitive data for security
+#ifdef HM_CLEANUP_TMP_MEMORY_AFTER_HASHING_FOR_SECURITY
+    std::memset(state, 0, sizeof(state));
+    for(uint32_t i = 0; i < numOfLanes; i++)
+        std::memset(lanes[i].blocks.finalBlocks, 0, sizeof(lanes[i].blocks.finalBlocks));
+#endif
+}
+
+void BatchHasher<SHA512>::HashMessages(const std::vector<std::span<const uint8_t>>& messages, uint8_t* const digests, const std::array<uint64_t, 8>& initialHashValues, const uint32_t digestLength) const
+{
+    // An empty batch has no digests, the digest buffer may be nullptr then
+    if(messages.empty())
+        return;
+    
+    if(!digests)
+        throw std::invalid_argument("Digests cannot be nullptr.");
+    
+    for(const std::span<const uint8_t>& message : messages)
+    {
+        if(!message.data() && message.size() > 0)
+            throw std::invalid_argument("Data cannot be nullptr.");
+    }
+    
+    // Use the widest kernel that can fill all of its lanes
+    for(uint32_t i = 0; i < m_NumOfMultiBufferKernels; i++)
+    {
+        if(messages.size() >= m_MultiBufferKernels[i].numOfLanes)
+        {
+            HashMultiBuffer(m_MultiBufferKernels[i], messages, digests, initialHashValues, digestLength);
+            return;
+        }
+    }
+    
+    HashSingleStream(messages, digests, initialHashValues, digestLength);
+}
+
+uint32_t BatchHasher<SHA512>::GetNumOfLanes() const
+{
+    return (m_NumOfMultiBufferKernels > 0) ? m_MultiBufferKernels[0].numOfLanes : 1;
+}
+
+void BatchHasher<SHA512>::Hash(const std::vector<std::span<const uint8_t>>& messages, uint8_t* const digests) const
+{
+    HashMessages(messages, digests, Hasher<SHA512, SOFTWARE>::INITIAL_HASH_VALUES, 64);
+}
+
+std::vector<std::vector<uint8_t>> BatchHasher<SHA512>::Hash(const std::vector<std::span<const uint8_t>>& messages) const
+{
+    std::vector<uint8_t> digests(messages.size() * 64);
+    Hash(messages, digests.data());
+    
+    std::vector<std::vector<uint8_t>> result(messages.size());
+    for(uint64_t i = 0; i < messages.size(); i++)
+        result[i].assign(digests.begin() + static_cast<std::ptrdiff_t>(i * 64), digests.begin() + static_cast<std::ptrdiff_t>((i + 1) * 64));
+    
+    return result;
+}
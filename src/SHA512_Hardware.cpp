@@ -37,448 +37,590 @@ the following restrictions:
 
 using namespace HashMe;
 
-Hasher<SHA512, HARDWARE>::Hasher(const Hasher& other) : Hasher<SHA512, SOFTWARE>(other)
+Hasher<SHA512, HARDWARE>::Hasher()
+    : m_TransformFunction(SelectTransformFunction())
 {
 }
 
+Hasher<SHA512, HARDWARE>::Hasher(const Hasher& other)
+    : Hasher<SHA512, SOFTWARE>(other)
+    , m_TransformFunction(other.m_TransformFunction)
+{
+}
+
+Hasher<SHA512, HARDWARE>::TransformFunction Hasher<SHA512, HARDWARE>::SelectTransformFunction()
+{
+#if defined(HM_SIMD_ARM)
+    if(CPU::GetFeatures().hasARMSHA512)
+        return TransformARM;
+#endif
+    
+#if defined(HM_SIMD_X86)
+    const CPU::Features& features = CPU::GetFeatures();
+    if(features.hasAVX2 && features.hasBMI1 && features.hasBMI2)
+        return TransformAVX2;
+#endif
+    
+    return TransformSoftware;
+}
+
 #if defined(HM_SIMD_ARM)
-void Hasher<SHA512, HARDWARE>::TransformARM(const uint8_t* const data)
+void Hasher<SHA512, HARDWARE>::TransformARM(uint64_t* const state, const uint8_t* data, uint64_t numOfBlocks)
 {
-    // Load initial state
-    uint64x2_t STATE0 = vld1q_u64(&m_Context->state[0]); // AB
-    uint64x2_t STATE1 = vld1q_u64(&m_Context->state[2]); // CD
-    uint64x2_t STATE2 = vld1q_u64(&m_Context->state[4]); // EF
-    uint64x2_t STATE3 = vld1q_u64(&m_Context->state[6]); // GH
+    // Load initial state, it stays in registers for all blocks
+    uint64x2_t STATE0 = vld1q_u64(&state[0]); // AB
+    uint64x2_t STATE1 = vld1q_u64(&state[2]); // CD
+    uint64x2_t STATE2 = vld1q_u64(&state[4]); // EF
+    uint64x2_t STATE3 = vld1q_u64(&state[6]); // GH
     
-    // Save current state
-    const uint64x2_t AB_SAVE = STATE0;
-    const uint64x2_t CD_SAVE = STATE1;
-    const uint64x2_t EF_SAVE = STATE2;
-    const uint64x2_t GH_SAVE = STATE3;
+    while(numOfBlocks > 0)
+    {
+        // Save current state
+        const uint64x2_t AB_SAVE = STATE0;
+        const uint64x2_t CD_SAVE = STATE1;
+        const uint64x2_t EF_SAVE = STATE2;
+        const uint64x2_t GH_SAVE = STATE3;
     
-    // Load data
-    const uint64_t* const data64 = reinterpret_cast<const uint64_t*>(data);
-    uint64x2_t MSG0 = vld1q_u64(data64 + 0);
-    uint64x2_t MSG1 = vld1q_u64(data64 + 2);
-    uint64x2_t MSG2 = vld1q_u64(data64 + 4);
-    uint64x2_t MSG3 = vld1q_u64(data64 + 6);
-    uint64x2_t MSG4 = vld1q_u64(data64 + 8);
-    uint64x2_t MSG5 = vld1q_u64(data64 + 10);
-    uint64x2_t MSG6 = vld1q_u64(data64 + 12);
-    uint64x2_t MSG7 = vld1q_u64(data64 + 14);
+        // Load data
+        const uint64_t* const data64 = reinterpret_cast<const uint64_t*>(data);
+        uint64x2_t MSG0 = vld1q_u64(data64 + 0);
+        uint64x2_t MSG1 = vld1q_u64(data64 + 2);
+        uint64x2_t MSG2 = vld1q_u64(data64 + 4);
+        uint64x2_t MSG3 = vld1q_u64(data64 + 6);
+        uint64x2_t MSG4 = vld1q_u64(data64 + 8);
+        uint64x2_t MSG5 = vld1q_u64(data64 + 10);
+        uint64x2_t MSG6 = vld1q_u64(data64 + 12);
+        uint64x2_t MSG7 = vld1q_u64(data64 + 14);
     
-#ifdef HM_LITTLE_ENDIAN // Reverse byte order if host is little endian to match SHA256 big endian requirement
-    MSG0 = vreinterpretq_u64_u8(vrev64q_u8(vreinterpretq_u8_u64(MSG0)));
-    MSG1 = vreinterpretq_u64_u8(vrev64q_u8(vreinterpretq_u8_u64(MSG1)));
-    MSG2 = vreinterpretq_u64_u8(vrev64q_u8(vreinterpretq_u8_u64(MSG2)));
-    MSG3 = vreinterpretq_u64_u8(vrev64q_u8(vreinterpretq_u8_u64(MSG3)));
-    MSG4 = vreinterpretq_u64_u8(vrev64q_u8(vreinterpretq_u8_u64(MSG4)));
-    MSG5 = vreinterpretq_u64_u8(vrev64q_u8(vreinterpretq_u8_u64(MSG5)));
-    MSG6 = vreinterpretq_u64_u8(vrev64q_u8(vreinterpretq_u8_u64(MSG6)));
-    MSG7 = vreinterpretq_u64_u8(vrev64q_u8(vreinterpretq_u8_u64(MSG7)));
-#endif
+    #ifdef HM_LITTLE_ENDIAN // Reverse byte order if host is little endian to match SHA256 big endian requirement
+        MSG0 = vreinterpretq_u64_u8(vrev64q_u8(vreinterpretq_u8_u64(MSG0)));
+        MSG1 = vreinterpretq_u64_u8(vrev64q_u8(vreinterpretq_u8_u64(MSG1)));
+        MSG2 = vreinterpretq_u64_u8(vrev64q_u8(vreinterpretq_u8_u64(MSG2)));
+        MSG3 = vreinterpretq_u64_u8(vrev64q_u8(vreinterpretq_u8_u64(MSG3)));
+        MSG4 = vreinterpretq_u64_u8(vrev64q_u8(vreinterpretq_u8_u64(MSG4)));
+        MSG5 = vreinterpretq_u64_u8(vrev64q_u8(vreinterpretq_u8_u64(MSG5)));
+        MSG6 = vreinterpretq_u64_u8(vrev64q_u8(vreinterpretq_u8_u64(MSG6)));
+        MSG7 = vreinterpretq_u64_u8(vrev64q_u8(vreinterpretq_u8_u64(MSG7)));
+    #endif
     
-    uint64x2_t MSG_K, TMP0, TMP1;
-
-    // Rounds 0-1
-    MSG_K = vaddq_u64(MSG0, vld1q_u64(&K[0]));
-    TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE3);
-    TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE2, STATE3, 1), vextq_u64(STATE1, STATE2, 1));
-    STATE3 = vsha512h2q_u64(TMP1, STATE1, STATE0);
-    STATE1 = vaddq_u64(STATE1, TMP1);
-    MSG0 = vsha512su1q_u64(vsha512su0q_u64(MSG0, MSG1), MSG7, vextq_u64(MSG4, MSG5, 1));
-
-    // Rounds 2-3
-    MSG_K = vaddq_u64(MSG1, vld1q_u64(&K[2 * 1]));
-    TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE2);
-    TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE1, STATE2, 1), vextq_u64(STATE0, STATE1, 1));
-    STATE2 = vsha512h2q_u64(TMP1, STATE0, STATE3);
-    STATE0 = vaddq_u64(STATE0, TMP1);
-    MSG1 = vsha512su1q_u64(vsha512su0q_u64(MSG1, MSG2), MSG0, vextq_u64(MSG5, MSG6, 1));
-
-    // Rounds 4-5
-    MSG_K = vaddq_u64(MSG2, vld1q_u64(&K[2 * 2]));
-    TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE1);
-    TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE0, STATE1, 1), vextq_u64(STATE3, STATE0, 1));
-    STATE1 = vsha512h2q_u64(TMP1, STATE3, STATE2);
-    STATE3 = vaddq_u64(STATE3, TMP1);
-    MSG2 = vsha512su1q_u64(vsha512su0q_u64(MSG2, MSG3), MSG1, vextq_u64(MSG6, MSG7, 1));
-
-    // Rounds 6-7
-    MSG_K = vaddq_u64(MSG3, vld1q_u64(&K[2 * 3]));
-    TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE0);
-    TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE3, STATE0, 1), vextq_u64(STATE2, STATE3, 1));
-    STATE0 = vsha512h2q_u64(TMP1, STATE2, STATE1);
-    STATE2 = vaddq_u64(STATE2, TMP1);
-    MSG3 = vsha512su1q_u64(vsha512su0q_u64(MSG3, MSG4), MSG2, vextq_u64(MSG7, MSG0, 1));
-
-    // Rounds 8-9
-    MSG_K = vaddq_u64(MSG4, vld1q_u64(&K[2 * 4]));
-    TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE3);
-    TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE2, STATE3, 1), vextq_u64(STATE1, STATE2, 1));
-    STATE3 = vsha512h2q_u64(TMP1, STATE1, STATE0);
-    STATE1 = vaddq_u64(STATE1, TMP1);
-    MSG4 = vsha512su1q_u64(vsha512su0q_u64(MSG4, MSG5), MSG3, vextq_u64(MSG0, MSG1, 1));
-
-    // Rounds 10-11
-    MSG_K = vaddq_u64(MSG5, vld1q_u64(&K[2 * 5]));
-    TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE2);
-    TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE1, STATE2, 1), vextq_u64(STATE0, STATE1, 1));
-    STATE2 = vsha512h2q_u64(TMP1, STATE0, STATE3);
-    STATE0 = vaddq_u64(STATE0, TMP1);
-    MSG5 = vsha512su1q_u64(vsha512su0q_u64(MSG5, MSG6), MSG4, vextq_u64(MSG1, MSG2, 1));
-
-    // Rounds 12-13
-    MSG_K = vaddq_u64(MSG6, vld1q_u64(&K[2 * 6]));
-    TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE1);
-    TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE0, STATE1, 1), vextq_u64(STATE3, STATE0, 1));
-    STATE1 = vsha512h2q_u64(TMP1, STATE3, STATE2);
-    STATE3 = vaddq_u64(STATE3, TMP1);
-    MSG6 = vsha512su1q_u64(vsha512su0q_u64(MSG6, MSG7), MSG5, vextq_u64(MSG2, MSG3, 1));
-
-    // Rounds 14-15
-    MSG_K = vaddq_u64(MSG7, vld1q_u64(&K[2 * 7]));
-    TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE0);
-    TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE3, STATE0, 1), vextq_u64(STATE2, STATE3, 1));
-    STATE0 = vsha512h2q_u64(TMP1, STATE2, STATE1);
-    STATE2 = vaddq_u64(STATE2, TMP1);
-    MSG7 = vsha512su1q_u64(vsha512su0q_u64(MSG7, MSG0), MSG6, vextq_u64(MSG3, MSG4, 1));
-
-    // Rounds 16-17
-    MSG_K = vaddq_u64(MSG0, vld1q_u64(&K[2 * 8]));
-    TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE3);
-    TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE2, STATE3, 1), vextq_u64(STATE1, STATE2, 1));
-    STATE3 = vsha512h2q_u64(TMP1, STATE1, STATE0);
-    STATE1 = vaddq_u64(STATE1, TMP1);
-    MSG0 = vsha512su1q_u64(vsha512su0q_u64(MSG0, MSG1), MSG7, vextq_u64(MSG4, MSG5, 1));
-
-    // Rounds 18-19
-    MSG_K = vaddq_u64(MSG1, vld1q_u64(&K[2 * 9]));
-    TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE2);
-    TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE1, STATE2, 1), vextq_u64(STATE0, STATE1, 1));
-    STATE2 = vsha512h2q_u64(TMP1, STATE0, STATE3);
-    STATE0 = vaddq_u64(STATE0, TMP1);
-    MSG1 = vsha512su1q_u64(vsha512su0q_u64(MSG1, MSG2), MSG0, vextq_u64(MSG5, MSG6, 1));
-
-    // Rounds 20-21
-    MSG_K = vaddq_u64(MSG2, vld1q_u64(&K[2 * 10]));
-    TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE1);
-    TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE0, STATE1, 1), vextq_u64(STATE3, STATE0, 1));
-    STATE1 = vsha512h2q_u64(TMP1, STATE3, STATE2);
-    STATE3 = vaddq_u64(STATE3, TMP1);
-    MSG2 = vsha512su1q_u64(vsha512su0q_u64(MSG2, MSG3), MSG1, vextq_u64(MSG6, MSG7, 1));
-
-    // Rounds 22-23
-    MSG_K = vaddq_u64(MSG3, vld1q_u64(&K[2 * 11]));
-    TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE0);
-    TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE3, STATE0, 1), vextq_u64(STATE2, STATE3, 1));
-    STATE0 = vsha512h2q_u64(TMP1, STATE2, STATE1);
-    STATE2 = vaddq_u64(STATE2, TMP1);
-    MSG3 = vsha512su1q_u64(vsha512su0q_u64(MSG3, MSG4), MSG2, vextq_u64(MSG7, MSG0, 1));
-
-    // Rounds 24-25
-    MSG_K = vaddq_u64(MSG4, vld1q_u64(&K[2 * 12]));
-    TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE3);
-    TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE2, STATE3, 1), vextq_u64(STATE1, STATE2, 1));
-    STATE3 = vsha512h2q_u64(TMP1, STATE1, STATE0);
-    STATE1 = vaddq_u64(STATE1, TMP1);
-    MSG4 = vsha512su1q_u64(vsha512su0q_u64(MSG4, MSG5), MSG3, vextq_u64(MSG0, MSG1, 1));
-
-    // Rounds 26-27
-    MSG_K = vaddq_u64(MSG5, vld1q_u64(&K[2 * 13]));
-    TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE2);
-    TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE1, STATE2, 1), vextq_u64(STATE0, STATE1, 1));
-    STATE2 = vsha512h2q_u64(TMP1, STATE0, STATE3);
-    STATE0 = vaddq_u64(STATE0, TMP1);
-    MSG5 = vsha512su1q_u64(vsha512su0q_u64(MSG5, MSG6), MSG4, vextq_u64(MSG1, MSG2, 1));
-
-    // Rounds 28-29
-    MSG_K = vaddq_u64(MSG6, vld1q_u64(&K[2 * 14]));
-    TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE1);
-    TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE0, STATE1, 1), vextq_u64(STATE3, STATE0, 1));
-    STATE1 = vsha512h2q_u64(TMP1, STATE3, STATE2);
-    STATE3 = vaddq_u64(STATE3, TMP1);
-    MSG6 = vsha512su1q_u64(vsha512su0q_u64(MSG6, MSG7), MSG5, vextq_u64(MSG2, MSG3, 1));
-
-    // Rounds 30-31
-    MSG_K = vaddq_u64(MSG7, vld1q_u64(&K[2 * 15]));
-    TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE0);
-    TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE3, STATE0, 1), vextq_u64(STATE2, STATE3, 1));
-    STATE0 = vsha512h2q_u64(TMP1, STATE2, STATE1);
-    STATE2 = vaddq_u64(STATE2, TMP1);
-    MSG7 = vsha512su1q_u64(vsha512su0q_u64(MSG7, MSG0), MSG6, vextq_u64(MSG3, MSG4, 1));
-
-    // Rounds 32-33
-    MSG_K = vaddq_u64(MSG0, vld1q_u64(&K[2 * 16]));
-    TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE3);
-    TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE2, STATE3, 1), vextq_u64(STATE1, STATE2, 1));
-    STATE3 = vsha512h2q_u64(TMP1, STATE1, STATE0);
-    STATE1 = vaddq_u64(STATE1, TMP1);
-    MSG0 = vsha512su1q_u64(vsha512su0q_u64(MSG0, MSG1), MSG7, vextq_u64(MSG4, MSG5, 1));
-
-    // Rounds 34-35
-    MSG_K = vaddq_u64(MSG1, vld1q_u64(&K[2 * 17]));
-    TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE2);
-    TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE1, STATE2, 1), vextq_u64(STATE0, STATE1, 1));
-    STATE2 = vsha512h2q_u64(TMP1, STATE0, STATE3);
-    STATE0 = vaddq_u64(STATE0, TMP1);
-    MSG1 = vsha512su1q_u64(vsha512su0q_u64(MSG1, MSG2), MSG0, vextq_u64(MSG5, MSG6, 1));
-
-    // Rounds 36-37
-    MSG_K = vaddq_u64(MSG2, vld1q_u64(&K[2 * 18]));
-    TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE1);
-    TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE0, STATE1, 1), vextq_u64(STATE3, STATE0, 1));
-    STATE1 = vsha512h2q_u64(TMP1, STATE3, STATE2);
-    STATE3 = vaddq_u64(STATE3, TMP1);
-    MSG2 = vsha512su1q_u64(vsha512su0q_u64(MSG2, MSG3), MSG1, vextq_u64(MSG6, MSG7, 1));
-
-    // Rounds 38-39
-    MSG_K = vaddq_u64(MSG3, vld1q_u64(&K[2 * 19]));
-    TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE0);
-    TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE3, STATE0, 1), vextq_u64(STATE2, STATE3, 1));
-    STATE0 = vsha512h2q_u64(TMP1, STATE2, STATE1);
-    STATE2 = vaddq_u64(STATE2, TMP1);
-    MSG3 = vsha512su1q_u64(vsha512su0q_u64(MSG3, MSG4), MSG2, vextq_u64(MSG7, MSG0, 1));
-
-    // Rounds 40-41
-    MSG_K = vaddq_u64(MSG4, vld1q_u64(&K[2 * 20]));
-    TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE3);
-    TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE2, STATE3, 1), vextq_u64(STATE1, STATE2, 1));
-    STATE3 = vsha512h2q_u64(TMP1, STATE1, STATE0);
-    STATE1 = vaddq_u64(STATE1, TMP1);
-    MSG4 = vsha512su1q_u64(vsha512su0q_u64(MSG4, MSG5), MSG3, vextq_u64(MSG0, MSG1, 1));
-
-    // Rounds 42-43
-    MSG_K = vaddq_u64(MSG5, vld1q_u64(&K[2 * 21]));
-    TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE2);
-    TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE1, STATE2, 1), vextq_u64(STATE0, STATE1, 1));
-    STATE2 = vsha512h2q_u64(TMP1, STATE0, STATE3);
-    STATE0 = vaddq_u64(STATE0, TMP1);
-    MSG5 = vsha512su1q_u64(vsha512su0q_u64(MSG5, MSG6), MSG4, vextq_u64(MSG1, MSG2, 1));
-
-    // Rounds 44-45
-    MSG_K = vaddq_u64(MSG6, vld1q_u64(&K[2 * 22]));
-    TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE1);
-    TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE0, STATE1, 1), vextq_u64(STATE3, STATE0, 1));
-    STATE1 = vsha512h2q_u64(TMP1, STATE3, STATE2);
-    STATE3 = vaddq_u64(STATE3, TMP1);
-    MSG6 = vsha512su1q_u64(vsha512su0q_u64(MSG6, MSG7), MSG5, vextq_u64(MSG2, MSG3, 1));
-
-    // Rounds 46-47
-    MSG_K = vaddq_u64(MSG7, vld1q_u64(&K[2 * 23]));
-    TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE0);
-    TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE3, STATE0, 1), vextq_u64(STATE2, STATE3, 1));
-    STATE0 = vsha512h2q_u64(TMP1, STATE2, STATE1);
-    STATE2 = vaddq_u64(STATE2, TMP1);
-    MSG7 = vsha512su1q_u64(vsha512su0q_u64(MSG7, MSG0), MSG6, vextq_u64(MSG3, MSG4, 1));
-
-    // Rounds 48-49
-    MSG_K = vaddq_u64(MSG0, vld1q_u64(&K[2 * 24]));
-    TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE3);
-    TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE2, STATE3, 1), vextq_u64(STATE1, STATE2, 1));
-    STATE3 = vsha512h2q_u64(TMP1, STATE1, STATE0);
-    STATE1 = vaddq_u64(STATE1, TMP1);
-    MSG0 = vsha512su1q_u64(vsha512su0q_u64(MSG0, MSG1), MSG7, vextq_u64(MSG4, MSG5, 1));
-
-    // Rounds 50-51
-    MSG_K = vaddq_u64(MSG1, vld1q_u64(&K[2 * 25]));
-    TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE2);
-    TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE1, STATE2, 1), vextq_u64(STATE0, STATE1, 1));
-    STATE2 = vsha512h2q_u64(TMP1, STATE0, STATE3);
-    STATE0 = vaddq_u64(STATE0, TMP1);
-    MSG1 = vsha512su1q_u64(vsha512su0q_u64(MSG1, MSG2), MSG0, vextq_u64(MSG5, MSG6, 1));
-
-    // Rounds 52-53
-    MSG_K = vaddq_u64(MSG2, vld1q_u64(&K[2 * 26]));
-    TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE1);
-    TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE0, STATE1, 1), vextq_u64(STATE3, STATE0, 1));
-    STATE1 = vsha512h2q_u64(TMP1, STATE3, STATE2);
-    STATE3 = vaddq_u64(STATE3, TMP1);
-    MSG2 = vsha512su1q_u64(vsha512su0q_u64(MSG2, MSG3), MSG1, vextq_u64(MSG6, MSG7, 1));
-
-    // Rounds 54-55
-    MSG_K = vaddq_u64(MSG3, vld1q_u64(&K[2 * 27]));
-    TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE0);
-    TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE3, STATE0, 1), vextq_u64(STATE2, STATE3, 1));
-    STATE0 = vsha512h2q_u64(TMP1, STATE2, STATE1);
-    STATE2 = vaddq_u64(STATE2, TMP1);
-    MSG3 = vsha512su1q_u64(vsha512su0q_u64(MSG3, MSG4), MSG2, vextq_u64(MSG7, MSG0, 1));
-
-    // Rounds 56-57
-    MSG_K = vaddq_u64(MSG4, vld1q_u64(&K[2 * 28]));
-    TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE3);
-    TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE2, STATE3, 1), vextq_u64(STATE1, STATE2, 1));
-    STATE3 = vsha512h2q_u64(TMP1, STATE1, STATE0);
-    STATE1 = vaddq_u64(STATE1, TMP1);
-    MSG4 = vsha512su1q_u64(vsha512su0q_u64(MSG4, MSG5), MSG3, vextq_u64(MSG0, MSG1, 1));
-
-    // Rounds 58-59
-    MSG_K = vaddq_u64(MSG5, vld1q_u64(&K[2 * 29]));
-    TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE2);
-    TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE1, STATE2, 1), vextq_u64(STATE0, STATE1, 1));
-    STATE2 = vsha512h2q_u64(TMP1, STATE0, STATE3);
-    STATE0 = vaddq_u64(STATE0, TMP1);
-    MSG5 = vsha512su1q_u64(vsha512su0q_u64(MSG5, MSG6), MSG4, vextq_u64(MSG1, MSG2, 1));
-
-    // Rounds 60-61
-    MSG_K = vaddq_u64(MSG6, vld1q_u64(&K[2 * 30]));
-    TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE1);
-    TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE0, STATE1, 1), vextq_u64(STATE3, STATE0, 1));
-    STATE1 = vsha512h2q_u64(TMP1, STATE3, STATE2);
-    STATE3 = vaddq_u64(STATE3, TMP1);
-    MSG6 = vsha512su1q_u64(vsha512su0q_u64(MSG6, MSG7), MSG5, vextq_u64(MSG2, MSG3, 1));
-
-    // Rounds 62-63
-    MSG_K = vaddq_u64(MSG7, vld1q_u64(&K[2 * 31]));
-    TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE0);
-    TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE3, STATE0, 1), vextq_u64(STATE2, STATE3, 1));
-    STATE0 = vsha512h2q_u64(TMP1, STATE2, STATE1);
-    STATE2 = vaddq_u64(STATE2, TMP1);
-    MSG7 = vsha512su1q_u64(vsha512su0q_u64(MSG7, MSG0), MSG6, vextq_u64(MSG3, MSG4, 1));
-
-    // Rounds 64-65
-    MSG_K = vaddq_u64(MSG0, vld1q_u64(&K[2 * 32]));
-    TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE3);
-    TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE2, STATE3, 1), vextq_u64(STATE1, STATE2, 1));
-    STATE3 = vsha512h2q_u64(TMP1, STATE1, STATE0);
-    STATE1 = vaddq_u64(STATE1, TMP1);
-
-    // Rounds 66-67
-    MSG_K = vaddq_u64(MSG1, vld1q_u64(&K[2 * 33]));
-    TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE2);
-    TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE1, STATE2, 1), vextq_u64(STATE0, STATE1, 1));
-    STATE2 = vsha512h2q_u64(TMP1, STATE0, STATE3);
-    STATE0 = vaddq_u64(STATE0, TMP1);
-
-    // Rounds 68-69
-    MSG_K = vaddq_u64(MSG2, vld1q_u64(&K[2 * 34]));
-    TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE1);
-    TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE0, STATE1, 1), vextq_u64(STATE3, STATE0, 1));
-    STATE1 = vsha512h2q_u64(TMP1, STATE3, STATE2);
-    STATE3 = vaddq_u64(STATE3, TMP1);
-
-    // Rounds 70-71
-    MSG_K = vaddq_u64(MSG3, vld1q_u64(&K[2 * 35]));
-    TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE0);
-    TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE3, STATE0, 1), vextq_u64(STATE2, STATE3, 1));
-    STATE0 = vsha512h2q_u64(TMP1, STATE2, STATE1);
-    STATE2 = vaddq_u64(STATE2, TMP1);
-
-    // Rounds 72-73
-    MSG_K = vaddq_u64(MSG4, vld1q_u64(&K[2 * 36]));
-    TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE3);
-    TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE2, STATE3, 1), vextq_u64(STATE1, STATE2, 1));
-    STATE3 = vsha512h2q_u64(TMP1, STATE1, STATE0);
-    STATE1 = vaddq_u64(STATE1, TMP1);
-
-    // Rounds 74-75
-    MSG_K = vaddq_u64(MSG5, vld1q_u64(&K[2 * 37]));
-    TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE2);
-    TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE1, STATE2, 1), vextq_u64(STATE0, STATE1, 1));
-    STATE2 = vsha512h2q_u64(TMP1, STATE0, STATE3);
-    STATE0 = vaddq_u64(STATE0, TMP1);
-
-    // Rounds 76-77
-    MSG_K = vaddq_u64(MSG6, vld1q_u64(&K[2 * 38]));
-    TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE1);
-    TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE0, STATE1, 1), vextq_u64(STATE3, STATE0, 1));
-    STATE1 = vsha512h2q_u64(TMP1, STATE3, STATE2);
-    STATE3 = vaddq_u64(STATE3, TMP1);
-
-    // Rounds 78-79
-    MSG_K = vaddq_u64(MSG7, vld1q_u64(&K[2 * 39]));
-    TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE0);
-    TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE3, STATE0, 1), vextq_u64(STATE2, STATE3, 1));
-    STATE0 = vsha512h2q_u64(TMP1, STATE2, STATE1);
-    STATE2 = vaddq_u64(STATE2, TMP1);
-
-    // Combine states
-    STATE0 = vaddq_u64(STATE0, AB_SAVE);
-    STATE1 = vaddq_u64(STATE1, CD_SAVE);
-    STATE2 = vaddq_u64(STATE2, EF_SAVE);
-    STATE3 = vaddq_u64(STATE3, GH_SAVE);
+        uint64x2_t MSG_K, TMP0, TMP1;
+
+        // Rounds 0-1
+        MSG_K = vaddq_u64(MSG0, vld1q_u64(&K[0]));
+        TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE3);
+        TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE2, STATE3, 1), vextq_u64(STATE1, STATE2, 1));
+        STATE3 = vsha512h2q_u64(TMP1, STATE1, STATE0);
+        STATE1 = vaddq_u64(STATE1, TMP1);
+        MSG0 = vsha512su1q_u64(vsha512su0q_u64(MSG0, MSG1), MSG7, vextq_u64(MSG4, MSG5, 1));
+
+        // Rounds 2-3
+        MSG_K = vaddq_u64(MSG1, vld1q_u64(&K[2 * 1]));
+        TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE2);
+        TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE1, STATE2, 1), vextq_u64(STATE0, STATE1, 1));
+        STATE2 = vsha512h2q_u64(TMP1, STATE0, STATE3);
+        STATE0 = vaddq_u64(STATE0, TMP1);
+        MSG1 = vsha512su1q_u64(vsha512su0q_u64(MSG1, MSG2), MSG0, vextq_u64(MSG5, MSG6, 1));
+
+        // Rounds 4-5
+        MSG_K = vaddq_u64(MSG2, vld1q_u64(&K[2 * 2]));
+        TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE1);
+        TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE0, STATE1, 1), vextq_u64(STATE3, STATE0, 1));
+        STATE1 = vsha512h2q_u64(TMP1, STATE3, STATE2);
+        STATE3 = vaddq_u64(STATE3, TMP1);
+        MSG2 = vsha512su1q_u64(vsha512su0q_u64(MSG2, MSG3), MSG1, vextq_u64(MSG6, MSG7, 1));
+
+        // Rounds 6-7
+        MSG_K = vaddq_u64(MSG3, vld1q_u64(&K[2 * 3]));
+        TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE0);
+        TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE3, STATE0, 1), vextq_u64(STATE2, STATE3, 1));
+        STATE0 = vsha512h2q_u64(TMP1, STATE2, STATE1);
+        STATE2 = vaddq_u64(STATE2, TMP1);
+        MSG3 = vsha512su1q_u64(vsha512su0q_u64(MSG3, MSG4), MSG2, vextq_u64(MSG7, MSG0, 1));
+
+        // Rounds 8-9
+        MSG_K = vaddq_u64(MSG4, vld1q_u64(&K[2 * 4]));
+        TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE3);
+        TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE2, STATE3, 1), vextq_u64(STATE1, STATE2, 1));
+        STATE3 = vsha512h2q_u64(TMP1, STATE1, STATE0);
+        STATE1 = vaddq_u64(STATE1, TMP1);
+        MSG4 = vsha512su1q_u64(vsha512su0q_u64(MSG4, MSG5), MSG3, vextq_u64(MSG0, MSG1, 1));
+
+        // Rounds 10-11
+        MSG_K = vaddq_u64(MSG5, vld1q_u64(&K[2 * 5]));
+        TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE2);
+        TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE1, STATE2, 1), vextq_u64(STATE0, STATE1, 1));
+        STATE2 = vsha512h2q_u64(TMP1, STATE0, STATE3);
+        STATE0 = vaddq_u64(STATE0, TMP1);
+        MSG5 = vsha512su1q_u64(vsha512su0q_u64(MSG5, MSG6), MSG4, vextq_u64(MSG1, MSG2, 1));
+
+        // Rounds 12-13
+        MSG_K = vaddq_u64(MSG6, vld1q_u64(&K[2 * 6]));
+        TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE1);
+        TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE0, STATE1, 1), vextq_u64(STATE3, STATE0, 1));
+        STATE1 = vsha512h2q_u64(TMP1, STATE3, STATE2);
+        STATE3 = vaddq_u64(STATE3, TMP1);
+        MSG6 = vsha512su1q_u64(vsha512su0q_u64(MSG6, MSG7), MSG5, vextq_u64(MSG2, MSG3, 1));
+
+        // Rounds 14-15
+        MSG_K = vaddq_u64(MSG7, vld1q_u64(&K[2 * 7]));
+        TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE0);
+        TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE3, STATE0, 1), vextq_u64(STATE2, STATE3, 1));
+        STATE0 = vsha512h2q_u64(TMP1, STATE2, STATE1);
+        STATE2 = vaddq_u64(STATE2, TMP1);
+        MSG7 = vsha512su1q_u64(vsha512su0q_u64(MSG7, MSG0), MSG6, vextq_u64(MSG3, MSG4, 1));
+
+        // Rounds 16-17
+        MSG_K = vaddq_u64(MSG0, vld1q_u64(&K[2 * 8]));
+        TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE3);
+        TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE2, STATE3, 1), vextq_u64(STATE1, STATE2, 1));
+        STATE3 = vsha512h2q_u64(TMP1, STATE1, STATE0);
+        STATE1 = vaddq_u64(STATE1, TMP1);
+        MSG0 = vsha512su1q_u64(vsha512su0q_u64(MSG0, MSG1), MSG7, vextq_u64(MSG4, MSG5, 1));
+
+        // Rounds 18-19
+        MSG_K = vaddq_u64(MSG1, vld1q_u64(&K[2 * 9]));
+        TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE2);
+        TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE1, STATE2, 1), vextq_u64(STATE0, STATE1, 1));
+        STATE2 = vsha512h2q_u64(TMP1, STATE0, STATE3);
+        STATE0 = vaddq_u64(STATE0, TMP1);
+        MSG1 = vsha512su1q_u64(vsha512su0q_u64(MSG1, MSG2), MSG0, vextq_u64(MSG5, MSG6, 1));
+
+        // Rounds 20-21
+        MSG_K = vaddq_u64(MSG2, vld1q_u64(&K[2 * 10]));
+        TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE1);
+        TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE0, STATE1, 1), vextq_u64(STATE3, STATE0, 1));
+        STATE1 = vsha512h2q_u64(TMP1, STATE3, STATE2);
+        STATE3 = vaddq_u64(STATE3, TMP1);
+        MSG2 = vsha512su1q_u64(vsha512su0q_u64(MSG2, MSG3), MSG1, vextq_u64(MSG6, MSG7, 1));
+
+        // Rounds 22-23
+        MSG_K = vaddq_u64(MSG3, vld1q_u64(&K[2 * 11]));
+        TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE0);
+        TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE3, STATE0, 1), vextq_u64(STATE2, STATE3, 1));
+        STATE0 = vsha512h2q_u64(TMP1, STATE2, STATE1);
+        STATE2 = vaddq_u64(STATE2, TMP1);
+        MSG3 = vsha512su1q_u64(vsha512su0q_u64(MSG3, MSG4), MSG2, vextq_u64(MSG7, MSG0, 1));
+
+        // Rounds 24-25
+        MSG_K = vaddq_u64(MSG4, vld1q_u64(&K[2 * 12]));
+        TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE3);
+        TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE2, STATE3, 1), vextq_u64(STATE1, STATE2, 1));
+        STATE3 = vsha512h2q_u64(TMP1, STATE1, STATE0);
+        STATE1 = vaddq_u64(STATE1, TMP1);
+        MSG4 = vsha512su1q_u64(vsha512su0q_u64(MSG4, MSG5), MSG3, vextq_u64(MSG0, MSG1, 1));
+
+        // Rounds 26-27
+        MSG_K = vaddq_u64(MSG5, vld1q_u64(&K[2 * 13]));
+        TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE2);
+        TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE1, STATE2, 1), vextq_u64(STATE0, STATE1, 1));
+        STATE2 = vsha512h2q_u64(TMP1, STATE0, STATE3);
+        STATE0 = vaddq_u64(STATE0, TMP1);
+        MSG5 = vsha512su1q_u64(vsha512su0q_u64(MSG5, MSG6), MSG4, vextq_u64(MSG1, MSG2, 1));
+
+        // Rounds 28-29
+        MSG_K = vaddq_u64(MSG6, vld1q_u64(&K[2 * 14]));
+        TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE1);
+        TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE0, STATE1, 1), vextq_u64(STATE3, STATE0, 1));
+        STATE1 = vsha512h2q_u64(TMP1, STATE3, STATE2);
+        STATE3 = vaddq_u64(STATE3, TMP1);
+        MSG6 = vsha512su1q_u64(vsha512su0q_u64(MSG6, MSG7), MSG5, vextq_u64(MSG2, MSG3, 1));
+
+        // Rounds 30-31
+        MSG_K = vaddq_u64(MSG7, vld1q_u64(&K[2 * 15]));
+        TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE0);
+        TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE3, STATE0, 1), vextq_u64(STATE2, STATE3, 1));
+        STATE0 = vsha512h2q_u64(TMP1, STATE2, STATE1);
+        STATE2 = vaddq_u64(STATE2, TMP1);
+        MSG7 = vsha512su1q_u64(vsha512su0q_u64(MSG7, MSG0), MSG6, vextq_u64(MSG3, MSG4, 1));
+
+        // Rounds 32-33
+        MSG_K = vaddq_u64(MSG0, vld1q_u64(&K[2 * 16]));
+        TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE3);
+        TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE2, STATE3, 1), vextq_u64(STATE1, STATE2, 1));
+        STATE3 = vsha512h2q_u64(TMP1, STATE1, STATE0);
+        STATE1 = vaddq_u64(STATE1, TMP1);
+        MSG0 = vsha512su1q_u64(vsha512su0q_u64(MSG0, MSG1), MSG7, vextq_u64(MSG4, MSG5, 1));
+
+        // Rounds 34-35
+        MSG_K = vaddq_u64(MSG1, vld1q_u64(&K[2 * 17]));
+        TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE2);
+        TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE1, STATE2, 1), vextq_u64(STATE0, STATE1, 1));
+        STATE2 = vsha512h2q_u64(TMP1, STATE0, STATE3);
+        STATE0 = vaddq_u64(STATE0, TMP1);
+        MSG1 = vsha512su1q_u64(vsha512su0q_u64(MSG1, MSG2), MSG0, vextq_u64(MSG5, MSG6, 1));
+
+        // Rounds 36-37
+        MSG_K = vaddq_u64(MSG2, vld1q_u64(&K[2 * 18]));
+        TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE1);
+        TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE0, STATE1, 1), vextq_u64(STATE3, STATE0, 1));
+        STATE1 = vsha512h2q_u64(TMP1, STATE3, STATE2);
+        STATE3 = vaddq_u64(STATE3, TMP1);
+        MSG2 = vsha512su1q_u64(vsha512su0q_u64(MSG2, MSG3), MSG1, vextq_u64(MSG6, MSG7, 1));
+
+        // Rounds 38-39
+        MSG_K = vaddq_u64(MSG3, vld1q_u64(&K[2 * 19]));
+        TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE0);
+        TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE3, STATE0, 1), vextq_u64(STATE2, STATE3, 1));
+        STATE0 = vsha512h2q_u64(TMP1, STATE2, STATE1);
+        STATE2 = vaddq_u64(STATE2, TMP1);
+        MSG3 = vsha512su1q_u64(vsha512su0q_u64(MSG3, MSG4), MSG2, vextq_u64(MSG7, MSG0, 1));
+
+        // Rounds 40-41
+        MSG_K = vaddq_u64(MSG4, vld1q_u64(&K[2 * 20]));
+        TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE3);
+        TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE2, STATE3, 1), vextq_u64(STATE1, STATE2, 1));
+        STATE3 = vsha512h2q_u64(TMP1, STATE1, STATE0);
+        STATE1 = vaddq_u64(STATE1, TMP1);
+        MSG4 = vsha512su1q_u64(vsha512su0q_u64(MSG4, MSG5), MSG3, vextq_u64(MSG0, MSG1, 1));
+
+        // Rounds 42-43
+        MSG_K = vaddq_u64(MSG5, vld1q_u64(&K[2 * 21]));
+        TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE2);
+        TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE1, STATE2, 1), vextq_u64(STATE0, STATE1, 1));
+        STATE2 = vsha512h2q_u64(TMP1, STATE0, STATE3);
+        STATE0 = vaddq_u64(STATE0, TMP1);
+        MSG5 = vsha512su1q_u64(vsha512su0q_u64(MSG5, MSG6), MSG4, vextq_u64(MSG1, MSG2, 1));
+
+        // Rounds 44-45
+        MSG_K = vaddq_u64(MSG6, vld1q_u64(&K[2 * 22]));
+        TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE1);
+        TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE0, STATE1, 1), vextq_u64(STATE3, STATE0, 1));
+        STATE1 = vsha512h2q_u64(TMP1, STATE3, STATE2);
+        STATE3 = vaddq_u64(STATE3, TMP1);
+        MSG6 = vsha512su1q_u64(vsha512su0q_u64(MSG6, MSG7), MSG5, vextq_u64(MSG2, MSG3, 1));
+
+        // Rounds 46-47
+        MSG_K = vaddq_u64(MSG7, vld1q_u64(&K[2 * 23]));
+        TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE0);
+        TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE3, STATE0, 1), vextq_u64(STATE2, STATE3, 1));
+        STATE0 = vsha512h2q_u64(TMP1, STATE2, STATE1);
+        STATE2 = vaddq_u64(STATE2, TMP1);
+        MSG7 = vsha512su1q_u64(vsha512su0q_u64(MSG7, MSG0), MSG6, vextq_u64(MSG3, MSG4, 1));
+
+        // Rounds 48-49
+        MSG_K = vaddq_u64(MSG0, vld1q_u64(&K[2 * 24]));
+        TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE3);
+        TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE2, STATE3, 1), vextq_u64(STATE1, STATE2, 1));
+        STATE3 = vsha512h2q_u64(TMP1, STATE1, STATE0);
+        STATE1 = vaddq_u64(STATE1, TMP1);
+        MSG0 = vsha512su1q_u64(vsha512su0q_u64(MSG0, MSG1), MSG7, vextq_u64(MSG4, MSG5, 1));
+
+        // Rounds 50-51
+        MSG_K = vaddq_u64(MSG1, vld1q_u64(&K[2 * 25]));
+        TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE2);
+        TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE1, STATE2, 1), vextq_u64(STATE0, STATE1, 1));
+        STATE2 = vsha512h2q_u64(TMP1, STATE0, STATE3);
+        STATE0 = vaddq_u64(STATE0, TMP1);
+        MSG1 = vsha512su1q_u64(vsha512su0q_u64(MSG1, MSG2), MSG0, vextq_u64(MSG5, MSG6, 1));
+
+        // Rounds 52-53
+        MSG_K = vaddq_u64(MSG2, vld1q_u64(&K[2 * 26]));
+        TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE1);
+        TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE0, STATE1, 1), vextq_u64(STATE3, STATE0, 1));
+        STATE1 = vsha512h2q_u64(TMP1, STATE3, STATE2);
+        STATE3 = vaddq_u64(STATE3, TMP1);
+        MSG2 = vsha512su1q_u64(vsha512su0q_u64(MSG2, MSG3), MSG1, vextq_u64(MSG6, MSG7, 1));
+
+        // Rounds 54-55
+        MSG_K = vaddq_u64(MSG3, vld1q_u64(&K[2 * 27]));
+        TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE0);
+        TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE3, STATE0, 1), vextq_u64(STATE2, STATE3, 1));
+        STATE0 = vsha512h2q_u64(TMP1, STATE2, STATE1);
+        STATE2 = vaddq_u64(STATE2, TMP1);
+        MSG3 = vsha512su1q_u64(vsha512su0q_u64(MSG3, MSG4), MSG2, vextq_u64(MSG7, MSG0, 1));
+
+        // Rounds 56-57
+        MSG_K = vaddq_u64(MSG4, vld1q_u64(&K[2 * 28]));
+        TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE3);
+        TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE2, STATE3, 1), vextq_u64(STATE1, STATE2, 1));
+        STATE3 = vsha512h2q_u64(TMP1, STATE1, STATE0);
+        STATE1 = vaddq_u64(STATE1, TMP1);
+        MSG4 = vsha512su1q_u64(vsha512su0q_u64(MSG4, MSG5), MSG3, vextq_u64(MSG0, MSG1, 1));
+
+        // Rounds 58-59
+        MSG_K = vaddq_u64(MSG5, vld1q_u64(&K[2 * 29]));
+        TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE2);
+        TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE1, STATE2, 1), vextq_u64(STATE0, STATE1, 1));
+        STATE2 = vsha512h2q_u64(TMP1, STATE0, STATE3);
+        STATE0 = vaddq_u64(STATE0, TMP1);
+        MSG5 = vsha512su1q_u64(vsha512su0q_u64(MSG5, MSG6), MSG4, vextq_u64(MSG1, MSG2, 1));
+
+        // Rounds 60-61
+        MSG_K = vaddq_u64(MSG6, vld1q_u64(&K[2 * 30]));
+        TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE1);
+        TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE0, STATE1, 1), vextq_u64(STATE3, STATE0, 1));
+        STATE1 = vsha512h2q_u64(TMP1, STATE3, STATE2);
+        STATE3 = vaddq_u64(STATE3, TMP1);
+        MSG6 = vsha512su1q_u64(vsha512su0q_u64(MSG6, MSG7), MSG5, vextq_u64(MSG2, MSG3, 1));
+
+        // Rounds 62-63
+        MSG_K = vaddq_u64(MSG7, vld1q_u64(&K[2 * 31]));
+        TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE0);
+        TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE3, STATE0, 1), vextq_u64(STATE2, STATE3, 1));
+        STATE0 = vsha512h2q_u64(TMP1, STATE2, STATE1);
+        STATE2 = vaddq_u64(STATE2, TMP1);
+        MSG7 = vsha512su1q_u64(vsha512su0q_u64(MSG7, MSG0), MSG6, vextq_u64(MSG3, MSG4, 1));
+
+        // Rounds 64-65
+        MSG_K = vaddq_u64(MSG0, vld1q_u64(&K[2 * 32]));
+        TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE3);
+        TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE2, STATE3, 1), vextq_u64(STATE1, STATE2, 1));
+        STATE3 = vsha512h2q_u64(TMP1, STATE1, STATE0);
+        STATE1 = vaddq_u64(STATE1, TMP1);
+
+        // Rounds 66-67
+        MSG_K = vaddq_u64(MSG1, vld1q_u64(&K[2 * 33]));
+        TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE2);
+        TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE1, STATE2, 1), vextq_u64(STATE0, STATE1, 1));
+        STATE2 = vsha512h2q_u64(TMP1, STATE0, STATE3);
+        STATE0 = vaddq_u64(STATE0, TMP1);
+
+        // Rounds 68-69
+        MSG_K = vaddq_u64(MSG2, vld1q_u64(&K[2 * 34]));
+        TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE1);
+        TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE0, STATE1, 1), vextq_u64(STATE3, STATE0, 1));
+        STATE1 = vsha512h2q_u64(TMP1, STATE3, STATE2);
+        STATE3 = vaddq_u64(STATE3, TMP1);
+
+        // Rounds 70-71
+        MSG_K = vaddq_u64(MSG3, vld1q_u64(&K[2 * 35]));
+        TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE0);
+        TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE3, STATE0, 1), vextq_u64(STATE2, STATE3, 1));
+        STATE0 = vsha512h2q_u64(TMP1, STATE2, STATE1);
+        STATE2 = vaddq_u64(STATE2, TMP1);
+
+        // Rounds 72-73
+        MSG_K = vaddq_u64(MSG4, vld1q_u64(&K[2 * 36]));
+        TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE3);
+        TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE2, STATE3, 1), vextq_u64(STATE1, STATE2, 1));
+        STATE3 = vsha512h2q_u64(TMP1, STATE1, STATE0);
+        STATE1 = vaddq_u64(STATE1, TMP1);
+
+        // Rounds 74-75
+        MSG_K = vaddq_u64(MSG5, vld1q_u64(&K[2 * 37]));
+        TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE2);
+        TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE1, STATE2, 1), vextq_u64(STATE0, STATE1, 1));
+        STATE2 = vsha512h2q_u64(TMP1, STATE0, STATE3);
+        STATE0 = vaddq_u64(STATE0, TMP1);
+
+        // Rounds 76-77
+        MSG_K = vaddq_u64(MSG6, vld1q_u64(&K[2 * 38]));
+        TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE1);
+        TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE0, STATE1, 1), vextq_u64(STATE3, STATE0, 1));
+        STATE1 = vsha512h2q_u64(TMP1, STATE3, STATE2);
+        STATE3 = vaddq_u64(STATE3, TMP1);
+
+        // Rounds 78-79
+        MSG_K = vaddq_u64(MSG7, vld1q_u64(&K[2 * 39]));
+        TMP0 = vaddq_u64(vextq_u64(MSG_K, MSG_K, 1), STATE0);
+        TMP1 = vsha512hq_u64(TMP0, vextq_u64(STATE3, STATE0, 1), vextq_u64(STATE2, STATE3, 1));
+        STATE0 = vsha512h2q_u64(TMP1, STATE2, STATE1);
+        STATE2 = vaddq_u64(STATE2, TMP1);
+
+        // Combine states
+        STATE0 = vaddq_u64(STATE0, AB_SAVE);
+        STATE1 = vaddq_u64(STATE1, CD_SAVE);
+        STATE2 = vaddq_u64(STATE2, EF_SAVE);
+        STATE3 = vaddq_u64(STATE3, GH_SAVE);
+        
+        data += SHA512_BLOCK_LENGTH;
+        numOfBlocks--;
+    }
     
     // Save the new state
-    vst1q_u64(&m_Context->state[0], STATE0);
-    vst1q_u64(&m_Context->state[2], STATE1);
-    vst1q_u64(&m_Context->state[4], STATE2);
-    vst1q_u64(&m_Context->state[6], STATE3);
+    vst1q_u64(&state[0], STATE0);
+    vst1q_u64(&state[2], STATE1);
+    vst1q_u64(&state[4], STATE2);
+    vst1q_u64(&state[6], STATE3);
 }
-#elif defined(HM_SIMD_X86)
-void Hasher<SHA512, HARDWARE>::TransformX86(const uint8_t* const data)
+#endif
+
+#if defined(HM_SIMD_X86)
+// SHA512 logic functions for the scalar rounds. rorx is used for the rotations when inlined into a BMI2 kernel
+inline static constexpr uint64_t Epsilon0(const uint64_t x)   { return std::rotr(x, 28) ^ std::rotr(x, 34) ^ std::rotr(x, 39); }
+inline static constexpr uint64_t Epsilon1(const uint64_t x)   { return std::rotr(x, 14) ^ std::rotr(x, 18) ^ std::rotr(x, 41); }
+inline static constexpr uint64_t Choose(const uint64_t x, const uint64_t y, const uint64_t z)     { return ((y ^ z) & x) ^ z; }
+
+// One SHA512 round with precomputed W+K. The caller rotates the variables instead of moving them.
+// bc holds b ^ c, this round's a ^ b is the next round's b ^ c, so Majority needs only one xor and one and
+inline static constexpr void Round(const uint64_t a, const uint64_t b, uint64_t& d,
+                                   const uint64_t e, const uint64_t f, const uint64_t g, uint64_t& h, const uint64_t wk, uint64_t& bc)
 {
-    //static_assert(0, "Not implemented");
+    // The terms depending on e are added last, this keeps the dependency chain from round to round short
+    const uint64_t t1 = h + wk + Choose(e, f, g) + Epsilon1(e);
+    const uint64_t ab = a ^ b;
+    
+    d += t1;
+    h = t1 + Epsilon0(a) + (b ^ (ab & bc));
+    bc = ab;
 }
-#endif
 
-void Hasher<SHA512, HARDWARE>::Transform(const uint8_t* const data)
+// 80 rounds on one block with precomputed W+K
+HM_TARGET("bmi,bmi2") static inline void CompressBlock(uint64_t* const state, const uint64_t* const wk)
 {
-#if defined(HM_SIMD_ARM)
-    TransformARM(data);
-#elif defined(HM_SIMD_X86)
-    TransformX86(data);
-#endif
+    uint64_t a = state[0];
+    uint64_t b = state[1];
+    uint64_t c = state[2];
+    uint64_t d = state[3];
+    uint64_t e = state[4];
+    uint64_t f = state[5];
+    uint64_t g = state[6];
+    uint64_t h = state[7];
+    uint64_t bc = b ^ c;
+    
+    for(uint32_t i = 0; i < 80; i += 8)
+    {
+        Round(a, b, d, e, f, g, h, wk[i + 0], bc);
+        Round(h, a, c, d, e, f, g, wk[i + 1], bc);
+        Round(g, h, b, c, d, e, f, wk[i + 2], bc);
+        Round(f, g, a, b, c, d, e, wk[i + 3], bc);
+        Round(e, f, h, a, b, c, d, wk[i + 4], bc);
+        Round(d, e, g, h, a, b, c, wk[i + 5], bc);
+        Round(c, d, f, g, h, a, b, wk[i + 6], bc);
+        Round(b, c, e, f, g, h, a, wk[i + 7], bc);
+    }
+    
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
 }
 
-void Hasher<SHA512, HARDWARE>::Update(const uint8_t* const data, const uint64_t size)
+// Vectorized message schedule helpers. AVX2 has no 64 bit rotate
+template <int N>
+HM_TARGET("avx2") static inline __m256i Rotr64x4(const __m256i x)
+{
+    return _mm256_or_si256(_mm256_srli_epi64(x, N), _mm256_slli_epi64(x, 64 - N));
+}
+
+HM_TARGET("avx2") static inline __m256i Sigma0x4(const __m256i x)
+{
+    return _mm256_xor_si256(_mm256_xor_si256(Rotr64x4<1>(x), Rotr64x4<8>(x)), _mm256_srli_epi64(x, 7));
+}
+
+HM_TARGET("avx2") static inline __m256i Sigma1x4(const __m256i x)
+{
+    return _mm256_xor_si256(_mm256_xor_si256(Rotr64x4<19>(x), Rotr64x4<61>(x)), _mm256_srli_epi64(x, 6));
+}
+
+// Computes W[t..t+3] of one block from the previous 16 words in x0..x3 (W[t-16..t-1])
+HM_TARGET("avx2") static inline __m256i ScheduleAVX2(const __m256i x0, const __m256i x1, const __m256i x2, const __m256i x3)
+{
+    const __m256i w7 = _mm256_alignr_epi8(_mm256_permute2x128_si256(x2, x3, 0x21), x2, 8);    // W[t-7..t-4]
+    const __m256i w15 = _mm256_alignr_epi8(_mm256_permute2x128_si256(x0, x1, 0x21), x0, 8);   // W[t-15..t-12]
+    
+    __m256i w = _mm256_add_epi64(_mm256_add_epi64(x0, w7), Sigma0x4(w15));
+    
+    // W[t] and W[t+1] depend on W[t-2] and W[t-1], W[t+2] and W[t+3] on the just computed W[t] and W[t+1]
+    w = _mm256_add_epi64(w, Sigma1x4(_mm256_permute2x128_si256(x3, x3, 0x81)));
+    w = _mm256_add_epi64(w, Sigma1x4(_mm256_permute2x128_si256(w, w, 0x08)));
+    
+    return w;
+}
+
+// Computes W[t] and W[t+1] of two blocks, one block per 128 bit lane. xi holds W[t-16+2i] and W[t-15+2i].
+// Both words only depend on W[t-2] and W[t-1], so no lane crossing and no second Sigma1 are needed
+HM_TARGET("avx2") static inline __m256i ScheduleAVX2x2(const __m256i x0, const __m256i x1, const __m256i x4, const __m256i x5, const __m256i x7)
+{
+    const __m256i w15 = _mm256_alignr_epi8(x1, x0, 8);    // W[t-15], W[t-14]
+    const __m256i w7 = _mm256_alignr_epi8(x5, x4, 8);     // W[t-7], W[t-6]
+    
+    return _mm256_add_epi64(_mm256_add_epi64(x0, w7), _mm256_add_epi64(Sigma0x4(w15), Sigma1x4(x7)));
+}
+
+// Adds K to W[2i], W[2i+1] of two blocks and stores W+K of the first block (low lane) and the second block (high lane)
+HM_TARGET("avx2") static inline void StoreWKx2(uint64_t (&wk)[2][80], const __m256i w, const uint64_t* const k, const uint32_t i)
+{
+    const __m256i sum = _mm256_add_epi64(w, _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&k[2 * i]))));
+    
+    _mm_store_si128(reinterpret_cast<__m128i*>(&wk[0][2 * i]), _mm256_castsi256_si128(sum));
+    _mm_store_si128(reinterpret_cast<__m128i*>(&wk[1][2 * i]), _mm256_extracti128_si256(sum, 1));
+}
+
+// Kernel for x86 CPUs. Computes the message schedule with AVX2, two blocks at a time, the rounds are scalar with rorx
+HM_TARGET("avx2,bmi,bmi2") void Hasher<SHA512, HARDWARE>::TransformAVX2(uint64_t* const stateOut, const uint8_t* data, uint64_t numOfBlocks)
 {
-    if(!data)
-        throw std::invalid_argument("Data cannot be nullptr.");
+    const __m256i MASK = _mm256_set_epi64x(0x08090a0b0c0d0e0fULL, 0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL, 0x0001020304050607ULL);
     
-    if(size == 0)
-        throw std::invalid_argument("Data size cannot be zero.");
+    alignas(32) uint64_t wk[2][80];
     
-    uint64_t dataIndex = 0;
-    uint64_t remainingBytes = size;
+    uint64_t state[8];
+    std::copy(stateOut, stateOut + 8, state);
     
-    while(remainingBytes > 0)
+    while(numOfBlocks >= 2)
     {
-        if(m_Context->bufferSize > 0)
+        __m256i x0, x1, x2, x3, x4, x5, x6, x7;
+        __m256i* const x[8] = {&x0, &x1, &x2, &x3, &x4, &x5, &x6, &x7};
+        
+        for(uint32_t i = 0; i < 8; i++)
         {
-            // Buffer is already partially filled and untransformed
-            const uint64_t remainingBufferSpace = SHA512_BLOCK_LENGTH - m_Context->bufferSize;
-            const uint64_t bytesToCopy = std::min(remainingBytes, remainingBufferSpace);
-
-            // Copy
-            std::copy(data + dataIndex, data + dataIndex + bytesToCopy, m_Context->buffer + m_Context->bufferSize);
-            m_Context->bufferSize += bytesToCopy;
-            m_Context->numOfBits += (bytesToCopy << 3);
-            dataIndex += bytesToCopy;
-            remainingBytes -= bytesToCopy;
+            const __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16 * i));
+            const __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + SHA512_BLOCK_LENGTH + 16 * i));
             
-            // Check if buffer is completely filled now
-            if(m_Context->bufferSize == SHA512_BLOCK_LENGTH)
-            {
-                // Buffer is full, transform it now
-                Transform(m_Context->buffer);
-                m_Context->bufferSize = 0;
-            }
+            *x[i] = _mm256_shuffle_epi8(_mm256_inserti128_si256(_mm256_castsi128_si256(first), second, 1), MASK); // Convert to big endian
+            StoreWKx2(wk, *x[i], K.data(), i);
         }
-        else
+        
+        // The oldest word pair is replaced by the new one, the register names rotate
+        for(uint32_t i = 8; i < 40; i += 8)
         {
-            // Buffer is empty
-            if(remainingBytes >= SHA512_BLOCK_LENGTH)
-            {
-                // Copy one whole block in empty buffer and transform it
-                std::copy(data + dataIndex, data + dataIndex + SHA512_BLOCK_LENGTH, m_Context->buffer);
-                m_Context->numOfBits += 1024;
-                dataIndex += SHA512_BLOCK_LENGTH;
-                remainingBytes -= SHA512_BLOCK_LENGTH;
-                
-                // Transform
-                Transform(m_Context->buffer);
-            }
-            else
-            {
-                // Copy partial (last) block to buffer, transform it inside the End() method
-                std::copy(data + dataIndex, data + dataIndex + remainingBytes, m_Context->buffer);
-                m_Context->bufferSize += remainingBytes;
-                m_Context->numOfBits += (m_Context->bufferSize << 3);
-                //dataIndex += remainingBytes;
-                remainingBytes = 0; // Terminate loop
-            }
+            x0 = ScheduleAVX2x2(x0, x1, x4, x5, x7); StoreWKx2(wk, x0, K.data(), i + 0);
+            x1 = ScheduleAVX2x2(x1, x2, x5, x6, x0); StoreWKx2(wk, x1, K.data(), i + 1);
+            x2 = ScheduleAVX2x2(x2, x3, x6, x7, x1); StoreWKx2(wk, x2, K.data(), i + 2);
+            x3 = ScheduleAVX2x2(x3, x4, x7, x0, x2); StoreWKx2(wk, x3, K.data(), i + 3);
+            x4 = ScheduleAVX2x2(x4, x5, x0, x1, x3); StoreWKx2(wk, x4, K.data(), i + 4);
+            x5 = ScheduleAVX2x2(x5, x6, x1, x2, x4); StoreWKx2(wk, x5, K.data(), i + 5);
+            x6 = ScheduleAVX2x2(x6, x7, x2, x3, x5); StoreWKx2(wk, x6, K.data(), i + 6);
+            x7 = ScheduleAVX2x2(x7, x0, x3, x4, x6); StoreWKx2(wk, x7, K.data(), i + 7);
         }
+        
+        CompressBlock(state, wk[0]);
+        CompressBlock(state, wk[1]);
+        
+        data += 2 * SHA512_BLOCK_LENGTH;
+        numOfBlocks -= 2;
     }
+    
+    // Odd block, four words per register
+    if(numOfBlocks == 1)
+    {
+        __m256i x[4];
+        for(uint32_t i = 0; i < 4; i++)
+        {
+            x[i] = _mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + 32 * i)), MASK); // Convert to big endian
+            _mm256_store_si256(reinterpret_cast<__m256i*>(&wk[0][4 * i]), _mm256_add_epi64(x[i], _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&K[4 * i]))));
+        }
+        
+        for(uint32_t i = 4; i < 20; i++)
+        {
+            const __m256i w = ScheduleAVX2(x[0], x[1], x[2], x[3]);
+            x[0] = x[1];
+            x[1] = x[2];
+            x[2] = x[3];
+            x[3] = w;
+            
+            _mm256_store_si256(reinterpret_cast<__m256i*>(&wk[0][4 * i]), _mm256_add_epi64(w, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&K[4 * i]))));
+        }
+        
+        CompressBlock(state, wk[0]);
+    }
+    
+    std::copy(state, state + 8, stateOut);
+    
+    // Cleanup sensitive data for security
+#ifdef HM_CLEANUP_TMP_MEMORY_AFTER_HASHING_FOR_SECURITY
+    std::memset(wk, 0, sizeof(wk));
+#endif
+}
+#endif
+
+void Hasher<SHA512, HARDWARE>::Update(const uint8_t* const data, const uint64_t size)
+{
+    Absorb(*m_Context, m_TransformFunction, data, size);
 }
 
 void Hasher<SHA512, HARDWARE>::Update(const std::vector<uint8_t>& data)
@@ -493,52 +635,18 @@ void Hasher<SHA512, HARDWARE>::Update(const std::string& str)
 
 std::vector<uint8_t> Hasher<SHA512, HARDWARE>::End()
 {
-#ifndef NDEBUG
-    if(m_Context->bufferSize == SHA512_BLOCK_LENGTH) // Check for bug
-        throw std::runtime_error("Buffer should never be completely filled and untransformed when entering the End() function.");
-#endif
-    
-    // Pad last block
-    if(m_Context->bufferSize < SHA512_BLOCK_LENGTH - 8)
-    {
-        std::memset(m_Context->buffer + m_Context->bufferSize, 0x00, SHA512_BLOCK_LENGTH - 8 - m_Context->bufferSize);
-        m_Context->buffer[m_Context->bufferSize] = 0x80;
-    }
-    else
-    {
-        std::memset(m_Context->buffer + m_Context->bufferSize, 0x00, SHA512_BLOCK_LENGTH - m_Context->bufferSize);
-        m_Context->buffer[m_Context->bufferSize] = 0x80;
-        
-        Transform(m_Context->buffer);
-        
-        std::memset(m_Context->buffer, 0x00, SHA512_BLOCK_LENGTH - 8);
-    }
-    
-    // Append full message length to padding block
-    m_Context->buffer[SHA512_BLOCK_LENGTH - 1] = static_cast<uint8_t>(m_Context->numOfBits);
-    m_Context->buffer[SHA512_BLOCK_LENGTH - 2] = static_cast<uint8_t>(m_Context->numOfBits >> 8);
-    m_Context->buffer[SHA512_BLOCK_LENGTH - 3] = static_cast<uint8_t>(m_Context->numOfBits >> 16);
-    m_Context->buffer[SHA512_BLOCK_LENGTH - 4] = static_cast<uint8_t>(m_Context->numOfBits >> 24);
-    m_Context->buffer[SHA512_BLOCK_LENGTH - 5] = static_cast<uint8_t>(m_Context->numOfBits >> 32);
-    m_Context->buffer[SHA512_BLOCK_LENGTH - 6] = static_cast<uint8_t>(m_Context->numOfBits >> 40);
-    m_Context->buffer[SHA512_BLOCK_LENGTH - 7] = static_cast<uint8_t>(m_Context->numOfBits >> 48);
-    m_Context->buffer[SHA512_BLOCK_LENGTH - 8] = static_cast<uint8_t>(m_Context->numOfBits >> 56);
-    
-    // Transform
-    Transform(m_Context->buffer);
-    
-    // Assemble hash
     std::vector<uint8_t> hash(64); // 512 bit hash
-    for(uint32_t i = 0; i < 8; i++)
-    {
-#ifdef HM_LITTLE_ENDIAN
-        Utils::U64toU8<Utils::REVERSE_ENDIANNESS>(m_Context->state[i], &hash[i << 3]); // Transform SHA big endian to host little endian
-#else
-        Utils::U64toU8<Utils::KEEP_ENDIANNESS>(m_Context->state[i], &hash[i << 3]);
-#endif
-    }
+    Finalize(*m_Context, m_TransformFunction, hash.data(), 64);
     
     return hash;
 }
 
+void Hasher<SHA512, HARDWARE>::HashShort(const uint8_t* const data, const uint64_t size, uint8_t* const digest)
+{
+    // There is no hasher object to store the kernel in, select it once
+    static const TransformFunction transform = SelectTransformFunction();
+    
+    HashSingleBlock(transform, INITIAL_HASH_VALUES, data, size, digest, 64);
+}
+
 #endif /* HM_SIMD_ARM || HM_SIMD_X86 */
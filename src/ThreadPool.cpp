@@ -0,0 +1,151 @@
+/*
+    The zlib License
+
+    Copyright (C) 2024 Marc Schöndorf
+ 
+This software is provided 'as-is', without any express or implied warranty. In
+no event will the authors be held liable for any damages arising from the use of
+this software.
+
+Permission is granted to anyone to use this software for any purpose, including
+commercial applications, and to alter it and redistribute it freely, subject to
+the following restrictions:
+
+1.  The origin of this software must not be misrepresented; you must not claim
+    that you wrote the original software. If you use this software in a product,
+    an acknowledgment in the product documentation would be appreciated but is
+    not required.
+
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+
+3.  This notice may not be removed or altered from any source distribution.
+*/
+
+
+/*------------------------------------------------------------------*/
+/*                                                                  */
+/*                      (C) 2024 Marc Schöndorf                     */
+/*                            See license                           */
+/*                                                                  */
+/*  ThreadPool.cpp                                                  */
+/*  Created: 16.10.2026                                             */
+/*------------------------------------------------------------------*/
+
+#include "HashMe.hpp"
+
+using namespace HashMe;
+
+ThreadPool::ThreadPool(const uint32_t numOfThreads)
+{
+    uint32_t threads = numOfThreads;
+    if(threads == 0)
+        threads = std::max(std::thread::hardware_concurrency(), 1u);
+    
+    m_Threads.reserve(threads);
+    for(uint32_t i = 0; i < threads; i++)
+        m_Threads.emplace_back(&ThreadPool::WorkerLoop, this);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Stop = true;
+    }
+    
+    m_TaskAvailable.notify_all();
+    
+    for(std::thread& thread : m_Threads)
+        thread.join();
+}
+
+uint32_t ThreadPool::GetNumOfThreads() const
+{
+    return static_cast<uint32_t>(m_Threads.size());
+}
+
+void ThreadPool::WorkerLoop()
+{
+    while(true)
+    {
+        std::function<void()> task;
+        
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_TaskAvailable.wait(lock, [this]() { return m_Stop || !m_Tasks.empty(); });
+            
+            // Remaining tasks are still run before stopping
+            if(m_Tasks.empty())
+                return;
+            
+            task = std::move(m_Tasks.front());
+            m_Tasks.pop_front();
+        }
+        
+        task();
+    }
+}
+
+void ThreadPool::Submit(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Tasks.push_back(std::move(task));
+    }
+    
+    m_TaskAvailable.notify_one();
+}
+
+void ThreadPool::RunParallelForTasks(ParallelForState& state)
+{
+    uint64_t numOfCompletedTasks = 0;
+    
+    for(uint64_t task = state.nextTask++; task < state.numOfTasks; task = state.nextTask++)
+    {
+        try
+        {
+            (*state.function)(task);
+        }
+        catch(...)
+        {
+            std::lock_guard<std::mutex> lock(state.mutex);
+            if(!state.exception)
+                state.exception = std::current_exception();
+        }
+        
+        numOfCompletedTasks++;
+    }
+    
+    if(numOfCompletedTasks > 0)
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        state.numOfCompletedTasks += numOfCompletedTasks;
+        
+        if(state.numOfCompletedTasks == state.numOfTasks)
+            state.completed.notify_all();
+    }
+}
+
+void ThreadPool::ParallelFor(const uint64_t numOfTasks, const std::function<void(uint64_t)>& function)
+{
+    if(numOfTasks == 0)
+        return;
+    
+    // Workers may pick up their share after the last task is done, they keep the state alive
+    std::shared_ptr<ParallelForState> state = std::make_shared<ParallelForState>();
+    state->function = &function;
+    state->numOfTasks = numOfTasks;
+    
+    const uint64_t numOfHelpers = std::min<uint64_t>(m_Threads.size(), numOfTasks - 1);
+    for(uint64_t i = 0; i < numOfHelpers; i++)
+        Submit([state]() { RunParallelForTasks(*state); });
+    
+    RunParallelForTasks(*state);
+    
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->completed.wait(lock, [&state]() { return state->numOfCompletedTasks == state->numOfTasks; });
+    
+    if(state->exception)
+        std::rethrow_exception(state->exception);
+}
@@ -0,0 +1,369 @@
+/*
+    The zlib License
+
+    Copyright (C) 2024 Marc Schöndorf
+ 
+This software is provided 'as-is', without any express or implied warranty. In
+no event will the authors be held liable for any damages arising from the use of
+this software.
+
+Permission is granted to anyone to use this software for any purpose, including
+commercial applications, and to alter it and redistribute it freely, subject to
+the following restrictions:
+
+1.  The origin of this software must not be misrepresented; you must not claim
+    that you wrote the original software. If you use this software in a product,
+    an acknowledgment in the product documentation would be appreciated but is
+    not required.
+
+2.  Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+
+3.  This notice may not be removed or altered from any source distribution.
+*/
+
+
+/*------------------------------------------------------------------*/
+/*                                                                  */
+/*                      (C) 2024 Marc Schöndorf                     */
+/*                            See license                           */
+/*                                                                  */
+/*  TreeHasher.cpp                                                  */
+/*  Created: 16.10.2026                                             */
+/*------------------------------------------------------------------*/
+
+
+#include "HashMe.hpp"
+
+using namespace HashMe;
+
+// ***************************************************
+// Domain separation prefixes
+const BatchHasher<SHA256>::Midstate& TreeHasher<SHA256>::ChunkMidstate()
+{
+    static const BatchHasher<SHA256>::Midstate midstate = BatchHasher<SHA256>::PrefixMidstate(0x00);
+    return midstate;
+}
+
+const BatchHasher<SHA256>::Midstate& TreeHasher<SHA256>::NodeMidstate()
+{
+    static const BatchHasher<SHA256>::Midstate midstate = BatchHasher<SHA256>::PrefixMidstate(0x01);
+    return midstate;
+}
+
+TreeHasher<SHA256>::TreeHasher(ThreadPool& threadPool, const uint64_t chunkSize, const uint32_t fanout)
+    : m_ThreadPool(threadPool)
+    , m_ChunkSize(chunkSize)
+    , m_Fanout(fanout)
+    , m_MaxNumOfPendingChunks(2 * static_cast<uint64_t>(threadPool.GetNumOfThreads()))
+    , m_StreamState(std::make_shared<StreamState>())
+{
+    if(chunkSize == 0 || chunkSize % BLOCK_LENGTH != 0)
+        throw std::invalid_argument("Chunk size must be a multiple of 64 bytes.");
+    
+    if(fanout < 2)
+        throw std::invalid_argument("Fanout must be at least 2.");
+    
+    Initialize();
+}
+
+TreeHasher<SHA256>::~TreeHasher()
+{
+    // Queued tasks find the queue empty, chunks which are being hashed only write into the shared state
+    std::lock_guard<std::mutex> lock(m_StreamState->mutex);
+    m_StreamState->chunks.clear();
+}
+
+void TreeHasher<SHA256>::Initialize()
+{
+    m_Chunk.clear();
+    m_MessageLength = 0;
+    m_NumOfChunks = 0;
+    
+    std::lock_guard<std::mutex> lock(m_StreamState->mutex);
+    m_StreamState->chunkDigests.clear();
+    m_StreamState->exception = nullptr;
+}
+
+void TreeHasher<SHA256>::Reset()
+{
+    // The queued chunks are dropped, only the ones which are being hashed are waited for
+    {
+        std::lock_guard<std::mutex> lock(m_StreamState->mutex);
+        
+        m_StreamState->numOfPendingChunks -= m_StreamState->chunks.size();
+        m_StreamState->chunks.clear();
+    }
+    
+    WaitForPendingChunks();
+    Initialize();
+}
+
+uint64_t TreeHasher<SHA256>::GetChunkSize() const
+{
+    return m_ChunkSize;
+}
+
+uint32_t TreeHasher<SHA256>::GetFanout() const
+{
+    return m_Fanout;
+}
+
+bool TreeHasher<SHA256>::HashQueuedChunk(StreamState& state)
+{
+    uint64_t chunkIndex;
+    std::vector<uint8_t> chunk;
+    
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        
+        if(state.chunks.empty())
+            return false;
+        
+        chunkIndex = state.chunks.front().first;
+        chunk = std::move(state.chunks.front().second);
+        state.chunks.pop_front();
+    }
+    
+    uint8_t digest[DIGEST_LENGTH];
+    std::exception_ptr exception;
+    
+    try
+    {
+        state.batchHasher.Hash(ChunkMidstate(), std::span<const uint8_t>(chunk), digest);
+    }
+    catch(...)
+    {
+        exception = std::current_exception();
+    }
+    
+    std::lock_guard<std::mutex> lock(state.mutex);
+    
+    std::copy(digest, digest + DIGEST_LENGTH, state.chunkDigests.begin() + static_cast<std::ptrdiff_t>(chunkIndex * DIGEST_LENGTH));
+    state.freeChunks.push_back(std::move(chunk));
+    
+    if(exception && !state.exception)
+        state.exception = exception;
+    
+    state.numOfPendingChunks--;
+    state.chunkDone.notify_all();
+    
+    return true;
+}
+
+void TreeHasher<SHA256>::HashQueuedChunks(const uint64_t maxNumOfPendingChunks)
+{
+    while(true)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_StreamState->mutex);
+            
+            if(m_StreamState->numOfPendingChunks <= maxNumOfPendingChunks)
+                return;
+        }
+        
+        if(!HashQueuedChunk(*m_StreamState))
+            return;
+    }
+}
+
+void TreeHasher<SHA256>::WaitForPendingChunks()
+{
+    // Only the chunks which are already being hashed by a worker are waited for, they finish without further help
+    HashQueuedChunks(0);
+    
+    std::unique_lock<std::mutex> lock(m_StreamState->mutex);
+    m_StreamState->chunkDone.wait(lock, [this]() { return m_StreamState->numOfPendingChunks == 0; });
+}
+
+void TreeHasher<SHA256>::DispatchChunk()
+{
+    const uint64_t chunkIndex = m_NumOfChunks++;
+    
+    {
+        std::lock_guard<std::mutex> lock(m_StreamState->mutex);
+        
+        m_StreamState->chunkDigests.resize(m_NumOfChunks * DIGEST_LENGTH);
+        m_StreamState->chunks.emplace_back(chunkIndex, std::move(m_Chunk));
+        m_StreamState->numOfPendingChunks++;
+        
+        // Reuse the buffer of an already hashed chunk
+        m_Chunk.clear();
+        if(!m_StreamState->freeChunks.empty())
+        {
+            m_Chunk = std::move(m_StreamState->freeChunks.back());
+            m_StreamState->freeChunks.pop_back();
+        }
+    }
+    
+    m_Chunk.clear();
+    m_Chunk.reserve(m_ChunkSize);
+    
+    // Every task hashes the oldest queued chunk, which may be a different one or none if the caller was faster
+    m_ThreadPool.Submit([state = m_StreamState]()
+    {
+        HashQueuedChunk(*state);
+    });
+    
+    // Limits the memory held by chunks which are not hashed yet. Waiting for a worker instead could block forever if
+    // Update() runs in a task of the same pool and all workers are busy
+    HashQueuedChunks(m_MaxNumOfPendingChunks);
+}
+
+void TreeHasher<SHA256>::Update(const uint8_t* const data, const uint64_t size)
+{
+    if(!data)
+        throw std::invalid_argument("Data cannot be nullptr.");
+    
+    if(size == 0)
+        throw std::invalid_argument("Data size cannot be zero.");
+    
+    uint64_t dataIndex = 0;
+    while(dataIndex < size)
+    {
+        // A full chunk is only dispatched when more data arrives, End() hashes the last chunk itself
+        if(m_Chunk.size() == m_ChunkSize)
+            DispatchChunk();
+        
+        const uint64_t numOfBytes = std::min(m_ChunkSize - m_Chunk.size(), size - dataIndex);
+        m_Chunk.insert(m_Chunk.end(), data + dataIndex, data + dataIndex + numOfBytes);
+        
+        dataIndex += numOfBytes;
+    }
+    
+    m_MessageLength += size;
+}
+
+void TreeHasher<SHA256>::Update(const std::vector<uint8_t>& data)
+{
+    Update(data.data(), data.size());
+}
+
+void TreeHasher<SHA256>::Update(const std::string& str)
+{
+    Update(reinterpret_cast<const uint8_t*>(str.data()), str.size());
+}
+
+std::vector<uint8_t> TreeHasher<SHA256>::End()
+{
+    uint8_t lastChunkDigest[DIGEST_LENGTH];
+    m_BatchHasher.Hash(ChunkMidstate(), std::span<const uint8_t>(m_Chunk), lastChunkDigest);
+    
+    WaitForPendingChunks();
+    
+    std::vector<uint8_t> digests;
+    {
+        std::lock_guard<std::mutex> lock(m_StreamState->mutex);
+        
+        if(m_StreamState->exception)
+        {
+            const std::exception_ptr exception = m_StreamState->exception;
+            m_StreamState->exception = nullptr;
+            
+            std::rethrow_exception(exception);
+        }
+        
+        digests = std::move(m_StreamState->chunkDigests);
+    }
+    
+    digests.insert(digests.end(), lastChunkDigest, lastChunkDigest + DIGEST_LENGTH);
+    
+    std::vector<uint8_t> root(DIGEST_LENGTH);
+    Finalize(digests, m_MessageLength, root.data());
+    
+    Initialize();
+    
+    return root;
+}
+
+std::vector<uint8_t> TreeHasher<SHA256>::Hash(const uint8_t* const data, const uint64_t size) const
+{
+    if(!data && size > 0)
+        throw std::invalid_argument("Data cannot be nullptr.");
+    
+    const uint64_t numOfChunks = std::max<uint64_t>((size + m_ChunkSize - 1) / m_ChunkSize, 1);
+    
+    // A task hashes as many chunks as the batch hasher has lanes, as long as every thread still gets a few tasks
+    const uint64_t numOfThreads = m_ThreadPool.GetNumOfThreads() + 1;
+    const uint64_t numOfChunksPerTask = std::clamp<uint64_t>(numOfChunks / (4 * numOfThreads), 1, m_BatchHasher.GetNumOfLanes());
+    const uint64_t numOfTasks = (numOfChunks + numOfChunksPerTask - 1) / numOfChunksPerTask;
+    
+    std::vector<uint8_t> digests(numOfChunks * DIGEST_LENGTH);
+    m_ThreadPool.ParallelFor(numOfTasks, [this, data, size, numOfChunks, numOfChunksPerTask, &digests](const uint64_t task)
+    {
+        const uint64_t firstChunk = task * numOfChunksPerTask;
+        const uint64_t lastChunk = std::min(firstChunk + numOfChunksPerTask, numOfChunks);
+        
+        std::vector<std::span<const uint8_t>> chunks;
+        chunks.reserve(lastChunk - firstChunk);
+        
+        for(uint64_t i = firstChunk; i < lastChunk; i++)
+        {
+            const uint64_t offset = i * m_ChunkSize;
+            chunks.emplace_back(data + offset, std::min(m_ChunkSize, size - offset));
+        }
+        
+        m_BatchHasher.Hash(ChunkMidstate(), chunks, digests.data() + firstChunk * DIGEST_LENGTH);
+    });
+    
+    std::vector<uint8_t> root(DIGEST_LENGTH);
+    Finalize(digests, size, root.data());
+    
+    return root;
+}
+
+std::vector<uint8_t> TreeHasher<SHA256>::Hash(const std::vector<uint8_t>& data) const
+{
+    return Hash(data.data(), data.size());
+}
+
+void TreeHasher<SHA256>::Finalize(std::vector<uint8_t>& digests, const uint64_t messageLength, uint8_t* const root) const
+{
+    const uint64_t nodeLength = static_cast<uint64_t>(m_Fanout) * DIGEST_LENGTH;
+    
+    // Every node hashes up to fanout digests of the level below, the last one may have fewer children
+    while(digests.size() > DIGEST_LENGTH)
+    {
+        const uint64_t numOfChildren = digests.size() / DIGEST_LENGTH;
+        const uint64_t numOfNodes = (numOfChildren + m_Fanout - 1) / m_Fanout;
+        
+        std::vector<uint8_t> nodes(numOfNodes * DIGEST_LENGTH);
+        const uint64_t numOfTasks = (numOfNodes + NUM_OF_NODES_PER_TASK - 1) / NUM_OF_NODES_PER_TASK;
+        
+        m_ThreadPool.ParallelFor(numOfTasks, [this, &digests, &nodes, numOfNodes, nodeLength](const uint64_t task)
+        {
+            const uint64_t first = task * NUM_OF_NODES_PER_TASK;
+            const uint64_t last = std::min(first + NUM_OF_NODES_PER_TASK, numOfNodes);
+            
+            std::vector<std::span<const uint8_t>> messages;
+            messages.reserve(last - first);
+            
+            for(uint64_t i = first; i < last; i++)
+            {
+                const uint64_t offset = i * nodeLength;
+                messages.emplace_back(digests.data() + offset, std::min<uint64_t>(nodeLength, digests.size() - offset));
+            }
+            
+            m_BatchHasher.Hash(NodeMidstate(), messages, nodes.data() + first * DIGEST_LENGTH);
+        });
+        
+        digests = std::move(nodes);
+    }
+    
+    // Bind the parameters of the tree to the root
+    uint8_t rootMessage[1 + 8 + 8 + 4 + DIGEST_LENGTH];
+    rootMessage[0] = 0x02;
+    
+    for(uint32_t i = 0; i < 8; i++)
+    {
+        rootMessage[1 + i] = static_cast<uint8_t>(messageLength >> ((7 - i) * 8));
+        rootMessage[9 + i] = static_cast<uint8_t>(m_ChunkSize >> ((7 - i) * 8));
+    }
+    
+    for(uint32_t i = 0; i < 4; i++)
+        rootMessage[17 + i] = static_cast<uint8_t>(m_Fanout >> ((3 - i) * 8));
+    
+    std::copy(digests.begin(), digests.end(), rootMessage + 21);
+    
+    Hasher<SHA256, SOFTWARE>::HashShort(rootMessage, sizeof(rootMessage), root);
+}